@@ -24,6 +24,12 @@
  * |----------------------------------------------------------------------
  */
 #include "gui.h"
+#include "gui_surface.h"
+#include "gui_scroll.h"
+#include "gui_anim.h"
+#include "gui_gesture.h"
+#include "gui_prof.h"
+#include "gui_trace.h"
 
 /******************************************************************************/
 /******************************************************************************/
@@ -51,22 +57,80 @@ GUI_t GUI;
 /***                            Private functions                            **/
 /******************************************************************************/
 /******************************************************************************/
-//Gets number of widgets waiting for redraw
-uint32_t __GetNumberOfPendingWidgets(GUI_HANDLE_t parent) {
-    GUI_HANDLE_t h;
-    uint32_t cnt = 0;
+uint32_t __RedrawWidgets(GUI_HANDLE_t parent);
+
+//Calls drawing function of widget
+static void __DrawWidget(GUI_HANDLE_t h) {
+    GUI_TRACE_BEGIN(GUI_TRACE_CAT_WIDGET, h->Widget->MetaData.Name, h->Id);
+    __GUI_PROF_WIDGET_DRAW(h, h->Widget->WidgetDraw(&GUI.Display, h));
+    GUI_TRACE_END(GUI_TRACE_CAT_WIDGET, h->Widget->MetaData.Name);
+}
+
+//Draws single widget, with children if widget has them
+static uint32_t __RedrawWidget(GUI_HANDLE_t h) {
+    if (GUI_Store.Flags[h->Index] & GUI_STORE_FLAG_CHILDREN) {  /* If this widget has children elements */
+        return __RedrawWidgets(h);                  /* Redraw this widget and all its children if required */
+    }
+    if (__GUI_WIDGET_IsRedraw(h)) {                 /* Check if redraw required */
+        __GUI_WIDGET_ClearRedraw(h);                /* Clear flag */
+        if (h->Widget && h->Widget->WidgetDraw && __GUI_WIDGET_IsInsideClippingRegion(h) && !__GUI_WIDGET_IsOccluded(h, 0)) { /* If draw function is set, drawing is inside clipping region and widget is not hidden */
+            __DrawWidget(h);                        /* Redraw widget */
+        }
+        return 1;
+    }
+    return 0;
+}
+
+//Clears redraw flag on widget and all its children
+static void __ClearRedrawFlags(GUI_HANDLE_t h) {
+    GUI_HANDLE_t c;
+    
+    __GUI_WIDGET_ClearRedraw(h);
+    __GUI_STORE_ClearSubtreeDirty(h);
+    if (h->Widget->MetaData.AllowChildren) {
+        for (c = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)h, 0); c; c = __GUI_LINKEDLIST_GetNextWidget(NULL, c)) {
+            __ClearRedrawFlags(c);
+        }
+    }
+}
+
+//Draws widget with enabled cache through its surface
+static uint32_t __RedrawCachedWidget(GUI_HANDLE_t h) {
+    GUI_SURFACE_t* s;
+    GUI_Dim_t x, y;
+    uint32_t cnt = 0, pending = 0, redraw;
     
-    if (parent && parent->Flags & GUI_FLAG_REDRAW) {    /* Check for specific widget */
-        return 1;                                   /* We have object to redraw */
+    redraw = __GUI_WIDGET_IsRedraw(h);              /* Widget area on layer must be drawn again */
+    if (h->Widget->MetaData.AllowChildren) {
+        pending = __GUI_STORE_IsSubtreeDirty(h);    /* Check children only, they change surface content */
+    }
+    if (!redraw && !pending) {                      /* Nothing to do */
+        return 0;
     }
-    for (h = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)parent, 0); h; h = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)parent, h)) {
-        if (h->Widget->MetaData.AllowChildren) {    /* If this widget has children elements */
-            cnt += __GetNumberOfPendingWidgets(h);  /* Redraw this widget and all its children if required */
-        } else if (h->Flags & GUI_FLAG_REDRAW) {    /* Check if we need redraw */
-            cnt++;                                  /* Increase number of elements to redraw */
+    if (__GUI_WIDGET_IsOccluded(h, 0)) {            /* Widget is hidden, skip drawing to surface too */
+        if (pending) {
+            __GUI_SURFACE_Invalidate(h);            /* Content changed, draw it when visible again */
         }
+        __ClearRedrawFlags(h);
+        return 0;
     }
-    return cnt;
+    
+    s = __GUI_SURFACE_Get(h);                       /* Get surface with memory */
+    if (!s) {                                       /* No memory for surface */
+        return __RedrawWidget(h);                   /* Draw directly to layer */
+    }
+    
+    x = __GUI_WIDGET_GetAbsoluteX(h);
+    y = __GUI_WIDGET_GetAbsoluteY(h);
+    if (!s->Valid || pending) {                     /* Surface must be updated first */
+        __GUI_STORE_SetChildDirty(h);               /* Draw widget with all children inside clipping region, no old pixels are reused */
+        __GUI_SURFACE_Begin(s, x, y);               /* Redirect drawings to surface */
+        cnt = __RedrawWidget(h);
+        __GUI_SURFACE_End(s);                       /* Restore drawing layer */
+    }
+    __GUI_WIDGET_ClearRedraw(h);                    /* Clear flag */
+    __GUI_SURFACE_Blit(s, x, y);                    /* Copy surface to layer */
+    return cnt ? cnt : 1;
 }
 
 //Draws widgets
@@ -74,28 +138,28 @@ uint32_t __RedrawWidgets(GUI_HANDLE_t parent) {
     GUI_HANDLE_t h;
     uint32_t cnt = 0;
     
-    if (parent && (parent->Flags & GUI_FLAG_REDRAW)) {  /* Check if parent window should redraw operation */
-        parent->Flags &= ~GUI_FLAG_REDRAW;          /* Clear flag */
+    if (parent) {
+        __GUI_STORE_ClearSubtreeDirty(parent);      /* Children are checked below, invalidations from now on mark it again */
+    }
+    if (parent && __GUI_WIDGET_IsRedraw(parent)) {  /* Check if parent window should redraw operation */
+        __GUI_WIDGET_ClearRedraw(parent);           /* Clear flag */
         for (h = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)parent, 0); h; h = __GUI_LINKEDLIST_GetNextWidget(NULL, h)) {
-            h->Flags |= GUI_FLAG_REDRAW;            /* Set redraw bit to all children elements */
+            __GUI_STORE_SetChildDirty(h);           /* Set redraw bit to all children elements */
         }
-        if (parent->Widget->WidgetDraw && __GUI_WIDGET_IsInsideClippingRegion(parent)) {    /* If draw function is set and drawing is inside clipping region */
-            parent->Widget->WidgetDraw(&GUI.Display, parent);   /* Call drawing function */
+        if (parent->Widget->WidgetDraw && __GUI_WIDGET_IsInsideClippingRegion(parent) && !__GUI_WIDGET_IsOccluded(parent, 1)) {  /* If draw function is set, drawing is inside clipping region and background is not hidden by children or other widgets */
+            __DrawWidget(parent);                   /* Call drawing function */
         }
     }
 
     /* Go through all elements of parent */
     for (h = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)parent, 0); h; h = __GUI_LINKEDLIST_GetNextWidget(NULL, h)) {
-        if (h->Widget->MetaData.AllowChildren) {    /* If this widget has children elements */
-            cnt += __RedrawWidgets(h);              /* Redraw this widget and all its children if required */
+        if (!__GUI_WIDGET_IsRedraw(h) && !__GUI_STORE_IsSubtreeDirty(h)) {  /* Nothing changed in this part of tree */
+            continue;
+        }
+        if (GUI_Store.Flags[h->Index] & GUI_STORE_FLAG_CACHE) { /* Widget is drawn through surface */
+            cnt += __RedrawCachedWidget(h);
         } else {
-            if (h->Flags & GUI_FLAG_REDRAW) {       /* Check if redraw required */
-                h->Flags &= ~GUI_FLAG_REDRAW;       /* Clear flag */
-                if (h->Widget && h->Widget->WidgetDraw && __GUI_WIDGET_IsInsideClippingRegion(h)) { /* If draw function is set and drawing is inside clipping region */
-                    h->Widget->WidgetDraw(&GUI.Display, h); /* Redraw widget */
-                }
-                cnt++;
-            }
+            cnt += __RedrawWidget(h);               /* Redraw widget and its children if required */
         }
     }
     
@@ -122,7 +186,7 @@ __GUI_TouchStatus_t __ProcessTouch(GUI_TouchData_t* touch, GUI_TouchData_t* touc
         y = __GUI_WIDGET_GetAbsoluteY(h);           /* Get actual widget Y position */
         
         /* Check if widget is in drawing area */
-        if (touch->X >= x && touch->X <= (x + h->Width) && touch->Y >= y && touch->Y <= (y + h->Height)) {
+        if (touch->X[0] >= x && touch->X[0] <= (x + h->Width) && touch->Y[0] >= y && touch->Y[0] <= (y + h->Height)) {
             if (touch->Status && !touchLast->Status) {    /* Check for touchdown event */
                 if (h->Widget->TouchEvents.TouchDown) {
                     tStat = h->Widget->TouchEvents.TouchDown(h, touch, touchCONTINUE);  /* Check for touch */
@@ -168,6 +232,19 @@ __GUI_TouchStatus_t __ProcessTouch(GUI_TouchData_t* touch, GUI_TouchData_t* touc
     return touchCONTINUE;                           /* Try with another widget */
 }
 
+//Sends move event to active widget, returns 1 if touch position was predicted
+static uint8_t __ProcessMove(GUI_TouchData_t* touch, uint8_t predict) {
+    GUI_TouchData_t t;
+    uint8_t predicted = 0;
+    
+    memcpy((void *)&t, (void *)touch, sizeof(GUI_TouchData_t));
+    predicted = __GUI_INPUT_PrepareMove(&t, predict);   /* Move ahead of finger to hide latency */
+    if (GUI.ActiveWidget && GUI.ActiveWidget->Widget && GUI.ActiveWidget->Widget->TouchEvents.TouchMove) {
+        GUI.ActiveWidget->Widget->TouchEvents.TouchMove(GUI.ActiveWidget, &t, touchCONTINUE);
+    }
+    return predicted;
+}
+
 /******************************************************************************/
 /******************************************************************************/
 /***                              Protothreads                               **/
@@ -193,11 +270,11 @@ GUI_Result_t GUI_Init(void) {
     if (GUI.LCD.LayersCount == 1) {
         GUI.LCD.ActiveLayer = 0;
         GUI.LCD.DrawingLayer = 0;
-        GUI.LL.Fill(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0xFFFFFFFF);
+        GUI.LL.Fill(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)(uintptr_t)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0xFFFFFFFF);
     } else if (GUI.LCD.LayersCount > 1) {
         GUI.LCD.ActiveLayer = 0;
         GUI.LCD.DrawingLayer = 0;
-        GUI.LL.Fill(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0xFFFFFFFF);
+        GUI.LL.Fill(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)(uintptr_t)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0xFFFFFFFF);
         GUI.LCD.DrawingLayer = 1;
     } else {
         return guiERROR;
@@ -205,18 +282,32 @@ GUI_Result_t GUI_Init(void) {
     
     /* Init input devices */
     __GUI_INPUT_Init();
+    __GUI_GESTURE_Init();
     
     /* Init widgets */
+    __GUI_STORE_Init();
     __GUI_WIDGET_Init();
     
+    /* Init animations */
+    __GUI_ANIM_Init();
+    
+    /* Start profiler and trace after display is cleared */
+    __GUI_PROF_INIT();
+    __GUI_TRACE_INIT();
+    
     return guiOK;
 }
 
 int32_t GUI_Process(void) {
     static uint8_t first = 1;
     static GUI_TouchData_t touchLast;
+    static uint8_t predicted = 0;
     int32_t cnt = 0;
-    GUI_TouchData_t touch;
+    GUI_TouchData_t touch, move;
+    uint8_t moving = 0;
+    __GUI_TRACE_PROCESS_BEGIN();
+    
+    __GUI_PROF_PROCESS_BEGIN();
      
     if (first) {                                    /* Process first call */
         first = 0;
@@ -225,13 +316,25 @@ int32_t GUI_Process(void) {
     }
     
     while (__GUI_INPUT_ReadTouch(&touch)) {         /* Process all touch events possible */
+        __GUI_GESTURE_Add(&touch);                  /* Check for gestures */
+        __GUI_PROF_TOUCH();
+        
         /* If there is already an active touch */
         if (GUI.ActiveWidget && touch.Status && touchLast.Status) {
-            /* Try to process mouse move event on this widget */
-            if (GUI.ActiveWidget->Widget && GUI.ActiveWidget->Widget->TouchEvents.TouchMove) {
-                GUI.ActiveWidget->Widget->TouchEvents.TouchMove(GUI.ActiveWidget, &touch, touchCONTINUE);
-            }
+            /* Keep move event, only last one in this call is sent to widget */
+            memcpy((void *)&move, (void *)&touch, sizeof(GUI_TouchData_t));
+            moving = 1;
         } else {
+            if (GUI.ActiveWidget && !touch.Status) {    /* Widget gets real position before release */
+                if (moving || predicted) {
+                    __ProcessMove(moving ? &move : &touchLast, 0);
+                }
+                moving = predicted = 0;
+            } else if (moving) {                    /* Finish move before new touch */
+                predicted = __ProcessMove(&move, 0);
+                moving = 0;
+            }
+            
             /* Process other touches */
             if (__ProcessTouch(&touch, &touchLast, NULL) == touchHANDLED) {
                 
@@ -248,21 +351,40 @@ int32_t GUI_Process(void) {
         }
         memcpy((void *)&touchLast, (void *)&touch, sizeof(GUI_TouchData_t));/* Copy current touch to last touch status */
     }
-
+    if (moving) {                                   /* Send last move of this call */
+        predicted = __ProcessMove(&move, 1);
+    }
+    __GUI_GESTURE_Process();                        /* Check for time based gestures */
+    
+    if (!(GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM)) {   /* New frame can be drawn */
+        __GUI_SCROLL_Process();                     /* Move scroll views by one frame */
+        __GUI_ANIM_Process();                       /* Update animations for current time */
+    }
     
     /* Check if anything new to redraw */
-    if (!(GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) && __GetNumberOfPendingWidgets(NULL)) {  /* Check if anything to draw first */
+    if (!(GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) && __GUI_STORE_IsPending()) {  /* Check if anything to draw first */
+#if GUI_LOG_LEVEL >= GUI_LOG_LEVEL_DEBUG
         uint32_t time;
+#endif
         GUI_Byte active = GUI.LCD.ActiveLayer;
         GUI_Byte drawing = GUI.LCD.DrawingLayer;
         
+        __GUI_PROF_DRAW_BEGIN();
+        
         /* Copy current status from one layer to another */
-        GUI.LL.Copy(&GUI.LCD, drawing, (void *)GUI.LCD.Layers[active].StartAddress, (void *)GUI.LCD.Layers[drawing].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0);
+        GUI.LL.Copy(&GUI.LCD, drawing, (void *)(uintptr_t)GUI.LCD.Layers[active].StartAddress, (void *)(uintptr_t)GUI.LCD.Layers[drawing].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0);
             
         /* Actually draw new screen based on setup */
+#if GUI_LOG_LEVEL >= GUI_LOG_LEVEL_DEBUG
         time = TM_GENERAL_DWTCounterGetValue();
+#endif
+        GUI_TRACE_BEGIN(GUI_TRACE_CAT_GUI, "__RedrawWidgets", 0);
         cnt = __RedrawWidgets(NULL);                /* Redraw all widgets now */
-        __GUI_DEBUG("Time: %u\r\n", TM_GENERAL_DWTCounterGetValue() - time);
+        GUI_TRACE_END(GUI_TRACE_CAT_GUI, "__RedrawWidgets");
+        __GUI_PROF_DRAW_END();
+#if GUI_LOG_LEVEL >= GUI_LOG_LEVEL_DEBUG
+        GUI_LOG_RATE(GUI_LOG_LEVEL_DEBUG, 1000, "Time: %u\r\n", TM_GENERAL_DWTCounterGetValue() - time);
+#endif
         
 //        GUI_DRAW_Rectangle(&GUI.Display, GUI.Display.X1, GUI.Display.Y1, GUI.Display.X2 - GUI.Display.X1, GUI.Display.Y2 - GUI.Display.Y1, GUI_COLOR_CYAN);
         
@@ -278,6 +400,7 @@ int32_t GUI_Process(void) {
         /* Notify low-level about layer change */
         GUI.LCD.Flags |= GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;
         GUI_LL_Control(&GUI.LCD, GUI_LL_Command_SetActiveLayer, &drawing); /* Set new active layer to low-level driver */
+        GUI_TRACE_INSTANT(GUI_TRACE_CAT_LAYER, "LayerSwap", drawing);
         
         /* Swap active and drawing layers */
         /* New drawings won't be affected until confirmation from low-level is not received */
@@ -285,9 +408,17 @@ int32_t GUI_Process(void) {
         GUI.LCD.DrawingLayer = active;
     }
     
+    GUI_LOG_Process();                              /* Send buffered log messages in background */
+    __GUI_PROF_PROCESS_END();                       /* Store frame record if frame was drawn */
+    __GUI_TRACE_PROCESS_END();
+    
     return cnt;                                     /* Return number of elements updated on GUI */
 }
 
+void GUI_UpdateTime(uint32_t millis) {
+    GUI.Time += millis;                             /* Increase GUI time */
+}
+
 void GUI_LCD_ConfirmActiveLayer(GUI_Byte layer_num) {
     if ((GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM)) {/* If we have anything pending */
         GUI.LCD.Layers[layer_num].Pending = 0;
@@ -57,6 +57,7 @@ extern "C" {
 /* Include utilities */
 #include "utils/buffer.h"
 #include "utils/gui_linkedlist.h"
+#include "utils/gui_log.h"
 
 /* GUI Low-Level drivers */
 #include "gui_ll.h"
@@ -69,7 +70,7 @@ extern "C" {
 #define __GUI_ENTER()
 #define __GUI_LEAVE()
 
-#define __GUI_DEBUG(fmt, ...)       printf(fmt, ##__VA_ARGS__)
+#define __GUI_DEBUG(fmt, ...)       GUI_LOG_DEBUG(fmt, ##__VA_ARGS__)
 
 /**
  * \brief           GUI Handle object from main object
@@ -97,7 +98,7 @@ extern "C" {
 #define __GUI_MEMWIDALLOC(p, size)          do {    \
     (p) = (GUI_HANDLE_t)malloc(size);               \
     if ((p)) {                                      \
-        memset((p), 0x00, sizeof(size));            \
+        memset((p), 0x00, (size));                  \
     }                                               \
 } while (0)
 
@@ -114,7 +115,7 @@ extern "C" {
  */
 #define __GUI_ASSERTPARAMS(c)       do {            \
     if (!(c)) {                                     \
-        __GUI_DEBUG("Assert param failed in file %s and line %d\r\n", __FILE__, __LINE__);  \
+        GUI_LOG_ERROR("Assert param failed in file %s and line %d\r\n", __FILE__, __LINE__);  \
         return 0;                                   \
     }                                               \
 } while (0)
@@ -124,7 +125,7 @@ extern "C" {
  */
 #define __GUI_ASSERTPARAMSVOID(c)   do {            \
     if (!(c)) {                                     \
-        __GUI_DEBUG("Assert param failed in file %s and line %d\r\n", __FILE__, __LINE__);  \
+        GUI_LOG_ERROR("Assert param failed in file %s and line %d\r\n", __FILE__, __LINE__);  \
         return;                                     \
     }                                               \
 } while (0)
@@ -134,7 +135,7 @@ extern "C" {
  */
 #define __GUI_ASSERTACTIVEWIN()     do {            \
     if (!GUI.WindowActive) {                        \
-        __GUI_DEBUG("There is no active window for widget in file %s on line %d\r\n", __FILE__, __LINE__);  \
+        GUI_LOG_ERROR("There is no active window for widget in file %s on line %d\r\n", __FILE__, __LINE__);  \
         return NULL;                                \
     }                                               \
 } while (0)
@@ -219,6 +220,14 @@ GUI_Result_t GUI_Init(void);
  */
 int32_t GUI_Process(void);
 
+/**
+ * \brief           Increase GUI time used for animations
+ * \note            Function should be called periodically, for example from system tick interrupt
+ * \param[in]       millis: Number of milliseconds elapsed since last call
+ * \retval          None
+ */
+void GUI_UpdateTime(uint32_t millis);
+
 //Notify GUI from low-level that layer is in use
 void GUI_LCD_ConfirmActiveLayer(GUI_Byte layer_num);
  
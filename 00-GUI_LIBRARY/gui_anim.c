@@ -0,0 +1,307 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_anim.h"
+#include "gui_widget.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __ANIM_ONE                  0x10000UL       /* Progress of finished animation, 1.0 in Q16 format */
+
+/* Check if property is widget position or size */
+#define __ANIM_IS_GEOMETRY(prop)    ((prop) <= GUI_ANIM_PROP_HEIGHT)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_ANIM_t Anims[GUI_ANIM_MAX_COUNT];
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Apply easing curve to linear progress, input and output are in Q16 format */
+static uint32_t __Ease(GUI_ANIM_EASING_t easing, uint32_t p) {
+    uint32_t q;
+    
+    switch (easing) {
+        case GUI_ANIM_EASING_IN_QUAD:
+            return (uint32_t)(((uint64_t)p * p) >> 16);
+        case GUI_ANIM_EASING_OUT_QUAD:
+            q = __ANIM_ONE - p;
+            return __ANIM_ONE - (uint32_t)(((uint64_t)q * q) >> 16);
+        case GUI_ANIM_EASING_IN_OUT_QUAD:
+            if (p < __ANIM_ONE / 2) {
+                return (uint32_t)(((uint64_t)p * p) >> 15);
+            }
+            q = __ANIM_ONE - p;
+            return __ANIM_ONE - (uint32_t)(((uint64_t)q * q) >> 15);
+        case GUI_ANIM_EASING_IN_CUBIC:
+            return (uint32_t)(((((uint64_t)p * p) >> 16) * p) >> 16);
+        case GUI_ANIM_EASING_OUT_CUBIC:
+            q = __ANIM_ONE - p;
+            return __ANIM_ONE - (uint32_t)(((((uint64_t)q * q) >> 16) * q) >> 16);
+        case GUI_ANIM_EASING_IN_OUT_CUBIC:
+            if (p < __ANIM_ONE / 2) {
+                return (uint32_t)(((((uint64_t)p * p) >> 16) * p) >> 14);
+            }
+            q = __ANIM_ONE - p;
+            return __ANIM_ONE - (uint32_t)(((((uint64_t)q * q) >> 16) * q) >> 14);
+        default:
+            return p;
+    }
+}
+
+/* Get property value for given time, animation is marked as finished when end value is returned */
+static int32_t __Value(GUI_ANIM_t* a, uint32_t time) {
+    uint32_t t, e, out;
+    int64_t from, to;
+    uint8_t i;
+    
+    t = time - a->Start;
+    if (t >= a->Duration) {                         /* Finished, set exact end value */
+        a->Finished = 1;
+        return a->To;
+    }
+    e = __Ease(a->Easing, (uint32_t)(((uint64_t)t << 16) / a->Duration));
+    
+    if (a->Property == GUI_ANIM_PROP_COLOR) {       /* Each channel separately */
+        out = 0;
+        for (i = 0; i < 32; i += 8) {
+            from = ((uint32_t)a->From >> i) & 0xFF;
+            to = ((uint32_t)a->To >> i) & 0xFF;
+            out |= (uint32_t)(from + (((to - from) * e) >> 16)) << i;
+        }
+        return (int32_t)out;
+    }
+    from = a->From;
+    to = a->To;
+    return (int32_t)(from + (((to - from) * e) >> 16));
+}
+
+/* Set new position and size of widget with single redraw */
+static void __SetGeometry(GUI_HANDLE_t h, int32_t x, int32_t y, int32_t width, int32_t height) {
+    int32_t pW, pH;
+    
+    pW = GUI_WIDGET_GetParentWidth(h);              /* Widget must stay inside parent */
+    pH = GUI_WIDGET_GetParentHeight(h);
+    width = width < 0 ? 0 : (width > pW ? pW : width);
+    height = height < 0 ? 0 : (height > pH ? pH : height);
+    x = x < 0 ? 0 : (x > (pW - width) ? (pW - width) : x);
+    y = y < 0 ? 0 : (y > (pH - height) ? (pH - height) : y);
+    
+    if (h->X == x && h->Y == y && h->Width == width && h->Height == height) {
+        return;
+    }
+    __GUI_WIDGET_SetClippingRegion(h);              /* Old area must be drawn again */
+    h->X = x;
+    h->Y = y;
+    h->Width = width;
+    h->Height = height;
+    __GUI_STORE_UpdateRect(h);                      /* Move children too */
+    __GUI_WIDGET_InvalidateWithParent(h);           /* Draw new area */
+}
+
+/* Notify user and release animation, callback gets the same pointer as returned on start */
+static void __Stop(GUI_ANIM_t* a, uint8_t finished) {
+    if (a->Stopping) {                              /* Cancelled again from its own callback */
+        return;
+    }
+    a->Stopping = 1;                                /* Entry stays used, new animation from callback takes another one */
+    if (a->Callback) {
+        a->Callback(a, finished);
+    }
+    a->Widget = 0;                                  /* Entry is free */
+    a->Stopping = 0;
+}
+
+/* Start new animation, running animation of the same property is cancelled */
+static GUI_ANIM_t* __Start(GUI_HANDLE_t h, GUI_ANIM_PROP_t prop, GUI_ANIM_Set_t set, int32_t from, int32_t to, uint32_t duration, GUI_ANIM_EASING_t easing) {
+    GUI_ANIM_t* a = 0;
+    uint8_t i;
+    
+    for (i = 0; i < GUI_ANIM_MAX_COUNT; i++) {
+        if (Anims[i].Widget == h && Anims[i].Property == prop) {
+            __Stop(&Anims[i], 0);                   /* Replace old animation */
+        }
+    }
+    for (i = 0; i < GUI_ANIM_MAX_COUNT; i++) {
+        if (!Anims[i].Widget) {
+            a = &Anims[i];
+            break;
+        }
+    }
+    if (a) {
+        memset((void *)a, 0x00, sizeof(GUI_ANIM_t));
+        a->Widget = h;
+        a->Property = prop;
+        a->Easing = easing;
+        a->From = from;
+        a->To = to;
+        a->Start = GUI.Time;
+        a->Duration = duration;
+        a->Set = set;
+    }
+    return a;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_ANIM_Init(void) {
+    memset((void *)Anims, 0x00, sizeof(Anims));
+}
+
+/*
+ * Update all animations for current time, called once per frame
+ *
+ * Position and size animations of the same widget are collected first
+ * and widget is moved and invalidated only once.
+ */
+void __GUI_ANIM_Process(void) {
+    GUI_ANIM_t *a, *b;
+    int32_t geo[4];
+    uint32_t time = GUI.Time;                       /* Time is changed by timer interrupt, use the same value for all steps */
+    uint8_t i, j;
+    
+    for (i = 0; i < GUI_ANIM_MAX_COUNT; i++) {
+        Anims[i].Applied = 0;
+        Anims[i].Finished = 0;
+    }
+    for (i = 0; i < GUI_ANIM_MAX_COUNT; i++) {
+        a = &Anims[i];
+        if (!a->Widget || a->Applied) {
+            continue;
+        }
+        if (__ANIM_IS_GEOMETRY(a->Property)) {
+            geo[GUI_ANIM_PROP_X] = a->Widget->X;
+            geo[GUI_ANIM_PROP_Y] = a->Widget->Y;
+            geo[GUI_ANIM_PROP_WIDTH] = a->Widget->Width;
+            geo[GUI_ANIM_PROP_HEIGHT] = a->Widget->Height;
+            for (j = i; j < GUI_ANIM_MAX_COUNT; j++) {  /* Other animations of the same widget */
+                b = &Anims[j];
+                if (b->Widget == a->Widget && __ANIM_IS_GEOMETRY(b->Property)) {
+                    geo[b->Property] = __Value(b, time);
+                    b->Applied = 1;
+                }
+            }
+            __SetGeometry(a->Widget, geo[GUI_ANIM_PROP_X], geo[GUI_ANIM_PROP_Y], geo[GUI_ANIM_PROP_WIDTH], geo[GUI_ANIM_PROP_HEIGHT]);
+        } else {
+            a->Applied = 1;
+            a->Set(a->Widget, __Value(a, time));
+        }
+    }
+    for (i = 0; i < GUI_ANIM_MAX_COUNT; i++) {      /* Finish animations after all values are set */
+        a = &Anims[i];
+        if (a->Widget && a->Finished) {             /* Only when end value was set */
+            __Stop(a, 1);
+        }
+    }
+}
+
+GUI_ANIM_t* GUI_ANIM_Start(GUI_HANDLE_t h, GUI_ANIM_PROP_t prop, int32_t to, uint32_t duration, GUI_ANIM_EASING_t easing) {
+    GUI_ANIM_t* a;
+    int32_t from;
+    
+    __GUI_ASSERTPARAMS(h && __ANIM_IS_GEOMETRY(prop));  /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (prop == GUI_ANIM_PROP_X) {                  /* Start from current value */
+        from = h->X;
+    } else if (prop == GUI_ANIM_PROP_Y) {
+        from = h->Y;
+    } else if (prop == GUI_ANIM_PROP_WIDTH) {
+        from = h->Width;
+    } else {
+        from = h->Height;
+    }
+    a = __Start(h, prop, 0, from, to, duration, easing);
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return a;
+}
+
+GUI_ANIM_t* GUI_ANIM_StartValue(GUI_HANDLE_t h, GUI_ANIM_PROP_t prop, GUI_ANIM_Set_t set, int32_t from, int32_t to, uint32_t duration, GUI_ANIM_EASING_t easing) {
+    GUI_ANIM_t* a;
+    
+    __GUI_ASSERTPARAMS(h && set && !__ANIM_IS_GEOMETRY(prop));  /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    a = __Start(h, prop, set, from, to, duration, easing);
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return a;
+}
+
+uint8_t GUI_ANIM_SetCallback(GUI_ANIM_t* a, void (*callback)(GUI_ANIM_t *, uint8_t), void* param) {
+    __GUI_ASSERTPARAMS(a && a->Widget);             /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    a->Callback = callback;
+    a->Param = param;
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_ANIM_Cancel(GUI_ANIM_t* a) {
+    __GUI_ASSERTPARAMS(a && a->Widget);             /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __Stop(a, 0);                                   /* Property keeps current value */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_ANIM_CancelWidget(GUI_HANDLE_t h) {
+    uint8_t i;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    for (i = 0; i < GUI_ANIM_MAX_COUNT; i++) {
+        if (Anims[i].Widget == h) {
+            __Stop(&Anims[i], 0);
+        }
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
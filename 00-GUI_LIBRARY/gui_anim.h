@@ -0,0 +1,168 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI widget property animations
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_ANIM_H
+#define GUI_ANIM_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_ANIM
+ * \brief         Time based animations of widget properties
+ *
+ * Animation changes widget property from start to end value in given time using easing curve.
+ * Time is taken from \ref GUI_t.Time which is updated with \ref GUI_UpdateTime.
+ *
+ * All animations are updated once per frame in \ref GUI_Process before drawing.
+ * Position and size changes of the same widget are applied together,
+ * changed areas of all animations are redrawn in single frame.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_ANIM_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+/**
+ * \brief         Maximal number of animations running at the same time
+ */
+#ifndef GUI_ANIM_MAX_COUNT
+#define GUI_ANIM_MAX_COUNT          16
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_ANIM_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Animated property
+ */
+typedef enum GUI_ANIM_PROP_t {
+    GUI_ANIM_PROP_X = 0x00,                 /*!< X position relative to parent */
+    GUI_ANIM_PROP_Y,                        /*!< Y position relative to parent */
+    GUI_ANIM_PROP_WIDTH,                    /*!< Widget width */
+    GUI_ANIM_PROP_HEIGHT,                   /*!< Widget height */
+    GUI_ANIM_PROP_COLOR,                    /*!< Color set with user function, channels are animated separately */
+    GUI_ANIM_PROP_VALUE,                    /*!< Value set with user function */
+} GUI_ANIM_PROP_t;
+
+/**
+ * \brief         Easing curve
+ */
+typedef enum GUI_ANIM_EASING_t {
+    GUI_ANIM_EASING_LINEAR = 0x00,          /*!< Constant speed */
+    GUI_ANIM_EASING_IN_QUAD,                /*!< Quadratic, slow start */
+    GUI_ANIM_EASING_OUT_QUAD,               /*!< Quadratic, slow end */
+    GUI_ANIM_EASING_IN_OUT_QUAD,            /*!< Quadratic, slow start and end */
+    GUI_ANIM_EASING_IN_CUBIC,               /*!< Cubic, slow start */
+    GUI_ANIM_EASING_OUT_CUBIC,              /*!< Cubic, slow end */
+    GUI_ANIM_EASING_IN_OUT_CUBIC,           /*!< Cubic, slow start and end */
+} GUI_ANIM_EASING_t;
+
+/**
+ * \brief         Function to set color or value property of widget
+ */
+typedef GUI_HANDLE_t (*GUI_ANIM_Set_t)(GUI_HANDLE_t h, int32_t value);
+
+/**
+ * \brief         Single animation
+ */
+typedef struct GUI_ANIM_t {
+    GUI_HANDLE_t Widget;                    /*!< Animated widget, NULL if entry is free */
+    GUI_ANIM_PROP_t Property;               /*!< Animated property */
+    GUI_ANIM_EASING_t Easing;               /*!< Easing curve */
+    int32_t From;                           /*!< Start value */
+    int32_t To;                             /*!< End value */
+    uint32_t Start;                         /*!< Start time in units of milliseconds */
+    uint32_t Duration;                      /*!< Duration in units of milliseconds */
+    GUI_ANIM_Set_t Set;                     /*!< Function to set color or value */
+    void (*Callback)(struct GUI_ANIM_t *, uint8_t); /*!< Called when animation is finished (1) or cancelled (0), with pointer returned on start */
+    void* Param;                            /*!< User parameter for callback */
+    uint8_t Applied;                        /*!< Value was applied in current frame */
+    uint8_t Finished;                       /*!< End value was applied in current frame */
+    uint8_t Stopping;                       /*!< Callback is running, entry is released after it returns */
+} GUI_ANIM_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_ANIM_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+GUI_ANIM_t* GUI_ANIM_Start(GUI_HANDLE_t h, GUI_ANIM_PROP_t prop, int32_t to, uint32_t duration, GUI_ANIM_EASING_t easing);
+GUI_ANIM_t* GUI_ANIM_StartValue(GUI_HANDLE_t h, GUI_ANIM_PROP_t prop, GUI_ANIM_Set_t set, int32_t from, int32_t to, uint32_t duration, GUI_ANIM_EASING_t easing);
+uint8_t GUI_ANIM_SetCallback(GUI_ANIM_t* a, void (*callback)(GUI_ANIM_t *, uint8_t), void* param);
+uint8_t GUI_ANIM_Cancel(GUI_ANIM_t* a);
+uint8_t GUI_ANIM_CancelWidget(GUI_HANDLE_t h);
+
+void __GUI_ANIM_Init(void);
+void __GUI_ANIM_Process(void);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -92,7 +92,7 @@ extern "C" {
 #define GUI_COLOR_TRANSPARENT_40    0x66000000
 #define GUI_COLOR_TRANSPARENT_45    0x72000000
 #define GUI_COLOR_TRANSPARENT_50    0x7F000000
-#define GUI_COLOR_TRANSPARENT_55    0x7C000000
+#define GUI_COLOR_TRANSPARENT_55    0x8C000000
 #define GUI_COLOR_TRANSPARENT_60    0x99000000
 #define GUI_COLOR_TRANSPARENT_65    0xA5000000
 #define GUI_COLOR_TRANSPARENT_70    0xB2000000
@@ -103,6 +103,20 @@ extern "C" {
 #define GUI_COLOR_TRANSPARENT_95    0xF2000000
 #define GUI_COLOR_TRANSPARENT_100   0xFF000000
     
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        GUI_PixelFormats
+ * \brief           List of supported pixel formats for layers memory
+ * \{
+ */
+
+#define GUI_PIXEL_FORMAT_ARGB8888   0x00    /*!< 32-bit pixel, alpha, red, green and blue channel with 8 bits each */
+#define GUI_PIXEL_FORMAT_RGB565     0x01    /*!< 16-bit pixel, 5 bits red, 6 bits green and 5 bits blue channel */
+#define GUI_PIXEL_FORMAT_L8         0x02    /*!< 8-bit luminance pixel */
+
 /**
  * \}
  */
@@ -173,13 +187,23 @@ typedef enum GUI_TouchState_t {
     GUI_TouchState_RELEASED = 0x00          /*!< Touch released */
 } GUI_TouchState_t;
 
+/**
+ * \brief           Maximal number of touch points in single touch sample
+ */
+#ifndef GUI_TOUCH_MAX_PRESSES
+#define GUI_TOUCH_MAX_PRESSES   5
+#endif
+
 /**
  * \brief           Single touch data structure
+ * \note            First touch point is used for widget events, others are used for gestures
  */
 typedef struct GUI_TouchData_t {
-    GUI_Dim_t X;                            /*!< Touch X coordinate */
-    GUI_Dim_t Y;                            /*!< Touch Y coordinate */
+    GUI_Dim_t X[GUI_TOUCH_MAX_PRESSES];     /*!< Touch X coordinates */
+    GUI_Dim_t Y[GUI_TOUCH_MAX_PRESSES];     /*!< Touch Y coordinates */
+    uint8_t Count;                          /*!< Number of valid touch points */
     GUI_TouchState_t Status;                /*!< Touch status, pressed or released */
+    uint32_t Time;                          /*!< Time of sample in units of milliseconds, set on \ref GUI_INPUT_AddTouch */
 } GUI_TouchData_t;
 
 /**
@@ -210,6 +234,8 @@ typedef struct GUI_LCD_t {
     uint8_t DrawingLayer;                   /*!< Currently active drawing layer */
     uint8_t LayersCount;                    /*!< Number of layers used for LCD and drawings */
     GUI_Layer_t* Layers;                    /*!< Pointer to layers */
+    uint8_t PixelFormat;                    /*!< Pixel format of layers memory, one of GUI_PIXEL_FORMAT_xx values */
+    uint8_t PixelSize;                      /*!< Number of bytes for single pixel in layers memory */
     uint32_t Flags;                         /*!< List of flags */
 } GUI_LCD_t;
 
@@ -230,6 +256,14 @@ typedef enum GUI_LL_Command_t {
     GUI_LL_Command_SetActiveLayer           /*!< Set new layer as active layer */
 } GUI_LL_Command_t;
 
+/**
+ * \brief           Callback for decoded image blocks
+ *
+ * Called with position and size of block relative to image, pointer to ARGB8888 pixels
+ * and number of pixels between end of one block line and start of next one.
+ */
+typedef void (*GUI_JPEG_Callback_t)(void* param, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, const uint32_t* pixels, GUI_Dim_t offLine);
+
 /**
  * \brief           GUI Low-Level structure for drawing operations
  */
@@ -242,6 +276,10 @@ typedef struct GUI_LL_t {
     void            (*DrawHLine)    (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);
     void            (*DrawVLine)    (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);
     void            (*FillRect)     (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);
+    void            (*BlendHLine)   (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, const GUI_Byte *, GUI_Color_t);
+    void            (*FillBlend)    (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);
+    void            (*CopyBlend)    (GUI_LCD_t* LCD, uint8_t layer, void *, void *, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Byte);
+    uint8_t         (*DecodeJPEG)   (GUI_LCD_t* LCD, const GUI_Byte *, uint32_t, const GUI_Display_t *, GUI_JPEG_Callback_t, void *);
 } GUI_LL_t;
 
 
@@ -564,6 +602,7 @@ typedef struct GUI_WIDGET_t {
         __GUI_TouchStatus_t (*TouchUp)      (void *, GUI_TouchData_t *, __GUI_TouchStatus_t);
         __GUI_TouchStatus_t (*TouchMove)    (void *, GUI_TouchData_t *, __GUI_TouchStatus_t);
     } TouchEvents;
+    void (*WidgetRemove)(void *);           /*!< Optional function to release widget resources, called before widget is removed */
 } GUI_WIDGET_t;
 
 /**
@@ -575,6 +614,7 @@ typedef struct GUI_HANDLE {
     const GUI_WIDGET_t* Widget;             /*!< Widget parameters with callback functions */
     struct GUI_HANDLE* Parent;              /*!< Pointer to parent window object */
     uint8_t ParentType;                     /*!< Type of parent element */
+    uint16_t Index;                         /*!< Index of widget in widget state store */
     GUI_Dim_t X;                            /*!< Object X position relative to parent window in units of pixels */
     GUI_Dim_t Y;                            /*!< Object Y position relative to parent window in units of pixels */
     GUI_Dim_t Width;                        /*!< Object width in units of pixels */
@@ -601,7 +641,7 @@ typedef GUI_HANDLE* GUI_HANDLE_t;
 /**
  * \brief           Flags management
  */
-#define GUI_FLAG_REDRAW                 ((uint32_t)(1UL << 0UL))    /*!< Indicates widget should be redrawn */
+#define GUI_FLAG_REDRAW                 ((uint32_t)(1UL << 0UL))    /*!< Not used anymore, redraw state is kept in widget store, see \ref __GUI_WIDGET_SetRedraw */
 #define GUI_FLAG_CHILD                  ((uint32_t)(1UL << 1UL))    /*!< Indicates widget is child (window) */
 #define GUI_FLAG_DYNAMICTEXTALLOC       ((uint32_t)(1UL << 2UL))    /*!< Indicates memory for text has been dynamically allocated */
 #define GUI_FLAG_ACTIVE                 ((uint32_t)(1UL << 3UL))    /*!< Indicates widget is active by mouser or touch */
@@ -609,6 +649,9 @@ typedef GUI_HANDLE* GUI_HANDLE_t;
 #define GUI_FLAG_VISIBLE                ((uint32_t)(1UL << 5UL))    /*!< Indicates widget is visible */
 #define GUI_FLAG_DISABLED               ((uint32_t)(1UL << 6UL))    /*!< Indicates widget is disabled */
 #define GUI_FLAG_3D                     ((uint32_t)(1UL << 7UL))    /*!< Indicates widget has enabled 3D style */
+#define GUI_FLAG_CACHE                  ((uint32_t)(1UL << 8UL))    /*!< Indicates widget is drawn with its children through off-screen surface */
+#define GUI_FLAG_OPAQUE                 ((uint32_t)(1UL << 9UL))    /*!< Indicates widget covers its complete area with opaque pixels */
+#define GUI_FLAG_EXTERNALMEM            ((uint32_t)(1UL << 10UL))   /*!< Indicates widget memory is part of bigger block and is not freed on remove */
 
 #define GUI_FLAG_LCD_WAIT_LAYER_CONFIRM ((uint32_t)(1UL << 0UL))    /*!< Indicates waiting for layer change confirmation */
 
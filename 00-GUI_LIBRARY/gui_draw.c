@@ -24,12 +24,49 @@
  * |----------------------------------------------------------------------
  */
 #include "gui_draw.h"
+#include "gui_jpeg.h"
 
 /******************************************************************************/
 /******************************************************************************/
 /***                           Private structures                            **/
 /******************************************************************************/
 /******************************************************************************/
+/**
+ * \brief           Arc limits for anti-aliased ring drawing
+ */
+typedef struct __AA_Arc_t {
+    int32_t SX, SY;                                 /*!< Start direction vector, Q14 format */
+    int32_t EX, EY;                                 /*!< End direction vector, Q14 format */
+    uint8_t Large;                                  /*!< Set to 1 when arc is bigger than 180 degrees */
+} __AA_Arc_t;
+
+/**
+ * \brief           Polygon edge for scanline fill
+ */
+typedef struct __DRAW_Edge_t {
+    int32_t X;                                      /*!< X coordinate at current scanline center, 16.16 format */
+    int32_t DX;                                     /*!< X increment for each scanline, 16.16 format */
+    int32_t YMin;                                   /*!< First visible scanline covered by edge */
+    int32_t YMax;                                   /*!< First scanline not covered by edge anymore */
+    int32_t Dir;                                    /*!< Winding direction, 1 for downward and -1 for upward edge */
+} __DRAW_Edge_t;
+
+/**
+ * \brief           Image decoder state
+ */
+typedef struct __DRAW_ImageStream_t {
+    GUI_Const GUI_Byte* Data;                       /*!< Pointer to next byte in image data */
+    GUI_Byte Count;                                 /*!< Number of pixels left in current RLE packet */
+    GUI_Byte Repeat;                                /*!< Current RLE packet repeats single index */
+} __DRAW_ImageStream_t;
+
+/**
+ * \brief           Position of image for decoder callback
+ */
+typedef struct __DRAW_ImagePos_t {
+    GUI_iDim_t X, Y;                                /*!< Top left image position on screen */
+    GUI_Display_t Clip;                             /*!< Visible part of image, relative to image */
+} __DRAW_ImagePos_t;
 
 
 /******************************************************************************/
@@ -39,11 +76,30 @@
 /******************************************************************************/
 #define GUI_USE_CLIPPING        1
 
+#define GUI_DRAW_AA_BUFF_SIZE   32              /* Number of coverage values processed at a time */
+#define __AA_MODE_FILL          0x00            /* Fill anti-aliased shape */
+#define __AA_MODE_RING          0x01            /* Draw 1 pixel wide anti-aliased outline */
+#define GUI_DRAW_POLY_EDGES     8               /* Number of polygon edges processed without memory allocation */
+#define GUI_DRAW_IMAGE_BUFF_SIZE    64          /* Number of decoded image pixels blended at a time */
+
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private variables                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Sine values from 0 to 90 degrees in Q14 format */
+static const int16_t __DRAW_SinTable[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
 
 
 /******************************************************************************/
@@ -63,89 +119,649 @@ GUI_Dim_t __StringWidth(GUI_Const GUI_FONT_t* font, const char* str) {
     return out;
 }
 
-/* Draw character to screen */
-/* X and Y coordinates are TOP LEFT coordinates for character */
-void __DRAW_Char(GUI_Display_t* disp, GUI_Const GUI_FONT_t* font, GUI_DRAW_FONT_t* draw, GUI_Dim_t x, GUI_Dim_t y, const GUI_FONT_CharInfo_t* c) {
-    GUI_Byte i, b;
-    GUI_Dim_t x1;
-    GUI_iByte k;
-    GUI_Byte columns;
+/* Draw single horizontal span from x1 to x2 (both inclusive), clipped against display */
+static void __DRAW_HSpan(GUI_Display_t* disp, int32_t x1, int32_t x2, int32_t y, GUI_Color_t color) {
+    if (y < disp->Y1 || y >= disp->Y2) {            /* Check if row is inside clipping region */
+        return;
+    }
+    if (x1 < disp->X1) {                            /* Clip left side */
+        x1 = disp->X1;
+    }
+    if (x2 >= disp->X2) {                           /* Clip right side */
+        x2 = disp->X2 - 1;
+    }
+    if (x2 < x1) {                                  /* Nothing left to draw */
+        return;
+    }
+    GUI.LL.DrawHLine(&GUI.LCD, GUI.LCD.DrawingLayer, x1, y, x2 - x1 + 1, color);
+}
+
+/*
+ * Scanline fill of rounded rectangle, exactly one span per row
+ *
+ * Corner centers are placed the same way as in outline functions,
+ * so circle is rounded rectangle with width and height equal to 2 * r
+ */
+static void __DRAW_FilledRoundedSpans(GUI_Display_t* disp, int32_t x, int32_t y, int32_t width, int32_t height, int32_t r, GUI_Color_t color) {
+    int32_t cx1, cx2, cy1, cy2, d, hw, lim, ymin, ymax, y1, y2;
+
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (r > width / 2) {                            /* Radius may not be bigger than half of size */
+        r = width / 2;
+    }
+    if (r > height / 2) {
+        r = height / 2;
+    }
+
+    ymin = __GUI_MAX(y, (int32_t)disp->Y1);         /* Get visible rows */
+    ymax = __GUI_MIN(y + height, (int32_t)disp->Y2);
+    if (ymin >= ymax || x >= disp->X2 || (x + width) <= disp->X1) {
+        return;                                     /* Object is outside clipping region */
+    }
+
+    cx1 = x + r;                                    /* Corner circle centers */
+    cx2 = x + width - r - 1;
+    cy1 = y + r;
+    cy2 = y + height - r - 1;
+
+    /* Middle part has full width, draw it with single rectangle fill */
+    y1 = __GUI_MAX(cy1, ymin);
+    y2 = __GUI_MIN(cy2 + 1, ymax);
+    if (y1 < y2) {
+        int32_t x1 = __GUI_MAX(x, (int32_t)disp->X1);
+        int32_t x2 = __GUI_MIN(x + width, (int32_t)disp->X2);
+        GUI.LL.FillRect(&GUI.LCD, GUI.LCD.DrawingLayer, x1, y1, x2 - x1, y2 - y1, color);
+    }
+
+    /* Corner rows, start on top and go to center, width only increases */
+    lim = r * r + r / 2;                            /* Matches midpoint outline without overlapping it */
+    hw = 0;
+    for (d = r; d > 0; d--) {
+        while ((hw + 1) * (hw + 1) + d * d <= lim) {
+            hw++;
+        }
+        __DRAW_HSpan(disp, cx1 - hw, cx2 + hw, cy1 - d, color); /* Top row */
+        __DRAW_HSpan(disp, cx1 - hw, cx2 + hw, cy2 + d, color); /* Bottom row */
+    }
+}
+
+/* Draw single vertical span from y1 to y2 (both inclusive), clipped against display */
+static void __DRAW_VSpan(GUI_Display_t* disp, int32_t x, int32_t y1, int32_t y2, GUI_Color_t color) {
+    if (x < disp->X1 || x >= disp->X2) {            /* Check if column is inside clipping region */
+        return;
+    }
+    if (y1 < disp->Y1) {                            /* Clip top side */
+        y1 = disp->Y1;
+    }
+    if (y2 >= disp->Y2) {                           /* Clip bottom side */
+        y2 = disp->Y2 - 1;
+    }
+    if (y2 < y1) {                                  /* Nothing left to draw */
+        return;
+    }
+    GUI.LL.DrawVLine(&GUI.LCD, GUI.LCD.DrawingLayer, x, y1, y2 - y1 + 1, color);
+}
+
+/* Blend foreground color over background color, alpha is from 0 to 255 */
+static GUI_Color_t __DRAW_BlendColor(GUI_Color_t bg, GUI_Color_t fg, uint32_t a) {
+    a += a >> 7;                                    /* Scale 0-255 to 0-256 */
+    return
+        ((((fg & 0x00FF00FFUL) * a + (bg & 0x00FF00FFUL) * (256 - a)) >> 8) & 0x00FF00FFUL) |
+        ((((fg & 0x0000FF00UL) * a + (bg & 0x0000FF00UL) * (256 - a)) >> 8) & 0x0000FF00UL);
+}
+
+/* Fill already clipped rectangle with transparent color */
+static void __DRAW_FillBlend(GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Color_t color) {
+    GUI_Dim_t i, j;
+    uint32_t a = 0xFF - (color >> 24);              /* Get opacity from transparency */
     
-    y += c->yPos;                                   /* Set Y position */
+    if (!a) {                                       /* Fully transparent, nothing to draw */
+        return;
+    }
+    if (GUI.LL.FillBlend) {                         /* Let driver blend whole area */
+        GUI.LL.FillBlend(&GUI.LCD, GUI.LCD.DrawingLayer, x, y, width, height, color);
+        return;
+    }
+    for (j = y; j < y + height; j++) {
+        for (i = x; i < x + width; i++) {
+            GUI.LL.SetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, i, j, 
+                __DRAW_BlendColor(GUI.LL.GetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, i, j), color, a));
+        }
+    }
+}
+
+/*
+ * Blend color over horizontal span with per-pixel coverage, clipped against display
+ *
+ * Whole span is passed to low-level driver at once so it can do single
+ * read-modify-write pass over memory. Per-pixel access is only a fallback.
+ */
+static void __DRAW_BlendHSpan(GUI_Display_t* disp, int32_t x, int32_t y, const GUI_Byte* cov, int32_t len, GUI_Color_t color) {
+    if (y < disp->Y1 || y >= disp->Y2) {            /* Check if row is inside clipping region */
+        return;
+    }
+    if (x < disp->X1) {                             /* Clip left side */
+        cov += disp->X1 - x;
+        len -= disp->X1 - x;
+        x = disp->X1;
+    }
+    if ((x + len) > disp->X2) {                     /* Clip right side */
+        len = disp->X2 - x;
+    }
+    while (len > 0 && !cov[0]) {                    /* Skip empty pixels on the left */
+        cov++;
+        x++;
+        len--;
+    }
+    while (len > 0 && !cov[len - 1]) {              /* Skip empty pixels on the right */
+        len--;
+    }
+    if (len <= 0) {
+        return;
+    }
     
-    if (font->Flags & GUI_FLAG_FONT_AA) {           /* Font has anti alliasing enabled */
-        GUI_Color_t color;                          /* Temporary color for AA */
-        GUI_Byte tmp, r1, g1, b1;
-        
-        columns = c->xSize / 4;                     /* Calculate number of bytes used for single character line */
-        if (c->xSize % 4) {                         /* If only 1 column used */
-            columns++;
-        }   
-        
-        for (i = 0; i < columns * c->ySize; i++) {  /* Go through all data bytes */
-            if (y < disp->Y1 || y > disp->Y2) {     /* Do not draw when we are outside clipping are */
-                goto draw_char_handle_y_aa;
+    if (GUI.LL.BlendHLine) {                        /* Let driver process span at once */
+        GUI.LL.BlendHLine(&GUI.LCD, GUI.LCD.DrawingLayer, x, y, len, cov, color);
+    } else {
+        for (; len > 0; len--, x++, cov++) {
+            if (*cov == 0xFF) {
+                GUI.LL.SetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, x, y, color);
+            } else if (*cov) {
+                GUI.LL.SetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, x, y, 
+                    __DRAW_BlendColor(GUI.LL.GetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, x, y), color, *cov));
             }
-            b = c->Data[i];                         /* Get character byte */
-            for (k = 0; k < 4; k++) {               /* Scan each bit in byte */
-                GUI_Color_t baseColor;
-                x1 = x + (i % columns) * 4 + k;     /* Get new X value for pixel draw */
-                if (x1 < disp->X1 || x1 > disp->X2) {
-                    continue;
+        }
+    }
+}
+
+/* Integer square root */
+static uint32_t __DRAW_Sqrt(uint32_t v) {
+    uint32_t res = 0, bit = 1UL << 30;
+    
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/* Integer square root of 64-bit value */
+static uint32_t __DRAW_Sqrt64(uint64_t v) {
+    uint64_t res = 0, bit = 1ULL << 62;
+    
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+/* Get sine value of angle in degrees in Q14 format */
+static int32_t __DRAW_Sin(int32_t angle) {
+    angle %= 360;
+    if (angle < 0) {
+        angle += 360;
+    }
+    if (angle <= 90) {
+        return __DRAW_SinTable[angle];
+    } else if (angle <= 180) {
+        return __DRAW_SinTable[180 - angle];
+    } else if (angle <= 270) {
+        return -__DRAW_SinTable[angle - 180];
+    }
+    return -__DRAW_SinTable[360 - angle];
+}
+
+/* Check if vector from arc center is inside arc limits */
+static uint8_t __AA_ArcInside(const __AA_Arc_t* arc, int32_t vx, int32_t vy) {
+    int32_t c1, c2;
+    
+    c1 = arc->SX * vy - arc->SY * vx;               /* Positive when clockwise from start vector */
+    c2 = arc->EX * vy - arc->EY * vx;               /* Positive when clockwise from end vector */
+    if (arc->Large) {
+        return c1 >= 0 || c2 <= 0;
+    }
+    return c1 >= 0 && c2 <= 0;
+}
+
+/*
+ * Get pixel coverage from 0 to 255
+ *
+ * vx and vy are pixel center offsets from corner center in units of half pixels,
+ * outer and inner are edge distances in Q6 format
+ */
+static int32_t __AA_Coverage(int32_t vx, int32_t vy, int32_t outer, int32_t inner, uint8_t mode) {
+    int32_t d, c, ci;
+    uint64_t sq = (uint64_t)((int64_t)vx * vx) + (uint64_t)((int64_t)vy * vy);
+    
+    if (sq <= (0xFFFFFFFFUL >> 10)) {               /* Distance in Q6 format */
+        d = __DRAW_Sqrt((uint32_t)sq << 10);
+    } else {                                        /* Radius over 1000 pixels needs more than 32 bits */
+        d = __DRAW_Sqrt64(sq << 10);
+    }
+    c = __GUI_MAX(__GUI_MIN((outer - d) * 4, 0xFF), 0);
+    if (mode == __AA_MODE_RING) {
+        ci = __GUI_MAX(__GUI_MIN((d - inner) * 4, 0xFF), 0);
+        c = __GUI_MIN(c, ci);
+    }
+    return c;
+}
+
+/*
+ * Draw anti-aliased rounded rectangle, row by row
+ *
+ * Shape covers area from x to x + width and from y to y + height with pixel edges
+ * on integer coordinates. Only pixels in corner rows need coverage calculation.
+ * Coverage of right corner is calculated from outside to inside and mirrored to left corner,
+ * rest of the row is drawn as solid span. Circle is rounded rectangle with width and height equal to 2 * r.
+ * First pixel of each corner row is found from outer edge directly and columns where
+ * both right pixel and its left pair are outside clipping region are not calculated.
+ */
+static void __DRAW_RoundedAA(GUI_Display_t* disp, int32_t x, int32_t y, int32_t width, int32_t height, int32_t r, uint8_t mode, const __AA_Arc_t* arc, GUI_Color_t color) {
+    GUI_Byte rbuff[GUI_DRAW_AA_BUFF_SIZE], lbuff[GUI_DRAW_AA_BUFF_SIZE];
+    int32_t cx, cyt, cyb, mirror, outer, inner, ymin, ymax, y1, y2;
+    int32_t px, py, vx, vy, c, n, pxmin, pxmax;
+    int64_t e;
+    uint8_t started, stop;
+    
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (r > width / 2) {                            /* Radius may not be bigger than half of size */
+        r = width / 2;
+    }
+    if (r > height / 2) {
+        r = height / 2;
+    }
+    
+    ymin = __GUI_MAX(y, (int32_t)disp->Y1);         /* Get visible rows */
+    ymax = __GUI_MIN(y + height, (int32_t)disp->Y2);
+    if (ymin >= ymax || x >= disp->X2 || (x + width) <= disp->X1) {
+        return;                                     /* Object is outside clipping region */
+    }
+    
+    outer = 64 * r + 32;                            /* Outer edge distance for pixel center */
+    inner = 64 * (r - 1) - 32;                      /* Inner edge distance for pixel center */
+    cx = 2 * (x + width - r);                       /* Right corner center in half pixels */
+    cyt = 2 * (y + r);                              /* Top corner center in half pixels */
+    cyb = 2 * (y + height - r);                     /* Bottom corner center in half pixels */
+    mirror = 2 * x + width - 1;                     /* Right pixel px has left pair on mirror - px */
+    
+    /* Columns where right pixel or its left pair is visible */
+    pxmax = __GUI_MIN(x + width - 1, __GUI_MAX((int32_t)disp->X2 - 1, mirror - (int32_t)disp->X1));
+    pxmin = __GUI_MIN((int32_t)disp->X1, mirror - (int32_t)disp->X2 + 1);
+    
+    /* Straight part between corners does not need any coverage */
+    y1 = __GUI_MAX(y + r, ymin);
+    y2 = __GUI_MIN(y + height - r, ymax);
+    if (y1 < y2) {
+        if (mode == __AA_MODE_FILL) {
+            int32_t x1 = __GUI_MAX(x, (int32_t)disp->X1);
+            int32_t x2 = __GUI_MIN(x + width, (int32_t)disp->X2);
+            GUI.LL.FillRect(&GUI.LCD, GUI.LCD.DrawingLayer, x1, y1, x2 - x1, y2 - y1, color);
+        } else {
+            __DRAW_VSpan(disp, x, y1, y2 - 1, color);
+            __DRAW_VSpan(disp, x + width - 1, y1, y2 - 1, color);
+        }
+    }
+    
+    for (py = ymin; py < ymax; py++) {
+        if (py >= y1 && py < y2) {                  /* Skip straight part */
+            py = y2 - 1;
+            continue;
+        }
+        vy = 2 * py + 1;                            /* Row center in half pixels */
+        vy = vy < cyt ? vy - cyt : vy - cyb;        /* Signed offset from corner center */
+        
+        /* Pixel has coverage when (vx * vx + vy * vy) << 10 < outer * outer, vx is odd */
+        e = (int64_t)outer * outer - ((int64_t)vy * vy << 10);
+        vx = e > 0 ? (int32_t)__DRAW_Sqrt64((uint64_t)(e - 1) >> 10) : 0;
+        px = vx ? cx / 2 + (vx - 1) / 2 : cx / 2 - 1;
+        px = __GUI_MIN(px, pxmax);
+        started = 0;
+        stop = 0;
+        while (!stop) {
+            n = 0;
+            while (n < GUI_DRAW_AA_BUFF_SIZE) {
+                if (px < pxmin) {                   /* Rest of the row is not visible */
+                    stop = 3;
+                    break;
                 }
-                if (x1 < (draw->X + draw->Color1Width)) {
-                    baseColor = draw->Color1;
-                } else {
-                    baseColor = draw->Color2;
+                vx = 2 * px + 1 - cx;
+                if (vx < 0) {                       /* We reached straight part of row */
+                    stop = 1;
+                    break;
+                }
+                c = __AA_Coverage(vx, vy, outer, inner, mode);
+                if (!started) {                     /* Skip pixels outside shape */
+                    if (!c) {
+                        px--;
+                        continue;
+                    }
+                    started = 1;
+                } else if (!c) {                    /* Ring only, we are inside */
+                    stop = 3;
+                    break;
                 }
-                tmp = (b >> (6 - 2 * k)) & 0x03;    /* Get temporary bits on bottom */
-                if (tmp == 0x03) {                  /* Draw solid color if both bits are enabled */
-                    GUI_DRAW_SetPixel(disp, x1, y, baseColor);
-                } else if (tmp) {                   /* Calculate new color */
-                    float t = (float)tmp / 3.0f;
-                    color = GUI_DRAW_GetPixel(disp, x1, y); /* Read current color */
-                    
-                    /* Calculate new values for pixel */
-                    r1 = (float)t * (float)((color >> 16) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >> 16) & 0xFF);
-                    g1 = (float)t * (float)((color >>  8) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >>  8) & 0xFF);
-                    b1 = (float)t * (float)((color >>  0) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >>  0) & 0xFF);
-                    
-                    /* Draw actual pixel to screen */
-                    GUI_DRAW_SetPixel(disp, x1, y, r1 << 16 | g1 << 8 | b1);
+                rbuff[GUI_DRAW_AA_BUFF_SIZE - 1 - n] = c;
+                lbuff[n] = c;
+                if (arc) {                          /* Cut pixels outside arc */
+                    if (!__AA_ArcInside(arc, vx, vy)) {
+                        rbuff[GUI_DRAW_AA_BUFF_SIZE - 1 - n] = 0;
+                    }
+                    if (!__AA_ArcInside(arc, -vx, vy)) {
+                        lbuff[n] = 0;
+                    }
+                }
+                n++;
+                px--;
+                if (c == 0xFF && mode == __AA_MODE_FILL) {  /* Rest of the row is covered */
+                    stop = 2;
+                    break;
                 }
             }
-draw_char_handle_y_aa:
-            if ((i % columns) == (columns - 1)) {   /* Check for next line */
-                y++;
+            if (n) {
+                __DRAW_BlendHSpan(disp, px + 1, py, &rbuff[GUI_DRAW_AA_BUFF_SIZE - n], n, color);
+                __DRAW_BlendHSpan(disp, mirror - (px + n), py, lbuff, n, color);
             }
         }
-    } else {
-        columns = c->xSize / 8;
-        if (c->xSize % 8) {
-            columns++;
+        
+        if (stop == 3 || (mirror - px) > px) {      /* Nothing between left and right part */
+            continue;
         }
-        for (i = 0; i < columns * c->ySize; i++) {  /* Go through all data bytes */
-            if (y < disp->Y1 || y > disp->Y2) {     /* Do not draw when we are outside clipping are */
-                goto draw_char_handle_y;
+        c = stop == 2 ? 0xFF : __AA_Coverage(0, vy, outer, inner, mode);
+        if (c == 0xFF) {
+            __DRAW_HSpan(disp, mirror - px, px, py, color);
+        } else if (c) {                             /* Top and bottom edge with partial coverage */
+            memset(lbuff, c, sizeof(lbuff));
+            for (vx = mirror - px; vx <= px; vx += GUI_DRAW_AA_BUFF_SIZE) {
+                __DRAW_BlendHSpan(disp, vx, py, lbuff, __GUI_MIN(px - vx + 1, GUI_DRAW_AA_BUFF_SIZE), color);
             }
-            b = c->Data[i];                         /* Get character byte */
-            for (k = 0; k < 8; k++) {               /* Scan each bit in byte */
-                if (b & (1 << (7 - k))) {           /* If bit is set, draw pixel */
-                    x1 = x + (i % columns) * 8 + k; /* Get new X value for pixel draw */
-                    if (x1 < disp->X1 || x1 > disp->X2) {
-                        continue;
+        }
+    }
+}
+
+/*
+ * Scanline fill of polygon with edge table and active edge list
+ *
+ * Polygon points are on pixel edges and pixel is filled when its center is inside,
+ * so shapes sharing an edge never draw the same pixel twice
+ */
+static void __DRAW_FillPolySpans(GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, GUI_Byte len, GUI_Byte rule, GUI_Color_t color) {
+    __DRAW_Edge_t edgesStatic[GUI_DRAW_POLY_EDGES], *activeStatic[GUI_DRAW_POLY_EDGES];
+    __DRAW_Edge_t *edges = edgesStatic, **active = activeStatic, *e, tmp;
+    int32_t i, j, cnt, next, nactive, y, ymin, ymax, x1, x2, dx, dy, dir, first, wind;
+    const GUI_DRAW_Poly_t *p1, *p2;
+    
+    if (len > GUI_DRAW_POLY_EDGES) {                /* Allocate memory for big polygons */
+        active = __GUI_MEMALLOC(len * (sizeof(*edges) + sizeof(*active)));
+        if (!active) {
+            return;
+        }
+        edges = (__DRAW_Edge_t *)&active[len];      /* Pointers first, edges keep alignment */
+    }
+    
+    /* Build edge table, skip horizontal edges and edges above visible area */
+    cnt = 0;
+    ymin = disp->Y2;
+    ymax = disp->Y1;
+    for (i = 0; i < len; i++) {
+        p1 = &points[i];
+        p2 = &points[(i + 1) % len];
+        if (p1->Y == p2->Y) {
+            continue;
+        }
+        if (p1->Y < p2->Y) {
+            dir = 1;
+        } else {
+            dir = -1;
+            p1 = p2;
+            p2 = &points[i];
+        }
+        first = __GUI_MAX((int32_t)p1->Y, (int32_t)disp->Y1);
+        if (p2->Y <= first) {
+            continue;
+        }
+        e = &edges[cnt++];
+        e->Dir = dir;
+        e->YMin = first;                            /* Edge starts at first visible scanline */
+        e->YMax = p2->Y;
+        dx = (int32_t)p2->X - (int32_t)p1->X;
+        dy = (int32_t)p2->Y - (int32_t)p1->Y;
+        
+        /* Crossing with center of first scanline, exact for edges starting far above visible area */
+        e->X = (int32_t)((int64_t)p1->X * 65536 + ((int64_t)dx * (2 * (first - p1->Y) + 1) * 32768) / dy);
+        e->DX = dy > 1 ? (int32_t)(((int64_t)dx * 65536) / dy) : 0;    /* Fits 32 bits when edge has more scanlines */
+        ymin = __GUI_MIN(ymin, e->YMin);
+        ymax = __GUI_MAX(ymax, e->YMax);
+    }
+    
+    /* Sort edge table by first scanline */
+    for (i = 1; i < cnt; i++) {
+        tmp = edges[i];
+        for (j = i; j > 0 && edges[j - 1].YMin > tmp.YMin; j--) {
+            edges[j] = edges[j - 1];
+        }
+        edges[j] = tmp;
+    }
+    
+    ymin = __GUI_MAX(ymin, (int32_t)disp->Y1);      /* Get visible rows */
+    ymax = __GUI_MIN(ymax, (int32_t)disp->Y2);
+    next = 0;
+    nactive = 0;
+    for (y = ymin; y < ymax; y++) {
+        /* Remove finished edges and move remaining to current scanline */
+        for (i = 0, j = 0; i < nactive; i++) {
+            if (active[i]->YMax > y) {
+                active[j++] = active[i];
+            }
+        }
+        nactive = j;
+        
+        /* Add new edges */
+        while (next < cnt && edges[next].YMin <= y) {
+            active[nactive++] = &edges[next++];
+        }
+        
+        /* Keep active list sorted by X, it is almost sorted from previous scanline */
+        for (i = 1; i < nactive; i++) {
+            e = active[i];
+            for (j = i; j > 0 && active[j - 1]->X > e->X; j--) {
+                active[j] = active[j - 1];
+            }
+            active[j] = e;
+        }
+        
+        /* Output spans, pixel is inside when its center is between 2 crossings */
+        wind = 0;
+        for (i = 0; i < nactive; i++) {
+            if (rule == GUI_DRAW_POLY_EVENODD) {
+                wind ^= 1;
+            } else {
+                wind += active[i]->Dir;
+            }
+            if (wind && (i + 1) < nactive) {
+                x1 = (active[i]->X + 0x7FFF) >> 16;
+                x2 = (active[i + 1]->X + 0x7FFF) >> 16;
+                if (x1 < x2) {
+                    __DRAW_HSpan(disp, x1, x2 - 1, y, color);
+                }
+            }
+        }
+        
+        for (i = 0; i < nactive; i++) {             /* Go to next scanline, edge stays between its end points */
+            if (active[i]->YMax > y + 1) {
+                active[i]->X += active[i]->DX;
+            }
+        }
+    }
+    
+    if (active != activeStatic) {
+        __GUI_MEMFREE(active);
+    }
+}
+
+/* Get pointer to pixel in drawing layer memory */
+static void* __DRAW_LayerAddress(GUI_Dim_t x, GUI_Dim_t y) {
+    return (void *)(uintptr_t)(GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress + GUI.LCD.PixelSize * ((uint32_t)GUI.LCD.Width * y + x));
+}
+
+/* Blend already clipped ARGB8888 memory area over drawing layer */
+static void __DRAW_ImageBlend(GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, const uint32_t* src, GUI_Dim_t offLine) {
+    GUI_Dim_t i, j;
+    uint32_t a;
+    
+    if (GUI.LL.CopyBlend) {                         /* Let driver blend whole area */
+        GUI.LL.CopyBlend(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)src, __DRAW_LayerAddress(x, y), width, height, offLine, GUI.LCD.Width - width, 0xFF);
+        return;
+    }
+    for (j = y; j < y + height; j++, src += offLine) {
+        for (i = x; i < x + width; i++, src++) {
+            a = *src >> 24;                         /* Pixel opacity */
+            if (a == 0xFF) {
+                GUI.LL.SetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, i, j, *src & 0x00FFFFFFUL);
+            } else if (a) {
+                GUI.LL.SetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, i, j, 
+                    __DRAW_BlendColor(GUI.LL.GetPixel(&GUI.LCD, GUI.LCD.DrawingLayer, i, j), *src, a));
+            }
+        }
+    }
+}
+
+/* Blend decoded image block, block position is relative to image */
+static void __DRAW_ImageBlock(void* param, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, const uint32_t* pixels, GUI_Dim_t offLine) {
+    __DRAW_ImagePos_t* pos = param;
+    int32_t x1, y1, x2, y2;
+    
+    x1 = x > pos->Clip.X1 ? x : pos->Clip.X1;
+    y1 = y > pos->Clip.Y1 ? y : pos->Clip.Y1;
+    x2 = (x + width) < pos->Clip.X2 ? (x + width) : pos->Clip.X2;
+    y2 = (y + height) < pos->Clip.Y2 ? (y + height) : pos->Clip.Y2;
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    pixels += (uint32_t)(width + offLine) * (y1 - y) + (x1 - x);
+    __DRAW_ImageBlend(pos->X + x1, pos->Y + y1, x2 - x1, y2 - y1, pixels, width + offLine - (x2 - x1));
+}
+
+/* Decode next pixels of image to ARGB8888 buffer, or skip them when buffer is not set */
+static void __DRAW_ImageDecode(__DRAW_ImageStream_t* s, const GUI_IMAGE_DESC_t* img, uint32_t* buff, int32_t len) {
+    uint32_t c;
+    int32_t i, cnt;
+    
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_RGB565:
+            if (buff) {
+                const uint16_t* p = (const uint16_t *)s->Data;
+                for (i = 0; i < len; i++) {
+                    c = p[i];
+                    buff[i] = 0xFF000000UL |
+                        ((c & 0xF800) << 8) | ((c & 0xE000) << 3) |
+                        ((c & 0x07E0) << 5) | ((c & 0x0600) >> 1) |
+                        ((c & 0x001F) << 3) | ((c & 0x001C) >> 2);
+                }
+            }
+            s->Data += len * 2;
+            break;
+        case GUI_IMAGE_FORMAT_PAL8:
+            if (buff) {
+                for (i = 0; i < len; i++) {
+                    buff[i] = img->Palette[s->Data[i]];
+                }
+            }
+            s->Data += len;
+            break;
+        case GUI_IMAGE_FORMAT_RLE8:
+            while (len > 0) {
+                if (!s->Count) {                    /* Start new packet */
+                    s->Repeat = *s->Data & 0x80;
+                    s->Count = (*s->Data++ & 0x7F) + 1;
+                }
+                cnt = s->Count < len ? s->Count : len;
+                s->Count -= cnt;
+                len -= cnt;
+                if (s->Repeat) {                    /* Single index for all pixels in packet */
+                    if (buff) {
+                        c = img->Palette[*s->Data];
+                        for (i = 0; i < cnt; i++) {
+                            buff[i] = c;
+                        }
+                        buff += cnt;
+                    }
+                    if (!s->Count) {                /* Index byte is used until packet ends */
+                        s->Data++;
                     }
-                    if (x1 <= (draw->X + draw->Color1Width)) {
-                        GUI_DRAW_SetPixel(disp, x1, y, draw->Color1);
-                    } else {
-                        GUI_DRAW_SetPixel(disp, x1, y, draw->Color2);
+                } else {
+                    if (buff) {
+                        for (i = 0; i < cnt; i++) {
+                            buff[i] = img->Palette[s->Data[i]];
+                        }
+                        buff += cnt;
                     }
+                    s->Data += cnt;
                 }
             }
-draw_char_handle_y:
-            if ((i % columns) == (columns - 1)) {   /* Check for next line */
-                y++;
+            break;
+        default:
+            break;
+    }
+}
+
+/* Draw character to screen */
+/* X and Y coordinates are TOP LEFT coordinates for character */
+void __DRAW_Char(GUI_Display_t* disp, GUI_Const GUI_FONT_t* font, GUI_DRAW_FONT_t* draw, GUI_Dim_t x, GUI_Dim_t y, const GUI_FONT_CharInfo_t* c) {
+    GUI_Byte cov[GUI_DRAW_AA_BUFF_SIZE];            /* Coverage for part of single line */
+    GUI_Byte columns, i;
+    const GUI_Byte* line;
+    int32_t x1, k, n, len, split;
+    
+    y += c->yPos;                                   /* Set Y position */
+    split = draw->X + draw->Color1Width;            /* Pixels before this X use color 1 */
+    
+    if (font->Flags & GUI_FLAG_FONT_AA) {           /* Font has anti alliasing enabled, 2 bits per pixel */
+        columns = (c->xSize + 3) / 4;               /* Calculate number of bytes used for single character line */
+    } else {
+        columns = (c->xSize + 7) / 8;
+    }
+    
+    /* Convert each line to coverage values and blit them as spans */
+    for (i = 0; i < c->ySize; i++, y++) {
+        if (y < disp->Y1 || y >= disp->Y2) {        /* Do not draw when we are outside clipping are */
+            continue;
+        }
+        line = &c->Data[i * columns];
+        for (x1 = 0; x1 < c->xSize; x1 += n) {
+            n = __GUI_MIN(c->xSize - x1, GUI_DRAW_AA_BUFF_SIZE);
+            if (font->Flags & GUI_FLAG_FONT_AA) {
+                for (k = 0; k < n; k++) {
+                    cov[k] = ((line[(x1 + k) >> 2] >> (6 - 2 * ((x1 + k) & 0x03))) & 0x03) * 0x55;
+                }
+            } else {
+                for (k = 0; k < n; k++) {
+                    cov[k] = (line[(x1 + k) >> 3] >> (7 - ((x1 + k) & 0x07))) & 0x01 ? 0xFF : 0x00;
+                }
             }
+            len = __GUI_MAX(__GUI_MIN(split - (x + x1), n), 0); /* Number of pixels with color 1 */
+            __DRAW_BlendHSpan(disp, x + x1, y, cov, len, draw->Color1);
+            __DRAW_BlendHSpan(disp, x + x1 + len, y, &cov[len], n - len, draw->Color2);
         }
     }
 }
@@ -200,7 +816,11 @@ void GUI_DRAW_Fill(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t widt
         height = disp->Y2 - y;
     }
 #endif
-    GUI.LL.FillRect(&GUI.LCD, GUI.LCD.DrawingLayer, x, y, width, height, color);
+    if (color & 0xFF000000UL) {                     /* Color has transparency set */
+        __DRAW_FillBlend(x, y, width, height, color);
+    } else {
+        GUI.LL.FillRect(&GUI.LCD, GUI.LCD.DrawingLayer, x, y, width, height, color);
+    }
 }
 
 void GUI_DRAW_SetPixel(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
@@ -254,58 +874,83 @@ void GUI_DRAW_HLine(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t len
 /******************************************************************************/
 /******************************************************************************/
 void GUI_DRAW_Line(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2, GUI_Color_t color) {
-	int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0, 
-	yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0, 
-	curpixel = 0;
-
-	deltax = __GUI_ABS(x2 - x1);
-	deltay = __GUI_ABS(y2 - y1);
-	x = x1;
-	y = y1;
-	
-	if (x2 >= x1) {
-		xinc1 = 1;
-		xinc2 = 1;
-	} else {
-		xinc1 = -1;
-		xinc2 = -1;
-	}
-
-	if (y2 >= y1) {
-		yinc1 = 1;
-		yinc2 = 1;
-	} else {
-		yinc1 = -1;
-		yinc2 = -1;
-	}
-
-	if (deltax >= deltay) {
-		xinc1 = 0;
-		yinc2 = 0;
-		den = deltax;
-		num = deltax / 2;
-		numadd = deltay;
-		numpixels = deltax;
-	} else {
-		xinc2 = 0;
-		yinc1 = 0;
-		den = deltay;
-		num = deltay / 2;
-		numadd = deltax;
-		numpixels = deltay;
-	}
-
-	for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-		GUI_DRAW_SetPixel(disp, x, y, color);
-		num += numadd;
-		if (num >= den) {
-			num -= den;
-			x += xinc1;
-			y += yinc1;
-		}
-		x += xinc2;
-		y += yinc2;
-	}
+    int32_t du, dv, su, sv, u1, v1, ulo, uhi, vlo, vhi, klo, khi, ilo, ihi, i, k, num, len, pos;
+    uint8_t xmajor;
+    
+    if (x1 == x2 && y1 == y2) {                     /* Single pixel */
+        __DRAW_HSpan(disp, x1, x1, y1, color);
+        return;
+    }
+    
+    /*
+     * Work in major (u) and minor (v) axis. Pixel at step i is on
+     * u = u1 + su * i and v = v1 + sv * k, where k = (du / 2 + i * dv) / du,
+     * which is exactly what classic Bresenham walk produces.
+     */
+    xmajor = __GUI_ABS((int32_t)x2 - (int32_t)x1) >= __GUI_ABS((int32_t)y2 - (int32_t)y1);
+    if (xmajor) {
+        u1 = x1; v1 = y1; du = (int32_t)x2 - x1; dv = (int32_t)y2 - y1;
+        ulo = disp->X1; uhi = (int32_t)disp->X2 - 1; vlo = disp->Y1; vhi = (int32_t)disp->Y2 - 1;
+    } else {
+        u1 = y1; v1 = x1; du = (int32_t)y2 - y1; dv = (int32_t)x2 - x1;
+        ulo = disp->Y1; uhi = (int32_t)disp->Y2 - 1; vlo = disp->X1; vhi = (int32_t)disp->X2 - 1;
+    }
+    su = du >= 0 ? 1 : -1;
+    sv = dv >= 0 ? 1 : -1;
+    du = __GUI_ABS(du);
+    dv = __GUI_ABS(dv);
+    
+    /* Clip steps against major axis */
+    if (su > 0) {
+        ilo = ulo - u1;
+        ihi = uhi - u1;
+    } else {
+        ilo = u1 - uhi;
+        ihi = u1 - ulo;
+    }
+    ilo = __GUI_MAX(ilo, 0);
+    ihi = __GUI_MIN(ihi, du);
+    
+    /* Clip steps against minor axis, k only grows with steps */
+    if (sv > 0) {
+        klo = vlo - v1;
+        khi = vhi - v1;
+    } else {
+        klo = v1 - vhi;
+        khi = v1 - vlo;
+    }
+    if (khi < 0 || (dv == 0 && klo > 0)) {          /* Line is outside clipping region */
+        return;
+    }
+    if (dv) {
+        if (klo > 0) {                              /* First step with k >= klo */
+            ilo = __GUI_MAX(ilo, (int32_t)(((int64_t)klo * du - du / 2 + dv - 1) / dv));
+        }
+        ihi = __GUI_MIN(ihi, (int32_t)(((int64_t)(khi + 1) * du - du / 2 - 1) / dv));   /* Last step with k <= khi */
+    }
+    if (ilo > ihi) {
+        return;
+    }
+    
+    /* Walk runs of pixels with the same minor coordinate, products of 16-bit lengths need 64 bits */
+    k = (int32_t)((du / 2 + (int64_t)ilo * dv) / du);
+    num = (int32_t)((du / 2 + (int64_t)ilo * dv) % du);
+    for (i = ilo; i <= ihi; i += len) {
+        if (dv) {
+            len = (du - num + dv - 1) / dv;         /* Steps until minor coordinate changes */
+            len = __GUI_MIN(len, ihi - i + 1);
+        } else {
+            len = ihi - i + 1;
+        }
+        pos = su > 0 ? u1 + i : u1 - i - len + 1;   /* Lowest major coordinate of run */
+        if (xmajor) {
+            GUI.LL.DrawHLine(&GUI.LCD, GUI.LCD.DrawingLayer, pos, v1 + sv * k, len, color);
+        } else {
+            GUI.LL.DrawVLine(&GUI.LCD, GUI.LCD.DrawingLayer, v1 + sv * k, pos, len, color);
+        }
+        num += len * dv - du;
+        k++;
+    }
 }
 
 void GUI_DRAW_Rectangle(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Color_t color) {
@@ -364,21 +1009,7 @@ void GUI_DRAW_RoundedRectangle(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GU
 }
 
 void GUI_DRAW_FilledRoundedRectangle(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t r, GUI_Color_t color) {
-    if (r >= (height / 2)) {
-        r = height / 2 - 1;
-    }
-    if (r) {
-        GUI_DRAW_FilledRectangle(disp, x + r,         y,     width - 2 * r, height,         color);
-        GUI_DRAW_FilledRectangle(disp, x,             y + r, r,             height - 2 * r, color);
-        GUI_DRAW_FilledRectangle(disp, x + width - r, y + r, r,             height - 2 * r, color);
-        
-        GUI_DRAW_FilledCircleCorner(disp, x + r,             y + r,              r, GUI_DRAW_CIRCLE_TL, color);
-        GUI_DRAW_FilledCircleCorner(disp, x + width - r - 1, y + r,              r, GUI_DRAW_CIRCLE_TR, color);
-        GUI_DRAW_FilledCircleCorner(disp, x + r,             y + height - r - 1, r, GUI_DRAW_CIRCLE_BL, color);
-        GUI_DRAW_FilledCircleCorner(disp, x + width - r - 1, y + height - r - 1, r, GUI_DRAW_CIRCLE_BR, color);
-    } else {
-        GUI_DRAW_FilledRectangle(disp, x, y, width, height, color);
-    }
+    __DRAW_FilledRoundedSpans(disp, x, y, width, height, r, color);
 }
 
 void GUI_DRAW_Circle(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Color_t color) {
@@ -389,18 +1020,22 @@ void GUI_DRAW_Circle(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r,
 }
 
 void GUI_DRAW_FilledCircle(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Color_t color) {
-    GUI_DRAW_FilledCircleCorner(disp, x, y, r, GUI_DRAW_CIRCLE_TL, color);
-    GUI_DRAW_FilledCircleCorner(disp, x - 1, y, r, GUI_DRAW_CIRCLE_TR, color);
-    GUI_DRAW_FilledCircleCorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BL, color);
-    GUI_DRAW_FilledCircleCorner(disp, x - 1, y - 1, r, GUI_DRAW_CIRCLE_BR, color);
+    __DRAW_FilledRoundedSpans(disp, (int32_t)x - r, (int32_t)y - r, 2 * r, 2 * r, r, color);
 }
 
 void GUI_DRAW_Triangle(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1,  GUI_Dim_t x2, GUI_Dim_t y2, GUI_Dim_t x3, GUI_Dim_t y3, GUI_Color_t color) {
-
+    GUI_DRAW_Line(disp, x1, y1, x2, y2, color);
+    GUI_DRAW_Line(disp, x2, y2, x3, y3, color);
+    GUI_DRAW_Line(disp, x3, y3, x1, y1, color);
 }
 
 void GUI_DRAW_FilledTriangle(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2, GUI_Dim_t x3, GUI_Dim_t y3, GUI_Color_t color) {
-
+    GUI_DRAW_Poly_t points[3];
+    
+    points[0].X = x1; points[0].Y = y1;
+    points[1].X = x2; points[1].Y = y2;
+    points[2].X = x3; points[2].Y = y3;
+    __DRAW_FillPolySpans(disp, points, 3, GUI_DRAW_POLY_NONZERO, color);
 }
 
 void GUI_DRAW_CircleCorner(GUI_Display_t* disp, GUI_iDim_t x0, GUI_iDim_t y0, GUI_iDim_t r, GUI_Byte_t c, GUI_Color_t color) {
@@ -496,10 +1131,119 @@ void GUI_DRAW_FilledCircleCorner(GUI_Display_t* disp, GUI_iDim_t x0, GUI_iDim_t
     }
 }
 
-typedef struct GUI_DRAW_Poly_t {
-    GUI_iDim_t X;
-    GUI_iDim_t Y;
-} GUI_DRAW_Poly_t;
+void GUI_DRAW_LineAA(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2, GUI_Color_t color) {
+    GUI_Byte b1[GUI_DRAW_AA_BUFF_SIZE], b2[GUI_DRAW_AA_BUFF_SIZE];
+    int32_t dx, dy, grad, inter, start, end, i, row, xs, n, c;
+    
+    dx = (int32_t)x2 - (int32_t)x1;
+    dy = (int32_t)y2 - (int32_t)y1;
+    if (dx == 0 || dy == 0 || __GUI_ABS(dx) == __GUI_ABS(dy)) {
+        GUI_DRAW_Line(disp, x1, y1, x2, y2, color); /* Line has no partially covered pixels */
+        return;
+    }
+    
+    if (__GUI_ABS(dx) > __GUI_ABS(dy)) {            /* Walk over X, 2 pixels in each column */
+        if (dx < 0) {                               /* Always go from left to right */
+            dx = -dx;
+            dy = -dy;
+            x1 = x2;
+            y1 = y2;
+        }
+        grad = (int32_t)(((int64_t)dy * 65536) / dx); /* Gradient in 16.16 format */
+        start = __GUI_MAX((int32_t)x1, (int32_t)disp->X1);
+        end = __GUI_MIN((int32_t)x1 + dx, (int32_t)disp->X2 - 1);
+        inter = ((int32_t)y1 << 16) + grad * (start - x1);
+        
+        /* Collect pixels of the same row pair and blend them as 2 spans */
+        n = 0;
+        xs = start;
+        row = inter >> 16;
+        for (i = start; i <= end; i++, inter += grad) {
+            if ((inter >> 16) != row || n == GUI_DRAW_AA_BUFF_SIZE) {
+                __DRAW_BlendHSpan(disp, xs, row, b1, n, color);
+                __DRAW_BlendHSpan(disp, xs, row + 1, b2, n, color);
+                n = 0;
+                xs = i;
+                row = inter >> 16;
+            }
+            c = (inter >> 8) & 0xFF;
+            b1[n] = 0xFF - c;
+            b2[n] = c;
+            n++;
+        }
+        __DRAW_BlendHSpan(disp, xs, row, b1, n, color);
+        __DRAW_BlendHSpan(disp, xs, row + 1, b2, n, color);
+    } else {                                        /* Walk over Y, 2 pixels in each row */
+        if (dy < 0) {                               /* Always go from top to bottom */
+            dx = -dx;
+            dy = -dy;
+            x1 = x2;
+            y1 = y2;
+        }
+        grad = (int32_t)(((int64_t)dx * 65536) / dy); /* Gradient in 16.16 format */
+        start = __GUI_MAX((int32_t)y1, (int32_t)disp->Y1);
+        end = __GUI_MIN((int32_t)y1 + dy, (int32_t)disp->Y2 - 1);
+        inter = ((int32_t)x1 << 16) + grad * (start - y1);
+        
+        for (i = start; i <= end; i++, inter += grad) {
+            c = (inter >> 8) & 0xFF;
+            b1[0] = 0xFF - c;
+            b1[1] = c;
+            __DRAW_BlendHSpan(disp, inter >> 16, i, b1, 2, color);
+        }
+    }
+}
+
+void GUI_DRAW_RoundedRectangleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t r, GUI_Color_t color) {
+    if (r) {
+        __DRAW_RoundedAA(disp, x, y, width, height, r, __AA_MODE_RING, NULL, color);
+    } else {
+        GUI_DRAW_Rectangle(disp, x, y, width, height, color);
+    }
+}
+
+void GUI_DRAW_FilledRoundedRectangleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t r, GUI_Color_t color) {
+    if (r) {
+        __DRAW_RoundedAA(disp, x, y, width, height, r, __AA_MODE_FILL, NULL, color);
+    } else {
+        GUI_DRAW_FilledRectangle(disp, x, y, width, height, color);
+    }
+}
+
+void GUI_DRAW_CircleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Color_t color) {
+    if (r) {
+        __DRAW_RoundedAA(disp, (int32_t)x - r, (int32_t)y - r, 2 * r, 2 * r, r, __AA_MODE_RING, NULL, color);
+    }
+}
+
+void GUI_DRAW_FilledCircleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Color_t color) {
+    if (r) {
+        __DRAW_RoundedAA(disp, (int32_t)x - r, (int32_t)y - r, 2 * r, 2 * r, r, __AA_MODE_FILL, NULL, color);
+    }
+}
+
+void GUI_DRAW_ArcAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_iDim_t startAngle, GUI_iDim_t endAngle, GUI_Color_t color) {
+    __AA_Arc_t arc;
+    int32_t span;
+    
+    span = (int32_t)endAngle - (int32_t)startAngle;
+    if (!r || !span) {
+        return;
+    }
+    if (span >= 360 || span <= -360) {              /* Full circle */
+        GUI_DRAW_CircleAA(disp, x, y, r, color);
+        return;
+    }
+    if (span < 0) {
+        span += 360;
+    }
+    arc.SX = __DRAW_Sin(startAngle + 90);           /* Start direction */
+    arc.SY = __DRAW_Sin(startAngle);
+    arc.EX = __DRAW_Sin(startAngle + span + 90);    /* End direction */
+    arc.EY = __DRAW_Sin(startAngle + span);
+    arc.Large = span > 180;
+    __DRAW_RoundedAA(disp, (int32_t)x - r, (int32_t)y - r, 2 * r, 2 * r, r, __AA_MODE_RING, &arc, color);
+}
 
 void GUI_DRAW_Poly(GUI_Display_t* disp, GUI_DRAW_Poly_t* points, GUI_Byte len, GUI_Color_t color) {
     GUI_iDim_t x = 0, y = 0;
@@ -518,6 +1262,75 @@ void GUI_DRAW_Poly(GUI_Display_t* disp, GUI_DRAW_Poly_t* points, GUI_Byte len, G
     }
 }
 
+void GUI_DRAW_FilledPoly(GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, GUI_Byte len, GUI_Byte rule, GUI_Color_t color) {
+    if (len < 3) {
+        return;
+    }
+    __DRAW_FillPolySpans(disp, points, len, rule, color);
+}
+
+void GUI_DRAW_Image(GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, const GUI_IMAGE_DESC_t* img) {
+    static uint32_t buff[GUI_DRAW_IMAGE_BUFF_SIZE];
+    __DRAW_ImageStream_t s;
+    __DRAW_ImagePos_t pos;
+    int32_t x1, y1, x2, y2, i, j, len;
+    
+    /* Clip image against display */
+    x1 = x > disp->X1 ? x : disp->X1;
+    y1 = y > disp->Y1 ? y : disp->Y1;
+    x2 = (x + img->xSize) < disp->X2 ? (x + img->xSize) : disp->X2;
+    y2 = (y + img->ySize) < disp->Y2 ? (y + img->ySize) : disp->Y2;
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    
+    s.Data = img->Data;
+    s.Count = 0;
+    s.Repeat = 0;
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888:             /* Blend directly from image memory */
+            __DRAW_ImageBlend(x1, y1, x2 - x1, y2 - y1, (const uint32_t *)img->Data + (uint32_t)img->xSize * (y1 - y) + (x1 - x), img->xSize - (x2 - x1));
+            return;
+        case GUI_IMAGE_FORMAT_RGB565:
+            if (GUI.LCD.PixelFormat == GUI_PIXEL_FORMAT_RGB565) {   /* Same format as layer, copy directly from image memory */
+                GUI.LL.Copy(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)((const uint16_t *)img->Data + (uint32_t)img->xSize * (y1 - y) + (x1 - x)),
+                    __DRAW_LayerAddress(x1, y1), x2 - x1, y2 - y1, img->xSize - (x2 - x1), GUI.LCD.Width - (x2 - x1));
+                return;
+            }
+            s.Data += 2 * ((uint32_t)img->xSize * (y1 - y) + (x1 - x));
+            break;
+        case GUI_IMAGE_FORMAT_PAL8:
+            s.Data += (uint32_t)img->xSize * (y1 - y) + (x1 - x);
+            break;
+        case GUI_IMAGE_FORMAT_RLE8:                 /* Decode and drop pixels before first visible one */
+            __DRAW_ImageDecode(&s, img, 0, (int32_t)img->xSize * (y1 - y) + (x1 - x));
+            break;
+        case GUI_IMAGE_FORMAT_JPEG:                 /* Decoder passes image to callback block by block */
+            pos.X = x;
+            pos.Y = y;
+            pos.Clip.X1 = x1 - x;
+            pos.Clip.Y1 = y1 - y;
+            pos.Clip.X2 = x2 - x;
+            pos.Clip.Y2 = y2 - y;
+            GUI_JPEG_Decode(img->Data, img->Size, &pos.Clip, __DRAW_ImageBlock, &pos);
+            return;
+        default:
+            return;
+    }
+    
+    /* Decode visible rows piece by piece to small buffer */
+    for (j = y1; j < y2; j++) {
+        for (i = x1; i < x2; i += len) {
+            len = (x2 - i) < GUI_DRAW_IMAGE_BUFF_SIZE ? (x2 - i) : GUI_DRAW_IMAGE_BUFF_SIZE;
+            __DRAW_ImageDecode(&s, img, buff, len);
+            __DRAW_ImageBlend(i, j, len, 1, buff, 0);
+        }
+        if ((j + 1) < y2) {                         /* Skip invisible part to the next row */
+            __DRAW_ImageDecode(&s, img, 0, img->xSize - (x2 - x1));
+        }
+    }
+}
+
 void GUI_DRAW_WriteText(GUI_Display_t* disp, GUI_Const GUI_FONT_t* font, const char* str, GUI_DRAW_FONT_t* draw) {
     GUI_Dim_t w, x, y;
     const GUI_FONT_CharInfo_t* c;
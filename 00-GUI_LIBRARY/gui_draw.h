@@ -60,6 +60,15 @@ extern "C" {
 #define GUI_DRAW_CIRCLE_BR              0x04/*!< Draw bottom left part of circle */
 #define GUI_DRAW_CIRCLE_BL              0x08/*!< Draw bottom right part of circle */
     
+#define GUI_DRAW_POLY_EVENODD           0x00/*!< Fill polygon with even-odd rule */
+#define GUI_DRAW_POLY_NONZERO           0x01/*!< Fill polygon with non-zero winding rule */
+    
+#define GUI_IMAGE_FORMAT_ARGB8888       0x00/*!< 32-bit pixels in memory format, alpha is opacity */
+#define GUI_IMAGE_FORMAT_RGB565         0x01/*!< 16-bit opaque pixels */
+#define GUI_IMAGE_FORMAT_PAL8           0x02/*!< 8-bit indexes to palette */
+#define GUI_IMAGE_FORMAT_RLE8           0x03/*!< 8-bit indexes to palette, compressed with run-length encoding */
+#define GUI_IMAGE_FORMAT_JPEG           0x04/*!< Baseline JPEG file */
+    
 #define GUI_HALIGN_LEFT                 0x01/*!< Horizontal align is left */ 
 #define GUI_HALIGN_CENTER               0x02/*!< Horizontal align is center */
 #define GUI_HALIGN_RIGHT                0x04/*!< Horizontal align is right */
@@ -92,6 +101,35 @@ typedef struct GUI_DRAW_FONT_t {
     GUI_Color_t Color2;                     /*!< Color 2 */
 } GUI_DRAW_FONT_t;
 
+/**
+ * \brief           Polygon point
+ */
+typedef struct GUI_DRAW_Poly_t {
+    GUI_iDim_t X;                           /*!< Point X coordinate */
+    GUI_iDim_t Y;                           /*!< Point Y coordinate */
+} GUI_DRAW_Poly_t;
+
+/**
+ * \brief           Image description, normally placed in flash memory
+ *
+ * ARGB8888 pixels and palette entries use 0xAARRGGBB memory format where alpha 0xFF is opaque pixel,
+ * same as output of most image converters and different than \ref GUI_Color_t transparency.
+ *
+ * RLE8 data is stream of packets. Each packet starts with control byte:
+ *  - bit 7 set: next index byte is repeated (control & 0x7F) + 1 times
+ *  - bit 7 cleared: (control + 1) index bytes follow
+ *
+ * Packets may continue from one row to another.
+ */
+typedef struct GUI_IMAGE_DESC_t {
+    GUI_Dim_t xSize;                        /*!< Image width in units of pixels */
+    GUI_Dim_t ySize;                        /*!< Image height in units of pixels */
+    GUI_Byte Format;                        /*!< Image format, member of \ref GUI_IMAGE_FORMAT_ARGB8888 and others */
+    GUI_Const GUI_Byte* Data;               /*!< Pointer to pixel data */
+    GUI_Const uint32_t* Palette;            /*!< Pointer to palette for PAL8 and RLE8 formats */
+    uint32_t Size;                          /*!< Data size in units of bytes for JPEG format */
+} GUI_IMAGE_DESC_t;
+
 typedef enum GUI_DRAW_3D_State_t {
     GUI_DRAW_3D_State_Raised = 0x00,        /*!< Raised 3D style */
     GUI_DRAW_3D_State_Lowered = 0x01        /*!< Lowered 3D style */
@@ -122,9 +160,22 @@ void GUI_DRAW_Circle(GUI_Display_t* disp, GUI_Dim_t x0, GUI_Dim_t y0, GUI_Dim_t
 void GUI_DRAW_FilledCircle(GUI_Display_t* disp, GUI_Dim_t x0, GUI_Dim_t y0, GUI_Dim_t r, GUI_Color_t color);
 void GUI_DRAW_Triangle(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1,  GUI_Dim_t x2, GUI_Dim_t y2, GUI_Dim_t x3, GUI_Dim_t y3, GUI_Color_t color);
 void GUI_DRAW_FilledTriangle(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2, GUI_Dim_t x3, GUI_Dim_t y3, GUI_Color_t color);
+void GUI_DRAW_Poly(GUI_Display_t* disp, GUI_DRAW_Poly_t* points, GUI_Byte len, GUI_Color_t color);
+void GUI_DRAW_FilledPoly(GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, GUI_Byte len, GUI_Byte rule, GUI_Color_t color);
 void GUI_DRAW_CircleCorner(GUI_Display_t* disp, GUI_iDim_t x0, GUI_iDim_t y0, GUI_iDim_t r, GUI_Byte_t c, GUI_Color_t color);
 void GUI_DRAW_FilledCircleCorner(GUI_Display_t* disp, GUI_iDim_t x0, GUI_iDim_t y0, GUI_iDim_t r, GUI_Byte_t c, uint32_t color);
 
+//Anti-aliased shapes, arc angles are in degrees, 0 is on the right and they increase in clockwise direction
+void GUI_DRAW_LineAA(GUI_Display_t* disp, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2, GUI_Color_t color);
+void GUI_DRAW_RoundedRectangleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t r, GUI_Color_t color);
+void GUI_DRAW_FilledRoundedRectangleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t r, GUI_Color_t color);
+void GUI_DRAW_CircleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Color_t color);
+void GUI_DRAW_FilledCircleAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Color_t color);
+void GUI_DRAW_ArcAA(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_iDim_t startAngle, GUI_iDim_t endAngle, GUI_Color_t color);
+
+//Images
+void GUI_DRAW_Image(GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, const GUI_IMAGE_DESC_t* img);
+
 //3D shapes
 void GUI_DRAW_Rectangle3D(GUI_Display_t* disp, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_DRAW_3D_State_t state);
 
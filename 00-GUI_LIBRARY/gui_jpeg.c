@@ -0,0 +1,556 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_jpeg.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/**
+ * \brief           Huffman table
+ */
+typedef struct __JPEG_Huff_t {
+    uint16_t Fast[1 << GUI_JPEG_FAST_BITS];         /*!< (length << 8) | symbol for short codes, 0 for longer codes */
+    int32_t MaxCode[17];                            /*!< Biggest code of each length or -1 when there is no such code */
+    int32_t ValOffset[17];                          /*!< Offset from code to symbol index for each length */
+    uint8_t Symbols[256];                           /*!< Symbols in order of codes */
+} __JPEG_Huff_t;
+
+/**
+ * \brief           Image component
+ */
+typedef struct __JPEG_Comp_t {
+    uint8_t Id;                                     /*!< Component identifier */
+    uint8_t H, V;                                   /*!< Horizontal and vertical sampling factors */
+    uint8_t Tq;                                     /*!< Quantization table index */
+    uint8_t Td, Ta;                                 /*!< DC and AC huffman table indexes */
+    int32_t Pred;                                   /*!< DC predictor */
+} __JPEG_Comp_t;
+
+/**
+ * \brief           Software decoder state
+ */
+typedef struct __JPEG_t {
+    const GUI_Byte* Ptr;                            /*!< Pointer to next byte */
+    const GUI_Byte* End;                            /*!< Pointer to end of data */
+    uint32_t Acc;                                   /*!< Bit accumulator, first bit is MSB */
+    int32_t Cnt;                                    /*!< Number of valid bits in accumulator */
+    uint8_t Marker;                                 /*!< Marker found in entropy coded data */
+    
+    GUI_Dim_t Width, Height;                        /*!< Image size */
+    uint8_t CompsCount;                             /*!< Number of components */
+    uint8_t HMax, VMax;                             /*!< Maximal sampling factors */
+    uint16_t Restart;                               /*!< Restart interval in units of MCUs */
+    __JPEG_Comp_t Comps[3];                         /*!< List of components */
+    uint16_t Quant[4][64];                          /*!< Quantization tables in zig-zag order */
+    __JPEG_Huff_t Huff[4];                          /*!< DC tables 0 and 1 followed by AC tables 0 and 1 */
+    
+    int32_t Block[64];                              /*!< Coefficients of current block */
+    uint8_t Planes[3][256];                         /*!< Decoded samples of current MCU for each component */
+    uint32_t Pixels[256];                           /*!< Output pixels of current MCU */
+} __JPEG_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __JPEG_READ16(p)        (((uint32_t)(p)[0] << 8) | (p)[1])
+#define __JPEG_CLAMP(x)         ((x) < 0 ? 0 : ((x) > 255 ? 255 : (x)))
+#define __JPEG_COEF(x)          ((x) < -2047 ? -2047 : ((x) > 2047 ? 2047 : (x)))   /* Range of 8-bit coefficients, keeps IDCT in 32 bits */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Natural order position of coefficient in zig-zag order */
+static const uint8_t __JPEG_ZigZag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Build huffman table from list of code counts for each length and symbols */
+static uint8_t __JPEG_BuildHuff(__JPEG_Huff_t* h, const GUI_Byte* counts, const GUI_Byte* symbols) {
+    int32_t code = 0, k = 0, l, i, f;
+    
+    memset(h->Fast, 0x00, sizeof(h->Fast));
+    for (l = 1; l <= 16; l++) {
+        h->ValOffset[l] = k - code;
+        for (i = 0; i < counts[l - 1]; i++, code++, k++) {
+            if (code >= (1L << l)) {                /* Too many codes for length */
+                return 1;
+            }
+            h->Symbols[k] = symbols[k];
+            if (l <= GUI_JPEG_FAST_BITS) {          /* Fill all table entries starting with this code */
+                for (f = 0; f < (1 << (GUI_JPEG_FAST_BITS - l)); f++) {
+                    h->Fast[(code << (GUI_JPEG_FAST_BITS - l)) + f] = (l << 8) | symbols[k];
+                }
+            }
+        }
+        h->MaxCode[l] = counts[l - 1] ? code - 1 : -1;
+        code <<= 1;
+    }
+    return 0;
+}
+
+/* Fill bit accumulator, markers stop reading and zeros are used instead */
+static void __JPEG_Fill(__JPEG_t* j) {
+    uint32_t b;
+    
+    while (j->Cnt <= 24) {
+        b = 0;
+        if (!j->Marker && j->Ptr < j->End) {
+            b = *j->Ptr;
+            if (b != 0xFF) {
+                j->Ptr++;
+            } else if ((j->Ptr + 1) < j->End && !j->Ptr[1]) {   /* Stuffed zero after 0xFF data byte */
+                j->Ptr += 2;
+            } else {                                /* Marker, leave pointer on it */
+                j->Marker = (j->Ptr + 1) < j->End ? j->Ptr[1] : 0xD9;
+                b = 0;
+            }
+        }
+        j->Acc |= b << (24 - j->Cnt);
+        j->Cnt += 8;
+    }
+}
+
+/* Get signed value of s bits */
+static int32_t __JPEG_Receive(__JPEG_t* j, int32_t s) {
+    int32_t v;
+    
+    if (!s) {
+        return 0;
+    }
+    if (j->Cnt < s) {
+        __JPEG_Fill(j);
+    }
+    v = j->Acc >> (32 - s);
+    j->Acc <<= s;
+    j->Cnt -= s;
+    if (v < (1L << (s - 1))) {                      /* Negative value */
+        v -= (1L << s) - 1;
+    }
+    return v;
+}
+
+/* Decode single huffman symbol, -1 is returned on invalid code */
+static int32_t __JPEG_Decode(__JPEG_t* j, const __JPEG_Huff_t* h) {
+    int32_t l, code;
+    uint32_t c;
+    
+    if (j->Cnt < 16) {
+        __JPEG_Fill(j);
+    }
+    c = h->Fast[j->Acc >> (32 - GUI_JPEG_FAST_BITS)];
+    if (c) {                                        /* Short code found with single lookup */
+        j->Acc <<= c >> 8;
+        j->Cnt -= c >> 8;
+        return c & 0xFF;
+    }
+    for (l = GUI_JPEG_FAST_BITS + 1; l <= 16; l++) {
+        code = j->Acc >> (32 - l);
+        if (code <= h->MaxCode[l]) {
+            j->Acc <<= l;
+            j->Cnt -= l;
+            return h->Symbols[code + h->ValOffset[l]];
+        }
+    }
+    return -1;
+}
+
+/* Decode and dequantize single 8x8 block */
+static uint8_t __JPEG_DecodeBlock(__JPEG_t* j, __JPEG_Comp_t* comp) {
+    const uint16_t* q = j->Quant[comp->Tq];
+    const __JPEG_Huff_t* ac = &j->Huff[2 + comp->Ta];
+    int32_t k, s, rs;
+    
+    memset(j->Block, 0x00, sizeof(j->Block));
+    
+    s = __JPEG_Decode(j, &j->Huff[comp->Td]);       /* Difference of DC coefficient */
+    if (s < 0 || s > 11) {
+        return 1;
+    }
+    comp->Pred += __JPEG_Receive(j, s);
+    comp->Pred = __JPEG_COEF(comp->Pred);
+    rs = comp->Pred * q[0];
+    j->Block[0] = __JPEG_COEF(rs);
+    
+    for (k = 1; k < 64; k++) {                      /* Run-length coded AC coefficients */
+        rs = __JPEG_Decode(j, ac);
+        if (rs < 0) {
+            return 1;
+        }
+        s = rs & 0x0F;
+        if (!s) {
+            if (rs != 0xF0) {                       /* End of block */
+                break;
+            }
+            k += 15;                                /* 16 zeros */
+            continue;
+        }
+        k += rs >> 4;                               /* Skip zeros */
+        if (k > 63 || s > 10) {
+            return 1;
+        }
+        rs = __JPEG_Receive(j, s) * q[k];
+        j->Block[__JPEG_ZigZag[k]] = __JPEG_COEF(rs);
+    }
+    return 0;
+}
+
+/*
+ * Integer inverse DCT of single block with 12-bit fixed point constants
+ *
+ * Columns are processed first, rows with only DC coefficient are common and use short path.
+ * Samples are level shifted and saturated to 8-bit output.
+ */
+#define __JPEG_IDCT_1D(s0, s1, s2, s3, s4, s5, s6, s7)  \
+    p1 = ((s2) + (s6)) * 2217;                      \
+    t2 = p1 + (s6) * -7568;                         \
+    t3 = p1 + (s2) * 3135;                          \
+    t0 = ((s0) + (s4)) * 4096;                      \
+    t1 = ((s0) - (s4)) * 4096;                      \
+    x0 = t0 + t3;                                   \
+    x3 = t0 - t3;                                   \
+    x1 = t1 + t2;                                   \
+    x2 = t1 - t2;                                   \
+    t0 = (s7);                                      \
+    t1 = (s5);                                      \
+    t2 = (s3);                                      \
+    t3 = (s1);                                      \
+    p3 = t0 + t2;                                   \
+    p4 = t1 + t3;                                   \
+    p1 = t0 + t3;                                   \
+    p2 = t1 + t2;                                   \
+    p5 = (p3 + p4) * 4816;                          \
+    t0 *= 1223;                                     \
+    t1 *= 8410;                                     \
+    t2 *= 12586;                                    \
+    t3 *= 6149;                                     \
+    p1 = p5 + p1 * -3686;                           \
+    p2 = p5 + p2 * -10498;                          \
+    p3 *= -8035;                                    \
+    p4 *= -1598;                                    \
+    t3 += p1 + p4;                                  \
+    t2 += p2 + p3;                                  \
+    t1 += p2 + p4;                                  \
+    t0 += p1 + p3;
+
+static void __JPEG_IDCT(int32_t* in, uint8_t* out, int32_t stride) {
+    int32_t t0, t1, t2, t3, p1, p2, p3, p4, p5, x0, x1, x2, x3;
+    int32_t i, *v;
+    
+    for (i = 0, v = in; i < 8; i++, v++) {          /* Columns */
+        if (!v[8] && !v[16] && !v[24] && !v[32] && !v[40] && !v[48] && !v[56]) {
+            v[0] = v[8] = v[16] = v[24] = v[32] = v[40] = v[48] = v[56] = v[0] * 4;
+            continue;
+        }
+        __JPEG_IDCT_1D(v[0], v[8], v[16], v[24], v[32], v[40], v[48], v[56]);
+        x0 += 512; x1 += 512; x2 += 512; x3 += 512;
+        v[0] = (x0 + t3) >> 10;
+        v[56] = (x0 - t3) >> 10;
+        v[8] = (x1 + t2) >> 10;
+        v[48] = (x1 - t2) >> 10;
+        v[16] = (x2 + t1) >> 10;
+        v[40] = (x2 - t1) >> 10;
+        v[24] = (x3 + t0) >> 10;
+        v[32] = (x3 - t0) >> 10;
+    }
+    for (i = 0, v = in; i < 8; i++, v += 8, out += stride) {  /* Rows */
+        __JPEG_IDCT_1D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+        x0 += 65536 + (128 << 17); x1 += 65536 + (128 << 17);
+        x2 += 65536 + (128 << 17); x3 += 65536 + (128 << 17);
+        p1 = (x0 + t3) >> 17; out[0] = __JPEG_CLAMP(p1);
+        p1 = (x0 - t3) >> 17; out[7] = __JPEG_CLAMP(p1);
+        p1 = (x1 + t2) >> 17; out[1] = __JPEG_CLAMP(p1);
+        p1 = (x1 - t2) >> 17; out[6] = __JPEG_CLAMP(p1);
+        p1 = (x2 + t1) >> 17; out[2] = __JPEG_CLAMP(p1);
+        p1 = (x2 - t1) >> 17; out[5] = __JPEG_CLAMP(p1);
+        p1 = (x3 + t0) >> 17; out[3] = __JPEG_CLAMP(p1);
+        p1 = (x3 - t0) >> 17; out[4] = __JPEG_CLAMP(p1);
+    }
+}
+
+/* Parse markers until start of scan, or until frame header when only size is needed */
+static uint8_t __JPEG_ParseHeaders(__JPEG_t* j, const GUI_Byte* data, uint32_t size, uint8_t sizeOnly) {
+    const GUI_Byte *p = data + 2, *end = data + size, *seg, *segEnd;
+    uint32_t len, i, k, total;
+    uint8_t m, frame = 0;
+    __JPEG_Comp_t* c;
+    
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {  /* Start of image marker */
+        return 1;
+    }
+    while ((p + 4) <= end) {
+        if (p[0] != 0xFF) {
+            return 1;
+        }
+        m = p[1];
+        if (m == 0xFF) {                            /* Fill byte before marker */
+            p++;
+            continue;
+        }
+        len = __JPEG_READ16(p + 2);
+        seg = p + 4;
+        segEnd = p + 2 + len;
+        if (len < 2 || segEnd > end) {
+            return 1;
+        }
+        switch (m) {
+            case 0xDB:                              /* Quantization tables */
+                while (seg < segEnd) {
+                    k = seg[0] >> 4;                /* 8- or 16-bit values */
+                    i = seg[0] & 0x03;
+                    if ((seg + 1 + 64 * (k + 1)) > segEnd) {
+                        return 1;
+                    }
+                    for (seg++, len = 0; len < 64; len++, seg += k + 1) {
+                        j->Quant[i][len] = k ? __JPEG_READ16(seg) : seg[0];
+                    }
+                }
+                break;
+            case 0xC4:                              /* Huffman tables */
+                while ((seg + 17) <= segEnd) {
+                    if ((seg[0] >> 4) > 1 || (seg[0] & 0x0F) > 1) {
+                        return 1;
+                    }
+                    for (i = 0, total = 0; i < 16; i++) {
+                        total += seg[1 + i];
+                    }
+                    if (total > 256 || (seg + 17 + total) > segEnd ||
+                        __JPEG_BuildHuff(&j->Huff[(seg[0] >> 4) * 2 + (seg[0] & 0x0F)], seg + 1, seg + 17)) {
+                        return 1;
+                    }
+                    seg += 17 + total;
+                }
+                break;
+            case 0xC0:                              /* Baseline frame */
+            case 0xC1:                              /* Extended sequential frame with huffman coding */
+                if (len < 8 || seg[0] != 8) {       /* Only 8-bit precision */
+                    return 1;
+                }
+                j->Height = __JPEG_READ16(seg + 1);
+                j->Width = __JPEG_READ16(seg + 3);
+                j->CompsCount = seg[5];
+                if (!j->Width || !j->Height || (j->CompsCount != 1 && j->CompsCount != 3) || len < (8 + 3 * j->CompsCount)) {
+                    return 1;
+                }
+                if (sizeOnly) {
+                    return 0;
+                }
+                j->HMax = j->VMax = 1;
+                for (i = 0, seg += 6; i < j->CompsCount; i++, seg += 3) {
+                    c = &j->Comps[i];
+                    c->Id = seg[0];
+                    c->H = j->CompsCount == 1 ? 1 : seg[1] >> 4;    /* Single component is never interleaved */
+                    c->V = j->CompsCount == 1 ? 1 : seg[1] & 0x0F;
+                    c->Tq = seg[2] & 0x03;
+                    if (c->H < 1 || c->H > 2 || c->V < 1 || c->V > 2) {
+                        return 1;
+                    }
+                    j->HMax = c->H > j->HMax ? c->H : j->HMax;
+                    j->VMax = c->V > j->VMax ? c->V : j->VMax;
+                }
+                frame = 1;
+                break;
+            case 0xDD:                              /* Restart interval */
+                j->Restart = __JPEG_READ16(seg);
+                break;
+            case 0xDA:                              /* Start of scan */
+                if (!frame || seg[0] != j->CompsCount || len < (6 + 2 * j->CompsCount)) {   /* Only single interleaved scan */
+                    return 1;
+                }
+                for (i = 0, seg++; i < j->CompsCount; i++, seg += 2) {
+                    for (k = 0; k < j->CompsCount && j->Comps[k].Id != seg[0]; k++);
+                    if (k == j->CompsCount || (seg[1] >> 4) > 1 || (seg[1] & 0x0F) > 1) {
+                        return 1;
+                    }
+                    j->Comps[k].Td = seg[1] >> 4;
+                    j->Comps[k].Ta = seg[1] & 0x0F;
+                }
+                j->Ptr = segEnd;                    /* Entropy coded data follows */
+                j->End = end;
+                return 0;
+            default:
+                if ((m >= 0xC2 && m <= 0xCF && m != 0xC4 && m != 0xCC) || m == 0xD9) {   /* Progressive, lossless, arithmetic or no scan */
+                    return 1;
+                }
+                break;                              /* Application data, comments and others are ignored */
+        }
+        p = segEnd;
+    }
+    return 1;
+}
+
+/* Continue after restart marker, bits before marker are discarded */
+static void __JPEG_Restart(__JPEG_t* j) {
+    uint8_t i;
+    
+    while ((j->Ptr + 1) < j->End && !(j->Ptr[0] == 0xFF && j->Ptr[1] >= 0xD0 && j->Ptr[1] <= 0xD7)) {
+        j->Ptr++;
+    }
+    j->Ptr += 2;
+    j->Acc = 0;
+    j->Cnt = 0;
+    j->Marker = 0;
+    for (i = 0; i < j->CompsCount; i++) {
+        j->Comps[i].Pred = 0;
+    }
+}
+
+/* Convert decoded samples of MCU to ARGB8888 pixels, chroma is upsampled by sample repeat */
+static void __JPEG_Convert(__JPEG_t* j, GUI_Dim_t width, GUI_Dim_t height) {
+    const uint8_t *y, *cb, *cr;
+    uint32_t* out = j->Pixels;
+    int32_t px, py, Y, Cb, Cr, r, g, b;
+    uint8_t ys = 8 * j->Comps[0].H, cs = 8 * j->Comps[1].H;
+    uint8_t yh = j->HMax - j->Comps[0].H, yv = j->VMax - j->Comps[0].V;     /* Shifts for subsampled components */
+    uint8_t ch = j->HMax - j->Comps[1].H, cv = j->VMax - j->Comps[1].V;
+    
+    if (j->CompsCount == 1) {
+        for (py = 0, y = j->Planes[0]; py < height; py++, y += 8) {
+            for (px = 0; px < width; px++) {
+                *out++ = 0xFF000000UL | (y[px] * 0x00010101UL);
+            }
+        }
+        return;
+    }
+    for (py = 0; py < height; py++) {
+        y = &j->Planes[0][(py >> yv) * ys];
+        cb = &j->Planes[1][(py >> cv) * cs];
+        cr = &j->Planes[2][(py >> cv) * cs];
+        for (px = 0; px < width; px++) {
+            Y = (y[px >> yh] << 16) + 32768;
+            Cb = cb[px >> ch] - 128;
+            Cr = cr[px >> ch] - 128;
+            r = (Y + Cr * 91881) >> 16;
+            g = (Y - Cb * 22553 - Cr * 46802) >> 16;
+            b = (Y + Cb * 116130) >> 16;
+            *out++ = 0xFF000000UL | (__JPEG_CLAMP(r) << 16) | (__JPEG_CLAMP(g) << 8) | __JPEG_CLAMP(b);
+        }
+    }
+}
+
+/* Decode all MCUs, those outside clipping region are entropy decoded only */
+static uint8_t __JPEG_DecodeScan(__JPEG_t* j, const GUI_Display_t* clip, GUI_JPEG_Callback_t cb, void* param) {
+    GUI_Dim_t mcuW = 8 * j->HMax, mcuH = 8 * j->VMax, x, y, w, h;
+    uint32_t count = 0;
+    uint8_t i, bx, by, visible;
+    __JPEG_Comp_t* c;
+    
+    for (y = 0; y < j->Height; y += mcuH) {
+        if (clip && y >= clip->Y2) {                /* Nothing visible anymore */
+            break;
+        }
+        for (x = 0; x < j->Width; x += mcuW) {
+            if (j->Restart && count == j->Restart) {
+                __JPEG_Restart(j);
+                count = 0;
+            }
+            count++;
+            
+            visible = !clip || (x < clip->X2 && (x + mcuW) > clip->X1 && (y + mcuH) > clip->Y1);
+            for (i = 0; i < j->CompsCount; i++) {
+                c = &j->Comps[i];
+                for (by = 0; by < c->V; by++) {
+                    for (bx = 0; bx < c->H; bx++) {
+                        if (__JPEG_DecodeBlock(j, c)) {
+                            return 1;
+                        }
+                        if (visible) {
+                            __JPEG_IDCT(j->Block, &j->Planes[i][by * 64 * c->H + bx * 8], 8 * c->H);
+                        }
+                    }
+                }
+            }
+            if (visible) {
+                w = (j->Width - x) < mcuW ? (j->Width - x) : mcuW;
+                h = (j->Height - y) < mcuH ? (j->Height - y) : mcuH;
+                __JPEG_Convert(j, w, h);
+                cb(param, x, y, w, h, j->Pixels, 0);
+            }
+        }
+    }
+    return 0;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get image size from frame header, returns 1 on success */
+uint8_t GUI_JPEG_GetSize(const GUI_Byte* data, uint32_t size, GUI_Dim_t* width, GUI_Dim_t* height) {
+    __JPEG_t* j;
+    uint8_t res;
+    
+    __GUI_ASSERTPARAMS(data && width && height);    /* Check parameters */
+    
+    j = __GUI_MEMALLOC(sizeof(*j));                 /* Header parser uses same state as decoder */
+    if (!j) {
+        return 0;
+    }
+    memset(j, 0x00, sizeof(*j));
+    res = __JPEG_ParseHeaders(j, data, size, 1);
+    *width = j->Width;
+    *height = j->Height;
+    __GUI_MEMFREE(j);
+    return !res;
+}
+
+/* Decode image block by block, clipping region is relative to image and can be NULL; returns 1 on success */
+uint8_t GUI_JPEG_Decode(const GUI_Byte* data, uint32_t size, const GUI_Display_t* clip, GUI_JPEG_Callback_t cb, void* param) {
+    __JPEG_t* j;
+    uint8_t res;
+    
+    __GUI_ASSERTPARAMS(data && cb);                 /* Check parameters */
+    
+    if (GUI.LL.DecodeJPEG && !GUI.LL.DecodeJPEG(&GUI.LCD, data, size, clip, cb, param)) {    /* Hardware decoder has priority */
+        return 1;
+    }
+    
+    j = __GUI_MEMALLOC(sizeof(*j));
+    if (!j) {
+        return 0;
+    }
+    memset(j, 0x00, sizeof(*j));
+    res = __JPEG_ParseHeaders(j, data, size, 0);
+    if (!res) {
+        res = __JPEG_DecodeScan(j, clip, cb, param);
+    }
+    __GUI_MEMFREE(j);
+    return !res;
+}
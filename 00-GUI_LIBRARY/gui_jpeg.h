@@ -0,0 +1,98 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI JPEG image decoder
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_JPEG_H
+#define GUI_JPEG_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_JPEG
+ * \brief         Streaming JPEG decoder
+ *
+ * Image is decoded MCU by MCU (up to 16x16 pixels) and each block is passed to callback
+ * as ARGB8888 pixels, so no memory for whole image is required.
+ *
+ * When low-level driver sets \ref GUI_LL_t DecodeJPEG, hardware decoder is used first.
+ * Software decoder supports baseline huffman images with 8-bit precision,
+ * grayscale or YCbCr with 4:4:4, 4:2:2 and 4:2:0 subsampling and restart markers.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_JPEG_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+#define GUI_JPEG_FAST_BITS          8       /*!< Huffman codes up to this length are decoded with single table lookup */
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_JPEG_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+uint8_t GUI_JPEG_GetSize(const GUI_Byte* data, uint32_t size, GUI_Dim_t* width, GUI_Dim_t* height);
+uint8_t GUI_JPEG_Decode(const GUI_Byte* data, uint32_t size, const GUI_Display_t* clip, GUI_JPEG_Callback_t cb, void* param);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -24,6 +24,8 @@
  * |----------------------------------------------------------------------
  */
 #include "gui_ll.h"
+#include "gui_ll_sw.h"
+#include "gui_surface.h"
 
 #include "tm_stm32_sdram.h"
 
@@ -41,7 +43,33 @@
 /* Set pixel settings */
 #define LCD_WIDTH               480
 #define LCD_HEIGHT              272
+#define LCD_PIXEL_FORMAT        GUI_PIXEL_FORMAT_ARGB8888
+
+/* Pixel format dependant settings, L8 can not be DMA2D output so CPU routines are used */
+#if LCD_PIXEL_FORMAT == GUI_PIXEL_FORMAT_ARGB8888
 #define LCD_PIXEL_SIZE          4
+#define LCD_COLOR_MODE          LTDC_PIXEL_FORMAT_ARGB8888
+#define LCD_DMA2D_COLOR(c)      (0xFF000000UL | (c))
+#define LCD_USE_DMA2D           1
+#elif LCD_PIXEL_FORMAT == GUI_PIXEL_FORMAT_RGB565
+#define LCD_PIXEL_SIZE          2
+#define LCD_COLOR_MODE          LTDC_PIXEL_FORMAT_RGB565
+#define LCD_DMA2D_COLOR(c)      ((((c) >> 8) & 0xF800) | (((c) >> 5) & 0x07E0) | (((c) >> 3) & 0x001F))
+#define LCD_USE_DMA2D           1
+#elif LCD_PIXEL_FORMAT == GUI_PIXEL_FORMAT_L8
+#define LCD_PIXEL_SIZE          1
+#define LCD_COLOR_MODE          LTDC_PIXEL_FORMAT_L8
+#define LCD_USE_DMA2D           0
+#else
+#error "Unsupported LCD pixel format"
+#endif
+
+/* Hardware JPEG codec exists on STM32F76x and STM32F77x only, other devices use software decoder */
+#if defined(JPEG) && defined(HAL_JPEG_MODULE_ENABLED)
+#define LCD_USE_JPEG            1
+#else
+#define LCD_USE_JPEG            0
+#endif
 
 /* LCD configuration */
 #define LCD_HSYNC               41
@@ -69,6 +97,22 @@
 static LTDC_HandleTypeDef LTDCHandle;
 static DMA2D_HandleTypeDef DMA2DHandle;
 static GUI_Layer_t Layers[GUI_LAYERS];
+static GUI_LL_t SW;                                 /* CPU routines for selected pixel format */
+
+#if LCD_USE_JPEG
+static JPEG_HandleTypeDef JPEGHandle;
+static uint32_t JPEG_MCU[384 / 4];                  /* Single MCU from decoder, YCbCr 4:2:0 is the biggest */
+static uint32_t JPEG_Pixels[16 * 16];               /* Single MCU converted to ARGB8888 */
+static struct {
+    GUI_JPEG_Callback_t Callback;                   /* Callback for decoded blocks */
+    void* Param;                                    /* Callback parameter */
+    GUI_Dim_t Width, Height;                        /* Image size */
+    GUI_Dim_t MCUWidth, MCUHeight;                  /* MCU size */
+    GUI_Dim_t X, Y;                                 /* Position of next MCU */
+    uint32_t CSS;                                   /* DMA2D chroma subsampling mode, 0xFF for grayscale */
+    uint8_t Error;                                  /* Set when image can not be decoded with hardware */
+} JPEGState;
+#endif /* LCD_USE_JPEG */
 
 /******************************************************************************/
 /******************************************************************************/
@@ -106,6 +150,11 @@ void _LCD_InitLCD(void) {
 	/* Enable LTDC and DMA2D clocks */
 	__HAL_RCC_DMA2D_CLK_ENABLE();
 	__HAL_RCC_LTDC_CLK_ENABLE();
+#if LCD_USE_JPEG
+    __HAL_RCC_JPEG_CLK_ENABLE();
+    JPEGHandle.Instance = JPEG;
+    HAL_JPEG_Init(&JPEGHandle);
+#endif /* LCD_USE_JPEG */
 	
     /* Set LTDC instance */
 	LTDCHandle.Instance = LTDC;
@@ -162,11 +211,7 @@ void _LCD_InitLCD(void) {
 	layer_cfg.WindowX1 = LCD_WIDTH;
 	layer_cfg.WindowY0 = 0;
 	layer_cfg.WindowY1 = LCD_HEIGHT; 
-#if LCD_PIXEL_SIZE == 2
-	layer_cfg.PixelFormat = LTDC_PIXEL_FORMAT_RGB565;
-#else
-	layer_cfg.PixelFormat = LTDC_PIXEL_FORMAT_ARGB8888;
-#endif
+	layer_cfg.PixelFormat = LCD_COLOR_MODE;
 	layer_cfg.Alpha0 = 0;
 	layer_cfg.Backcolor.Blue = 0;
 	layer_cfg.Backcolor.Green = 0;
@@ -193,6 +238,18 @@ void _LCD_InitLCD(void) {
     
     HAL_LTDC_SetAlpha(&LTDCHandle, 255, 0);
     HAL_LTDC_SetAlpha(&LTDCHandle, 0, 1);
+    
+#if LCD_PIXEL_FORMAT == GUI_PIXEL_FORMAT_L8
+    {
+        static uint32_t clut[256];
+        uint16_t i;
+        for (i = 0; i < 256; i++) {                 /* Luminance lookup table */
+            clut[i] = i * 0x00010101UL;
+        }
+        HAL_LTDC_ConfigCLUT(&LTDCHandle, clut, 256, 0);
+        HAL_LTDC_EnableCLUT(&LTDCHandle, 0);
+    }
+#endif
 }
 
 void LCD_Init(GUI_LCD_t* LCD) {
@@ -202,27 +259,38 @@ void LCD_Init(GUI_LCD_t* LCD) {
 }
 
 void LCD_SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
-    uint32_t addr = LCD_FRAME_BUFFER + (layer * LCD_FRAME_BUFFER_SIZE) + LCD_PIXEL_SIZE * (LCD_WIDTH * y + x);
-    *(volatile uint32_t *)(addr) = color | 0xFF000000UL;
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish before CPU access */
+    SW.SetPixel(LCD, layer, x, y, color);
 }
 
 GUI_Color_t LCD_GetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y) {
-    return *(volatile GUI_Color_t *)(LCD_FRAME_BUFFER + (layer * LCD_FRAME_BUFFER_SIZE) + LCD_PIXEL_SIZE * (LCD_WIDTH * y + x));
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish before CPU access */
+    return SW.GetPixel(LCD, layer, x, y);
 }
 
+/* Blend color over horizontal line, each pixel uses its own coverage value from 0 to 255 */
+void LCD_BlendHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, const GUI_Byte* alpha, GUI_Color_t color) {
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish before CPU access */
+    
+    SW.BlendHLine(LCD, layer, x, y, length, alpha, color);  /* Short spans are faster with CPU */
+}
+
+#if LCD_USE_DMA2D
 void LCD_Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t OffLine, GUI_Color_t color) { 
     while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish */
     
     DMA2D->CR = 0x00030000UL;                       /* Register to memory and TCIE */
-    DMA2D->OCOLR = 0xFF000000UL | color;            /* Color to be used */
+    DMA2D->OCOLR = LCD_DMA2D_COLOR(color);          /* Color to be used */
     DMA2D->OMAR = (uint32_t)dst;                    /* Destination address */
     DMA2D->OOR = OffLine;                           /* Destination line offset */
-    DMA2D->OPFCCR = LTDC_PIXEL_FORMAT_ARGB8888;     /* Defines the number of pixels to be transfered */
+    DMA2D->OPFCCR = LCD_COLOR_MODE;                 /* Defines the number of pixels to be transfered */
     DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize; /* Size configuration of area to be transfered */
 	DMA2D->CR |= DMA2D_CR_START;                    /* Start actual transfer */
 }
 
-void LCD_Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+static void LCD_CopyArea(void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish */
+    
     DMA2D->CR = 0x00000000;             /* Memory to memory transfer mode */
     
 	/* Set up pointers */
@@ -232,7 +300,7 @@ void LCD_Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSi
 	DMA2D->OOR = offLineDst; 
 
 	/* Set up pixel format */  
-	DMA2D->FGPFCCR = LTDC_PIXEL_FORMAT_ARGB8888;
+	DMA2D->FGPFCCR = LCD_COLOR_MODE;
 
 	/* Set up size */
 	DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize; 
@@ -243,8 +311,34 @@ void LCD_Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSi
     while (DMA2D->CR & DMA2D_CR_START);
 }
 
+/*
+ * Copy memory area, areas may overlap when moved vertically
+ *
+ * DMA2D goes from first to last line. When destination is below source in the same memory,
+ * area is copied from bottom in bands which do not overlap their source.
+ */
+void LCD_Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    uint32_t line = LCD_PIXEL_SIZE * (xSize + offLineDst), band, y;
+    
+    if ((uint32_t)dst > (uint32_t)src && offLineSrc == offLineDst && (uint32_t)dst < (uint32_t)src + line * ySize) {
+        band = ((uint32_t)dst - (uint32_t)src) / line;  /* Distance in lines */
+        if (!band) {                                /* Same line, go line by line */
+            band = 1;
+        }
+        for (y = ySize; y; ) {
+            if (band > y) {
+                band = y;
+            }
+            y -= band;
+            LCD_CopyArea((void *)((uint32_t)src + line * y), (void *)((uint32_t)dst + line * y), xSize, band, offLineSrc, offLineDst);
+        }
+    } else {
+        LCD_CopyArea(src, dst, xSize, ySize, offLineSrc, offLineDst);
+    }
+}
+
 void LCD_DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
-    uint32_t addr = LCD_FRAME_BUFFER + (layer * LCD_FRAME_BUFFER_SIZE) + (LCD_PIXEL_SIZE * (LCD->Width * y + x));
+    uint32_t addr = Layers[layer].StartAddress + (LCD_PIXEL_SIZE * (LCD->Width * y + x));
     
     LCD_Fill(LCD, layer, (void *)addr, length, 1, LCD->Width - length, color);
 }
@@ -261,6 +355,148 @@ void LCD_FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_D
     LCD_Fill(LCD, layer, (void *)addr, xSize, ySize, LCD->Width - xSize, color);
 }
 
+/* Fill rectangle with transparent color, DMA2D blends constant color over memory */
+void LCD_FillBlend(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    uint32_t addr = Layers[layer].StartAddress + (LCD_PIXEL_SIZE * (LCD->Width * y + x));
+    
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish */
+    
+    DMA2D->CR = 0x00020000UL;                       /* Memory to memory with blending */
+    
+    /* Foreground is A8 with replaced alpha, memory content is not used at all */
+    DMA2D->FGMAR = addr;
+    DMA2D->FGOR = 0;
+    DMA2D->FGCOLR = color & 0x00FFFFFFUL;           /* Foreground color */
+    DMA2D->FGPFCCR = ((0xFFUL - (color >> 24)) << 24) | (0x01UL << 16) | 0x09UL;    /* Opacity, replace alpha mode, A8 */
+    
+    /* Background and output are the same memory */
+    DMA2D->BGMAR = addr;
+    DMA2D->BGOR = LCD->Width - xSize;
+    DMA2D->BGPFCCR = LCD_COLOR_MODE;
+    DMA2D->OMAR = addr;
+    DMA2D->OOR = LCD->Width - xSize;
+    DMA2D->OPFCCR = LCD_COLOR_MODE;
+    
+    DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize; /* Size configuration of area to be transfered */
+    DMA2D->CR |= DMA2D_CR_START;                    /* Start actual transfer */
+}
+
+/* Blend ARGB8888 memory over destination memory with global alpha */
+void LCD_CopyBlend(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst, GUI_Byte alpha) {
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish */
+    
+    DMA2D->CR = 0x00020000UL;                       /* Memory to memory with blending */
+    
+    DMA2D->FGMAR = (uint32_t)src;
+    DMA2D->FGOR = offLineSrc;
+    DMA2D->FGPFCCR = ((uint32_t)alpha << 24) | (0x02UL << 16) | LTDC_PIXEL_FORMAT_ARGB8888;  /* Multiply pixel alpha with global alpha */
+    
+    DMA2D->BGMAR = (uint32_t)dst;
+    DMA2D->BGOR = offLineDst;
+    DMA2D->BGPFCCR = LCD_COLOR_MODE;
+    DMA2D->OMAR = (uint32_t)dst;
+    DMA2D->OOR = offLineDst;
+    DMA2D->OPFCCR = LCD_COLOR_MODE;
+    
+    DMA2D->NLR = (uint32_t)(xSize << 16) | (uint16_t)ySize; /* Size configuration of area to be transfered */
+    DMA2D->CR |= DMA2D_CR_START;                    /* Start actual transfer */
+    
+    while (DMA2D->CR & DMA2D_CR_START);
+}
+#endif /* LCD_USE_DMA2D */
+
+#if LCD_USE_JPEG
+/*
+ * Decode image with JPEG codec, one MCU at a time
+ *
+ * Codec outputs YCbCr blocks which are converted to ARGB8888 with DMA2D in HAL_JPEG_DataReadyCallback.
+ * Returns 0 when image was decoded, otherwise software decoder is used.
+ */
+uint8_t LCD_DecodeJPEG(GUI_LCD_t* LCD, const GUI_Byte* data, uint32_t size, const GUI_Display_t* clip, GUI_JPEG_Callback_t cb, void* param) {
+    memset(&JPEGState, 0x00, sizeof(JPEGState));
+    JPEGState.Callback = cb;
+    JPEGState.Param = param;
+    JPEGState.Error = 1;                            /* Cleared when header is parsed */
+    
+    while (DMA2D->CR & DMA2D_CR_START);             /* Wait previous operation to finish */
+    if (HAL_JPEG_Decode(&JPEGHandle, (uint8_t *)data, size, (uint8_t *)JPEG_MCU, sizeof(JPEG_MCU), 1000) != HAL_OK) {
+        return 1;
+    }
+    return JPEGState.Error;
+}
+
+/* Header is parsed, set output buffer to exactly one MCU */
+void HAL_JPEG_InfoReadyCallback(JPEG_HandleTypeDef* hjpeg, JPEG_ConfTypeDef* pInfo) {
+    uint32_t len;
+    
+    JPEGState.Width = pInfo->ImageWidth;
+    JPEGState.Height = pInfo->ImageHeight;
+    JPEGState.Error = 0;
+    if (pInfo->ColorSpace == JPEG_GRAYSCALE_COLORSPACE) {
+        JPEGState.MCUWidth = JPEGState.MCUHeight = 8;
+        JPEGState.CSS = 0xFF;
+        len = 64;
+    } else if (pInfo->ColorSpace == JPEG_YCBCR_COLORSPACE && pInfo->ChromaSubsampling == JPEG_444_SUBSAMPLING) {
+        JPEGState.MCUWidth = JPEGState.MCUHeight = 8;
+        JPEGState.CSS = 0;
+        len = 192;
+    } else if (pInfo->ColorSpace == JPEG_YCBCR_COLORSPACE && pInfo->ChromaSubsampling == JPEG_422_SUBSAMPLING) {
+        JPEGState.MCUWidth = 16;
+        JPEGState.MCUHeight = 8;
+        JPEGState.CSS = 1;
+        len = 256;
+    } else if (pInfo->ColorSpace == JPEG_YCBCR_COLORSPACE && pInfo->ChromaSubsampling == JPEG_420_SUBSAMPLING) {
+        JPEGState.MCUWidth = JPEGState.MCUHeight = 16;
+        JPEGState.CSS = 2;
+        len = 384;
+    } else {                                        /* Decode is finished but nothing is drawn */
+        JPEGState.Error = 1;
+        len = sizeof(JPEG_MCU);
+    }
+    HAL_JPEG_ConfigOutputBuffer(hjpeg, (uint8_t *)JPEG_MCU, len);
+}
+
+/* All data were given at start */
+void HAL_JPEG_GetDataCallback(JPEG_HandleTypeDef* hjpeg, uint32_t NbDecodedData) {
+    HAL_JPEG_ConfigInputBuffer(hjpeg, hjpeg->pJpegInBuffPtr, 0);
+}
+
+/* Single MCU is decoded, convert it and pass to callback */
+void HAL_JPEG_DataReadyCallback(JPEG_HandleTypeDef* hjpeg, uint8_t* pDataOut, uint32_t OutDataLength) {
+    GUI_Dim_t w, h, i;
+    
+    if (JPEGState.Error || OutDataLength != hjpeg->OutDataLength || JPEGState.Y >= JPEGState.Height) {
+        return;
+    }
+    if (JPEGState.CSS == 0xFF) {                    /* Grayscale is expanded by CPU */
+        for (i = 0; i < 64; i++) {
+            JPEG_Pixels[i] = 0xFF000000UL | (pDataOut[i] * 0x00010101UL);
+        }
+    } else {
+        DMA2D->CR = 0x00010000UL;                   /* Memory to memory with pixel format conversion */
+        DMA2D->FGMAR = (uint32_t)pDataOut;
+        DMA2D->FGOR = 0;
+        DMA2D->FGPFCCR = (JPEGState.CSS << 18) | 0x0BUL;    /* Chroma subsampling, YCbCr blocks */
+        DMA2D->OMAR = (uint32_t)JPEG_Pixels;
+        DMA2D->OOR = 0;
+        DMA2D->OPFCCR = LTDC_PIXEL_FORMAT_ARGB8888;
+        DMA2D->NLR = (uint32_t)(JPEGState.MCUWidth << 16) | (uint16_t)JPEGState.MCUHeight;
+        DMA2D->CR |= DMA2D_CR_START;
+        while (DMA2D->CR & DMA2D_CR_START);
+    }
+    
+    w = (JPEGState.Width - JPEGState.X) < JPEGState.MCUWidth ? (JPEGState.Width - JPEGState.X) : JPEGState.MCUWidth;
+    h = (JPEGState.Height - JPEGState.Y) < JPEGState.MCUHeight ? (JPEGState.Height - JPEGState.Y) : JPEGState.MCUHeight;
+    JPEGState.Callback(JPEGState.Param, JPEGState.X, JPEGState.Y, w, h, JPEG_Pixels, JPEGState.MCUWidth - w);
+    
+    JPEGState.X += JPEGState.MCUWidth;              /* Go to next MCU */
+    if (JPEGState.X >= JPEGState.Width) {
+        JPEGState.X = 0;
+        JPEGState.Y += JPEGState.MCUHeight;
+    }
+}
+#endif /* LCD_USE_JPEG */
+
 /* IRQ function for LTDC */
 void LTDC_IRQHandler(void) {
     HAL_LTDC_IRQHandler(&LTDCHandle);
@@ -293,6 +529,8 @@ uint8_t GUI_LL_Init(GUI_LCD_t* LCD, GUI_LL_t* LL) {
     /*******************************/
     LCD->Width = LCD_WIDTH;
     LCD->Height = LCD_HEIGHT;
+    LCD->PixelFormat = LCD_PIXEL_FORMAT;
+    LCD->PixelSize = LCD_PIXEL_SIZE;
     
     /*******************************/
     /* Set layers count            */
@@ -304,18 +542,36 @@ uint8_t GUI_LL_Init(GUI_LCD_t* LCD, GUI_LL_t* LL) {
         Layers[i].StartAddress = LCD_FRAME_BUFFER + (i * LCD_FRAME_BUFFER_SIZE);
     }
     
+    /*******************************/
+    /* Set memory for surfaces     */
+    /*******************************/
+    GUI_SURFACE_SetArena(LCD_FRAME_BUFFER + (GUI_LAYERS * LCD_FRAME_BUFFER_SIZE), GUI_SURFACE_ARENA_SIZE);  /* Use SDRAM after frame buffers */
+    
     /*******************************/
     /* Set up LCD drawing routines */
     /*******************************/
+    GUI_LL_SW_Init(LCD, &SW);                   /* Get CPU routines for pixel format */
+#if !LCD_USE_DMA2D
+    memcpy(LL, &SW, sizeof(*LL));               /* Use CPU routines when DMA2D can not be used */
+#endif
+    
     LL->Init = &LCD_Init;                       /* Must be set by user */
     LL->GetPixel = &LCD_GetPixel;               /* Must be set by user */
     LL->SetPixel = &LCD_SetPixel;               /* Must be set by user */
+    LL->BlendHLine = &LCD_BlendHLine;           /* Set anti-aliased span routine */
     
+#if LCD_USE_DMA2D
     LL->Copy = &LCD_Copy;                       /* Set copy memory routine */
     LL->DrawHLine = &LCD_DrawHLine;             /* Set drawing vertical line routine */
     LL->DrawVLine = &LCD_DrawVLine;             /* Set drawing horizontal line routine */
     LL->Fill = &LCD_Fill;                       /* Set fill screen routine */
     LL->FillRect = &LCD_FillRect;               /* Set fill rectangle routine */
+    LL->FillBlend = &LCD_FillBlend;             /* Set transparent fill routine */
+    LL->CopyBlend = &LCD_CopyBlend;             /* Set blended copy routine */
+#endif
+#if LCD_USE_JPEG
+    LL->DecodeJPEG = &LCD_DecodeJPEG;           /* Set hardware JPEG decoder */
+#endif
     
     return 0;
 }
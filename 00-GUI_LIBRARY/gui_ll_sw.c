@@ -0,0 +1,243 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_ll_sw.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get address of pixel in layer memory */
+#define __PIXEL_ADDR(type, LCD, layer, x, y)    ((type *)(uintptr_t)((LCD)->Layers[layer].StartAddress) + (uint32_t)(LCD)->Width * (y) + (x))
+
+/*
+ * Generate complete set of low-level routines for single pixel format
+ *
+ * Each format provides <fmt>_FromColor, <fmt>_ToColor and <fmt>_Blend inline functions.
+ * Blend opacity is from 0 to 256. Span loops have no branches inside so compiler
+ * can vectorize them (SSE2 on host, NEON or DSP on target) and no format checks are done per pixel.
+ */
+#define __SW_KERNELS(fmt, type)                                                 \
+static void fmt##_SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {  \
+    *__PIXEL_ADDR(type, LCD, layer, x, y) = fmt##_FromColor(color);             \
+}                                                                               \
+                                                                                \
+static GUI_Color_t fmt##_GetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y) {              \
+    return fmt##_ToColor(*__PIXEL_ADDR(type, LCD, layer, x, y));                \
+}                                                                               \
+                                                                                \
+static void fmt##_Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLine, GUI_Color_t color) {    \
+    type* d = dst;                                                              \
+    type c = fmt##_FromColor(color);                                            \
+    uint32_t i;                                                                 \
+    while (ySize--) {                                                           \
+        for (i = 0; i < xSize; i++) {                                           \
+            d[i] = c;                                                           \
+        }                                                                       \
+        d += xSize + offLine;                                                   \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void fmt##_Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {   \
+    type* s = src;                                                              \
+    type* d = dst;                                                              \
+    int32_t ss = xSize + offLineSrc, ds = xSize + offLineDst;                   \
+    if (d > s && ySize) {   /* Go from bottom when areas overlap */             \
+        s += ss * (ySize - 1);                                                  \
+        d += ds * (ySize - 1);                                                  \
+        ss = -ss;                                                               \
+        ds = -ds;                                                               \
+    }                                                                           \
+    while (ySize--) {                                                           \
+        memmove(d, s, xSize * sizeof(type));                                    \
+        s += ss;                                                                \
+        d += ds;                                                                \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void fmt##_DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {   \
+    fmt##_Fill(LCD, layer, __PIXEL_ADDR(type, LCD, layer, x, y), length, 1, 0, color);  \
+}                                                                               \
+                                                                                \
+static void fmt##_DrawVLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {   \
+    fmt##_Fill(LCD, layer, __PIXEL_ADDR(type, LCD, layer, x, y), 1, length, LCD->Width - 1, color); \
+}                                                                               \
+                                                                                \
+static void fmt##_FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {    \
+    fmt##_Fill(LCD, layer, __PIXEL_ADDR(type, LCD, layer, x, y), xSize, ySize, LCD->Width - xSize, color);  \
+}                                                                               \
+                                                                                \
+static void fmt##_BlendHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, const GUI_Byte* alpha, GUI_Color_t color) {   \
+    type* d = __PIXEL_ADDR(type, LCD, layer, x, y);                             \
+    type c = fmt##_FromColor(color);                                            \
+    uint32_t i;                                                                 \
+    for (i = 0; i < length; i++) {                                              \
+        d[i] = fmt##_Blend(d[i], c, alpha[i] + (alpha[i] >> 7));                \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void fmt##_FillBlend(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {   \
+    type* d = __PIXEL_ADDR(type, LCD, layer, x, y);                             \
+    type c = fmt##_FromColor(color);                                            \
+    uint32_t i, a = 0xFF - (color >> 24);   /* Opacity from transparency */     \
+    a += a >> 7;                                                                \
+    while (ySize--) {                                                           \
+        for (i = 0; i < xSize; i++) {                                           \
+            d[i] = fmt##_Blend(d[i], c, a);                                     \
+        }                                                                       \
+        d += LCD->Width;                                                        \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void fmt##_CopyBlend(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst, GUI_Byte alpha) {    \
+    const uint32_t* s = src;    /* Source is always ARGB8888 */                 \
+    type* d = dst;                                                              \
+    uint32_t i, a, g = alpha + (alpha >> 7);                                    \
+    while (ySize--) {                                                           \
+        for (i = 0; i < xSize; i++) {                                           \
+            a = ((s[i] >> 24) * g) >> 8;                                        \
+            d[i] = fmt##_Blend(d[i], fmt##_FromColor(s[i]), a + (a >> 7));      \
+        }                                                                       \
+        s += xSize + offLineSrc;                                                \
+        d += xSize + offLineDst;                                                \
+    }                                                                           \
+}
+
+/* Set all routines of single pixel format to low-level structure */
+#define __SW_SET_KERNELS(LL, fmt)   do {    \
+    (LL)->SetPixel = fmt##_SetPixel;        \
+    (LL)->GetPixel = fmt##_GetPixel;        \
+    (LL)->Fill = fmt##_Fill;                \
+    (LL)->Copy = fmt##_Copy;                \
+    (LL)->DrawHLine = fmt##_DrawHLine;      \
+    (LL)->DrawVLine = fmt##_DrawVLine;      \
+    (LL)->FillRect = fmt##_FillRect;        \
+    (LL)->BlendHLine = fmt##_BlendHLine;    \
+    (LL)->FillBlend = fmt##_FillBlend;      \
+    (LL)->CopyBlend = fmt##_CopyBlend;      \
+} while (0)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/*
+ * ARGB8888, red and blue channels are blended together in single 32-bit multiply
+ */
+static __inline uint32_t ARGB8888_FromColor(GUI_Color_t color) {
+    return 0xFF000000UL | color;
+}
+
+static __inline GUI_Color_t ARGB8888_ToColor(uint32_t p) {
+    return p & 0x00FFFFFFUL;
+}
+
+static __inline uint32_t ARGB8888_Blend(uint32_t d, uint32_t c, uint32_t a) {
+    return 0xFF000000UL |
+        ((((d & 0x00FF00FFUL) * (256 - a) + (c & 0x00FF00FFUL) * a) >> 8) & 0x00FF00FFUL) |
+        ((((d & 0x0000FF00UL) * (256 - a) + (c & 0x0000FF00UL) * a) >> 8) & 0x0000FF00UL);
+}
+
+/*
+ * RGB565, pixel is spread to 32-bit value as 00000GGGGGG00000RRRRR000000BBBBB
+ * so all channels are blended in single multiply with 5-bit opacity
+ */
+static __inline uint16_t RGB565_FromColor(GUI_Color_t color) {
+    return ((color >> 8) & 0xF800) | ((color >> 5) & 0x07E0) | ((color >> 3) & 0x001F);
+}
+
+static __inline GUI_Color_t RGB565_ToColor(uint16_t p) {
+    return
+        ((uint32_t)(p & 0xF800) << 8) | ((uint32_t)(p & 0xE000) << 3) |
+        ((uint32_t)(p & 0x07E0) << 5) | ((uint32_t)(p & 0x0600) >> 1) |
+        ((uint32_t)(p & 0x001F) << 3) | ((uint32_t)(p & 0x001C) >> 2);
+}
+
+static __inline uint16_t RGB565_Blend(uint16_t d, uint16_t c, uint32_t a) {
+    uint32_t x = (d | ((uint32_t)d << 16)) & 0x07E0F81FUL;
+    uint32_t y = (c | ((uint32_t)c << 16)) & 0x07E0F81FUL;
+    a >>= 3;                                        /* Use 5-bit opacity */
+    x = ((x * (32 - a) + y * a) >> 5) & 0x07E0F81FUL;
+    return (uint16_t)(x | (x >> 16));
+}
+
+/*
+ * L8, single luminance channel
+ */
+static __inline uint8_t L8_FromColor(GUI_Color_t color) {
+    return (((color >> 16) & 0xFF) * 77 + ((color >> 8) & 0xFF) * 150 + (color & 0xFF) * 29) >> 8;
+}
+
+static __inline GUI_Color_t L8_ToColor(uint8_t p) {
+    return (uint32_t)p * 0x00010101UL;
+}
+
+static __inline uint8_t L8_Blend(uint8_t d, uint8_t c, uint32_t a) {
+    return (d * (256 - a) + c * a) >> 8;
+}
+
+__SW_KERNELS(ARGB8888, uint32_t)
+__SW_KERNELS(RGB565, uint16_t)
+__SW_KERNELS(L8, uint8_t)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+/* Set drawing routines for pixel format in LCD structure, returns 0 on success */
+uint8_t GUI_LL_SW_Init(GUI_LCD_t* LCD, GUI_LL_t* LL) {
+    switch (LCD->PixelFormat) {
+        case GUI_PIXEL_FORMAT_ARGB8888:
+            __SW_SET_KERNELS(LL, ARGB8888);
+            LCD->PixelSize = 4;
+            break;
+        case GUI_PIXEL_FORMAT_RGB565:
+            __SW_SET_KERNELS(LL, RGB565);
+            LCD->PixelSize = 2;
+            break;
+        case GUI_PIXEL_FORMAT_L8:
+            __SW_SET_KERNELS(LL, L8);
+            LCD->PixelSize = 1;
+            break;
+        default:
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI software low-level drawing routines for memory framebuffers
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_LL_SW_H
+#define GUI_LL_SW_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_LL_SW
+ * \brief         CPU implementation of low-level routines
+ *
+ * Routines work directly on layer memory, set with \ref GUI_Layer_t StartAddress,
+ * in pixel format set with \ref GUI_LCD_t PixelFormat. Set of routines is generated
+ * for each pixel format at compile time and selected once on initialization.
+ * Low-level drivers without hardware acceleration (or host simulator) can use them in \ref GUI_LL_t structure.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_LL_SW_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+uint8_t GUI_LL_SW_Init(GUI_LCD_t* LCD, GUI_LL_t* LL);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,299 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_prof.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __PROF_NOW()                (Counter ? Counter() : 0)
+
+/* Count low-level call with number of pixels and bytes */
+#define __PROF_LL(type, pixels, bytes)  do {    \
+    Current.LLCalls[type]++;                    \
+    Current.Pixels += (pixels);                 \
+    Current.Bytes += (bytes);                   \
+} while (0)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_PROF_Frame_t Frames[GUI_PROF_FRAMES];    /* Ring of finished frames */
+static uint32_t FramesIn;                   /* Number of finished frames, masked with ring size */
+static GUI_PROF_Frame_t Current;            /* Frame being collected */
+static GUI_PROF_Counter_t Counter;          /* Time measurement function */
+static GUI_LL_t LL;                         /* Original low-level functions */
+static uint32_t ProcessStart, DrawStart;
+static uint8_t Drawn;                       /* Frame was drawn in current process call */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Low-level wrappers, count call and forward it to driver */
+static void __SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_SETPIXEL, 1, 0);
+    LL.SetPixel(LCD, layer, x, y, color);
+}
+
+static GUI_Color_t __GetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y) {
+    __PROF_LL(GUI_PROF_LL_GETPIXEL, 0, 0);
+    return LL.GetPixel(LCD, layer, x, y);
+}
+
+static void __Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLine, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_FILL, (uint32_t)xSize * ySize, 0);
+    LL.Fill(LCD, layer, dst, xSize, ySize, offLine, color);
+}
+
+static void __Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    __PROF_LL(GUI_PROF_LL_COPY, 0, (uint32_t)xSize * ySize * LCD->PixelSize);
+    LL.Copy(LCD, layer, src, dst, xSize, ySize, offLineSrc, offLineDst);
+}
+
+static void __DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_DRAWHLINE, length, 0);
+    LL.DrawHLine(LCD, layer, x, y, length, color);
+}
+
+static void __DrawVLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_DRAWVLINE, length, 0);
+    LL.DrawVLine(LCD, layer, x, y, length, color);
+}
+
+static void __FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_FILLRECT, (uint32_t)xSize * ySize, 0);
+    LL.FillRect(LCD, layer, x, y, xSize, ySize, color);
+}
+
+static void __BlendHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, const GUI_Byte* alpha, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_BLENDHLINE, length, 0);
+    LL.BlendHLine(LCD, layer, x, y, length, alpha, color);
+}
+
+static void __FillBlend(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    __PROF_LL(GUI_PROF_LL_FILLBLEND, (uint32_t)xSize * ySize, 0);
+    LL.FillBlend(LCD, layer, x, y, xSize, ySize, color);
+}
+
+static void __CopyBlend(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst, GUI_Byte alpha) {
+    __PROF_LL(GUI_PROF_LL_COPYBLEND, 0, (uint32_t)xSize * ySize * LCD->PixelSize);
+    LL.CopyBlend(LCD, layer, src, dst, xSize, ySize, offLineSrc, offLineDst, alpha);
+}
+
+static uint8_t __DecodeJPEG(GUI_LCD_t* LCD, const GUI_Byte* data, uint32_t len, const GUI_Display_t* clip, GUI_JPEG_Callback_t cb, void* param) {
+    __PROF_LL(GUI_PROF_LL_DECODEJPEG, 0, 0);
+    return LL.DecodeJPEG(LCD, data, len, clip, cb, param);
+}
+
+/* Get value of metric from frame record */
+static uint32_t __GetMetric(const GUI_PROF_Frame_t* f, GUI_PROF_METRIC_t metric) {
+    uint32_t i, sum = 0;
+    
+    switch (metric) {
+        case GUI_PROF_METRIC_PROCESS:       return f->Process;
+        case GUI_PROF_METRIC_DRAW:          return f->Draw;
+        case GUI_PROF_METRIC_WIDGETS:       return f->Widgets;
+        case GUI_PROF_METRIC_PIXELS:        return f->Pixels;
+        case GUI_PROF_METRIC_BYTES:         return f->Bytes;
+        case GUI_PROF_METRIC_INVALIDATIONS: return f->Invalidations;
+        case GUI_PROF_METRIC_TOUCHES:       return f->Touches;
+        case GUI_PROF_METRIC_LL_CALLS:
+            for (i = 0; i < GUI_PROF_LL_COUNT; i++) {
+                sum += f->LLCalls[i];
+            }
+            return sum;
+        default:
+            return 0;
+    }
+}
+
+/* Sort values and get percentile with nearest rank method */
+static uint32_t __Percentile(uint32_t* values, uint32_t count, uint8_t percent) {
+    uint32_t i, j, v, rank;
+    
+    if (!count) {
+        return 0;
+    }
+    for (i = 1; i < count; i++) {           /* Insertion sort, ring is small */
+        v = values[i];
+        for (j = i; j && values[j - 1] > v; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = v;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+    rank = (percent * count + 99) / 100;    /* Round up */
+    return values[rank ? rank - 1 : 0];
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_PROF_Init(void) {
+    memcpy((void *)&LL, (void *)&GUI.LL, sizeof(GUI_LL_t));    /* Save driver functions and put counters in front of them */
+    
+    if (LL.SetPixel)    { GUI.LL.SetPixel = __SetPixel; }
+    if (LL.GetPixel)    { GUI.LL.GetPixel = __GetPixel; }
+    if (LL.Fill)        { GUI.LL.Fill = __Fill; }
+    if (LL.Copy)        { GUI.LL.Copy = __Copy; }
+    if (LL.DrawHLine)   { GUI.LL.DrawHLine = __DrawHLine; }
+    if (LL.DrawVLine)   { GUI.LL.DrawVLine = __DrawVLine; }
+    if (LL.FillRect)    { GUI.LL.FillRect = __FillRect; }
+    if (LL.BlendHLine)  { GUI.LL.BlendHLine = __BlendHLine; }
+    if (LL.FillBlend)   { GUI.LL.FillBlend = __FillBlend; }
+    if (LL.CopyBlend)   { GUI.LL.CopyBlend = __CopyBlend; }
+    if (LL.DecodeJPEG)  { GUI.LL.DecodeJPEG = __DecodeJPEG; }
+    
+    GUI_PROF_Reset();
+}
+
+void __GUI_PROF_ProcessBegin(void) {
+    ProcessStart = __PROF_NOW();
+    Drawn = 0;
+}
+
+void __GUI_PROF_ProcessEnd(void) {
+    if (!Drawn) {                           /* Counters continue to next frame */
+        return;
+    }
+    Current.Process = __PROF_NOW() - ProcessStart;
+    Current.Time = GUI.Time;
+    memcpy((void *)&Frames[FramesIn % GUI_PROF_FRAMES], (void *)&Current, sizeof(GUI_PROF_Frame_t));
+    FramesIn++;
+    memset((void *)&Current, 0x00, sizeof(GUI_PROF_Frame_t));
+}
+
+void __GUI_PROF_DrawBegin(void) {
+    DrawStart = __PROF_NOW();
+}
+
+void __GUI_PROF_DrawEnd(void) {
+    Current.Draw = __PROF_NOW() - DrawStart;
+    Drawn = 1;
+}
+
+void __GUI_PROF_Invalidate(void) {
+    Current.Invalidations++;
+}
+
+void __GUI_PROF_Touch(void) {
+    Current.Touches++;
+}
+
+uint32_t __GUI_PROF_WidgetBegin(void) {
+    return __PROF_NOW();
+}
+
+void __GUI_PROF_WidgetEnd(GUI_HANDLE_t h, uint32_t start) {
+    uint32_t time = __PROF_NOW() - start;
+    const char* name = h->Widget->MetaData.Name;
+    GUI_PROF_Widget_t* w;
+    uint8_t i;
+    
+    for (i = 0; i < Current.TypesCount; i++) {  /* Names are constant strings, compare pointers only */
+        if (Current.Types[i].Name == name) {
+            break;
+        }
+    }
+    if (i < Current.TypesCount) {           /* Known type in this frame */
+        w = &Current.Types[i];
+    } else if (i < GUI_PROF_WIDGET_TYPES) { /* New type in this frame */
+        w = &Current.Types[i];
+        w->Name = name;
+        Current.TypesCount++;
+    } else {                                /* Table is full, count as other type */
+        w = &Current.Other;
+    }
+    w->Time += time;
+    w->Count++;
+    Current.Widgets++;
+}
+
+void GUI_PROF_SetCounter(GUI_PROF_Counter_t counter) {
+    Counter = counter;
+}
+
+void GUI_PROF_Reset(void) {
+    FramesIn = 0;
+    memset((void *)&Current, 0x00, sizeof(GUI_PROF_Frame_t));
+}
+
+uint32_t GUI_PROF_GetFrameCount(void) {
+    return FramesIn < GUI_PROF_FRAMES ? FramesIn : GUI_PROF_FRAMES;
+}
+
+uint8_t GUI_PROF_GetFrame(uint32_t index, GUI_PROF_Frame_t* frame) {
+    __GUI_ASSERTPARAMS(frame);              /* Check input parameters */
+    
+    if (index >= GUI_PROF_GetFrameCount()) {
+        return 0;
+    }
+    memcpy((void *)frame, (void *)&Frames[(FramesIn - 1 - index) % GUI_PROF_FRAMES], sizeof(GUI_PROF_Frame_t));
+    return 1;
+}
+
+uint32_t GUI_PROF_GetPercentile(GUI_PROF_METRIC_t metric, uint8_t percent) {
+    uint32_t values[GUI_PROF_FRAMES];
+    uint32_t i, count = GUI_PROF_GetFrameCount();
+    
+    for (i = 0; i < count; i++) {
+        values[i] = __GetMetric(&Frames[i], metric);
+    }
+    return __Percentile(values, count, percent);
+}
+
+uint32_t GUI_PROF_GetWidgetPercentile(const char* name, uint8_t percent) {
+    uint32_t values[GUI_PROF_FRAMES];
+    uint32_t i, count = 0, frames = GUI_PROF_GetFrameCount();
+    uint8_t t;
+    
+    __GUI_ASSERTPARAMS(name);               /* Check input parameters */
+    
+    for (i = 0; i < frames; i++) {
+        for (t = 0; t < Frames[i].TypesCount; t++) {
+            if (Frames[i].Types[t].Name && !strcmp(Frames[i].Types[t].Name, name)) {
+                values[count++] = Frames[i].Types[t].Time;
+                break;
+            }
+        }
+    }
+    return __Percentile(values, count, percent);
+}
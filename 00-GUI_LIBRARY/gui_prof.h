@@ -0,0 +1,270 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI frame profiler
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_PROF_H
+#define GUI_PROF_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_PROF
+ * \brief         Frame profiler
+ *
+ * Profiler collects statistics of every drawn frame and stores them to ring of frame records.
+ * Each record contains time spent in \ref GUI_Process and in drawing, time spent in
+ * drawing function of each widget type (by its name), low-level driver calls by type,
+ * number of pixels filled, bytes copied, invalidations and touch events processed.
+ *
+ * Time is measured with counter function set by \ref GUI_PROF_SetCounter,
+ * for example DWT cycle counter on target or clock_gettime on host.
+ *
+ * Profiler is enabled with \ref GUI_PROF_ENABLED in configuration.
+ * When disabled, all hooks are removed at compile time.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_PROF_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+/**
+ * \brief         Enables frame profiler
+ */
+#ifndef GUI_PROF_ENABLED
+#define GUI_PROF_ENABLED            0
+#endif
+
+/**
+ * \brief         Number of frame records kept in ring
+ */
+#ifndef GUI_PROF_FRAMES
+#define GUI_PROF_FRAMES             32
+#endif
+
+/**
+ * \brief         Number of widget types with separate draw time in frame record
+ * \note          When more types are drawn in one frame, time of the rest goes to \ref GUI_PROF_Frame_t.Other
+ */
+#ifndef GUI_PROF_WIDGET_TYPES
+#define GUI_PROF_WIDGET_TYPES       8
+#endif
+
+#if GUI_PROF_ENABLED || defined(__DOXYGEN__)
+#define __GUI_PROF_INIT()                   __GUI_PROF_Init()
+#define __GUI_PROF_PROCESS_BEGIN()          __GUI_PROF_ProcessBegin()
+#define __GUI_PROF_PROCESS_END()            __GUI_PROF_ProcessEnd()
+#define __GUI_PROF_DRAW_BEGIN()             __GUI_PROF_DrawBegin()
+#define __GUI_PROF_DRAW_END()               __GUI_PROF_DrawEnd()
+#define __GUI_PROF_INVALIDATE()             __GUI_PROF_Invalidate()
+#define __GUI_PROF_TOUCH()                  __GUI_PROF_Touch()
+#define __GUI_PROF_WIDGET_DRAW(h, draw)     do {    \
+    uint32_t __start = __GUI_PROF_WidgetBegin();    \
+    draw;                                           \
+    __GUI_PROF_WidgetEnd((h), __start);             \
+} while (0)
+#else
+#define __GUI_PROF_INIT()
+#define __GUI_PROF_PROCESS_BEGIN()
+#define __GUI_PROF_PROCESS_END()
+#define __GUI_PROF_DRAW_BEGIN()
+#define __GUI_PROF_DRAW_END()
+#define __GUI_PROF_INVALIDATE()
+#define __GUI_PROF_TOUCH()
+#define __GUI_PROF_WIDGET_DRAW(h, draw)     draw
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_PROF_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Function returning free running counter value used for time measurement
+ */
+typedef uint32_t (*GUI_PROF_Counter_t)(void);
+
+/**
+ * \brief         Low-level driver function types
+ */
+typedef enum GUI_PROF_LL_t {
+    GUI_PROF_LL_SETPIXEL = 0x00,            /*!< \ref GUI_LL_t.SetPixel */
+    GUI_PROF_LL_GETPIXEL,                   /*!< \ref GUI_LL_t.GetPixel */
+    GUI_PROF_LL_FILL,                       /*!< \ref GUI_LL_t.Fill */
+    GUI_PROF_LL_COPY,                       /*!< \ref GUI_LL_t.Copy */
+    GUI_PROF_LL_DRAWHLINE,                  /*!< \ref GUI_LL_t.DrawHLine */
+    GUI_PROF_LL_DRAWVLINE,                  /*!< \ref GUI_LL_t.DrawVLine */
+    GUI_PROF_LL_FILLRECT,                   /*!< \ref GUI_LL_t.FillRect */
+    GUI_PROF_LL_BLENDHLINE,                 /*!< \ref GUI_LL_t.BlendHLine */
+    GUI_PROF_LL_FILLBLEND,                  /*!< \ref GUI_LL_t.FillBlend */
+    GUI_PROF_LL_COPYBLEND,                  /*!< \ref GUI_LL_t.CopyBlend */
+    GUI_PROF_LL_DECODEJPEG,                 /*!< \ref GUI_LL_t.DecodeJPEG */
+    GUI_PROF_LL_COUNT                       /*!< Number of function types */
+} GUI_PROF_LL_t;
+
+/**
+ * \brief         Frame values available for percentiles
+ */
+typedef enum GUI_PROF_METRIC_t {
+    GUI_PROF_METRIC_PROCESS = 0x00,         /*!< \ref GUI_PROF_Frame_t.Process */
+    GUI_PROF_METRIC_DRAW,                   /*!< \ref GUI_PROF_Frame_t.Draw */
+    GUI_PROF_METRIC_WIDGETS,                /*!< \ref GUI_PROF_Frame_t.Widgets */
+    GUI_PROF_METRIC_LL_CALLS,               /*!< Sum of \ref GUI_PROF_Frame_t.LLCalls */
+    GUI_PROF_METRIC_PIXELS,                 /*!< \ref GUI_PROF_Frame_t.Pixels */
+    GUI_PROF_METRIC_BYTES,                  /*!< \ref GUI_PROF_Frame_t.Bytes */
+    GUI_PROF_METRIC_INVALIDATIONS,          /*!< \ref GUI_PROF_Frame_t.Invalidations */
+    GUI_PROF_METRIC_TOUCHES,                /*!< \ref GUI_PROF_Frame_t.Touches */
+} GUI_PROF_METRIC_t;
+
+/**
+ * \brief         Draw time of single widget type in frame
+ */
+typedef struct GUI_PROF_Widget_t {
+    const char* Name;                       /*!< Widget name from \ref GUI_WIDGET_t meta data, NULL for other types */
+    uint32_t Time;                          /*!< Time spent in drawing function in units of counter */
+    uint16_t Count;                         /*!< Number of drawn widgets */
+} GUI_PROF_Widget_t;
+
+/**
+ * \brief         Statistics of single frame
+ * \note          Invalidations and touches are counted since previous frame
+ */
+typedef struct GUI_PROF_Frame_t {
+    uint32_t Time;                          /*!< GUI time when frame was drawn in units of milliseconds */
+    uint32_t Process;                       /*!< Time of \ref GUI_Process call which drew the frame in units of counter */
+    uint32_t Draw;                          /*!< Time of layer copy and redraw in units of counter */
+    uint32_t Widgets;                       /*!< Number of widget drawing function calls */
+    uint32_t LLCalls[GUI_PROF_LL_COUNT];    /*!< Number of low-level driver calls by type */
+    uint32_t Pixels;                        /*!< Number of pixels filled or drawn */
+    uint32_t Bytes;                         /*!< Number of bytes copied between memories */
+    uint16_t Invalidations;                 /*!< Number of widget invalidations */
+    uint16_t Touches;                       /*!< Number of touch events processed */
+    GUI_PROF_Widget_t Types[GUI_PROF_WIDGET_TYPES]; /*!< Draw time by widget type */
+    uint8_t TypesCount;                     /*!< Number of used entries in \ref GUI_PROF_Frame_t.Types */
+    GUI_PROF_Widget_t Other;                /*!< Draw time of types which did not fit to \ref GUI_PROF_Frame_t.Types */
+} GUI_PROF_Frame_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_PROF_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+/**
+ * \brief         Set function for time measurement
+ * \param[in]     counter: Function returning free running 32-bit counter
+ */
+void GUI_PROF_SetCounter(GUI_PROF_Counter_t counter);
+
+/**
+ * \brief         Clear all frame records
+ */
+void GUI_PROF_Reset(void);
+
+/**
+ * \brief         Get number of frame records available
+ * \retval        Number of records, up to \ref GUI_PROF_FRAMES
+ */
+uint32_t GUI_PROF_GetFrameCount(void);
+
+/**
+ * \brief         Get frame record
+ * \param[in]     index: Record index, 0 is the last drawn frame
+ * \param[out]    frame: Pointer to \ref GUI_PROF_Frame_t structure to fill
+ * \retval        1: Record was copied
+ * \retval        0: There is no record with this index
+ */
+uint8_t GUI_PROF_GetFrame(uint32_t index, GUI_PROF_Frame_t* frame);
+
+/**
+ * \brief         Get percentile of frame value over all records
+ * \param[in]     metric: Value to check
+ * \param[in]     percent: Percentile between 0 and 100, 50 for median, 100 for maximum
+ * \retval        Value at percentile or 0 if there are no records
+ */
+uint32_t GUI_PROF_GetPercentile(GUI_PROF_METRIC_t metric, uint8_t percent);
+
+/**
+ * \brief         Get percentile of draw time for widget type over records where it was drawn
+ * \param[in]     name: Widget name as in \ref GUI_WIDGET_t meta data
+ * \param[in]     percent: Percentile between 0 and 100
+ * \retval        Draw time in units of counter or 0 if widget was not drawn
+ */
+uint32_t GUI_PROF_GetWidgetPercentile(const char* name, uint8_t percent);
+
+void __GUI_PROF_Init(void);
+void __GUI_PROF_ProcessBegin(void);
+void __GUI_PROF_ProcessEnd(void);
+void __GUI_PROF_DrawBegin(void);
+void __GUI_PROF_DrawEnd(void);
+void __GUI_PROF_Invalidate(void);
+void __GUI_PROF_Touch(void);
+uint32_t __GUI_PROF_WidgetBegin(void);
+void __GUI_PROF_WidgetEnd(GUI_HANDLE_t h, uint32_t start);
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,263 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_screen.h"
+#include "gui_widget.h"
+#include "gui_window.h"
+#include "gui_button.h"
+#include "gui_led.h"
+#include "gui_progbar.h"
+#include "gui_surface.h"
+#include "gui_anim.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __SCREEN_HEADER_SIZE        16
+#define __SCREEN_WIDGET_SIZE        18
+#define __SCREEN_COLOR_SIZE         5
+#define __SCREEN_NONE               0xFFFF
+
+#define __SCREEN_ALIGN(x)           (((x) + 7) & ~7UL)  /* Same alignment as widget memory block */
+#define __SCREEN_U16(p)             ((uint16_t)((p)[0] | ((p)[1] << 8)))
+#define __SCREEN_U32(p)             ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/* Number of colors in widget structure */
+#define __SCREEN_COLORS(type)       (sizeof(((type *)0)->Color) / sizeof(GUI_Color_t))
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Memory required for widget of each type */
+static const uint16_t Sizes[GUI_SCREEN_TYPE_COUNT] = {
+    sizeof(GUI_WINDOW_t), sizeof(GUI_BUTTON_t), sizeof(GUI_LED_t), sizeof(GUI_PROGBAR_t)
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Create widget of description type in active window */
+static GUI_HANDLE_t __Create(uint8_t type, GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height) {
+    switch (type) {
+        case GUI_SCREEN_TYPE_WINDOW:    return GUI_WINDOW_CreateChild(id, x, y, width, height);
+        case GUI_SCREEN_TYPE_BUTTON:    return GUI_BUTTON_Create(id, x, y, width, height);
+        case GUI_SCREEN_TYPE_LED:       return GUI_LED_Create(id, x, y, width, height);
+        case GUI_SCREEN_TYPE_PROGBAR:   return GUI_PROGBAR_Create(id, x, y, width, height);
+        default:                        return NULL;
+    }
+}
+
+/* Set color of new widget, no redraw is needed as widget is already invalidated */
+static uint8_t __SetColor(GUI_HANDLE_t h, uint8_t type, uint8_t index, GUI_Color_t color) {
+    switch (type) {
+        case GUI_SCREEN_TYPE_WINDOW:
+            if (index >= __SCREEN_COLORS(GUI_WINDOW_t)) {
+                return 0;
+            }
+            GUI_WINDOW_SetColor(h, (GUI_WINDOW_COLOR_t)index, color);   /* Window color changes opaque flag too */
+            return 1;
+        case GUI_SCREEN_TYPE_BUTTON:
+            if (index >= __SCREEN_COLORS(GUI_BUTTON_t)) {
+                return 0;
+            }
+            ((GUI_BUTTON_t *)h)->Color[index] = color;
+            return 1;
+        case GUI_SCREEN_TYPE_LED:
+            if (index >= __SCREEN_COLORS(GUI_LED_t)) {
+                return 0;
+            }
+            ((GUI_LED_t *)h)->Color[index] = color;
+            return 1;
+        case GUI_SCREEN_TYPE_PROGBAR:
+            if (index >= __SCREEN_COLORS(GUI_PROGBAR_t)) {
+                return 0;
+            }
+            ((GUI_PROGBAR_t *)h)->Color[index] = color;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_SCREEN_t* GUI_SCREEN_Load(const void* data, uint32_t len, GUI_Const GUI_FONT_t* const* fonts, uint8_t fontsCount) {
+    const uint8_t* d = (const uint8_t *)data;
+    const uint8_t* rec;
+    const uint8_t* strings;
+    uint32_t count, stringsLen, head, size, types, i, c;
+    uint16_t parent, text;
+    uint8_t type, font, colors;
+    GUI_SCREEN_t* screen;
+    GUI_HANDLE_t h;
+    
+    __GUI_ASSERTPARAMS(data && len >= __SCREEN_HEADER_SIZE);    /* Check input parameters */
+    
+    if (d[0] != 'G' || d[1] != 'S' || d[2] != 'C' || d[3] != GUI_SCREEN_VERSION) {
+        return NULL;
+    }
+    count = __SCREEN_U16(&d[4]);
+    stringsLen = __SCREEN_U16(&d[6]);
+    if (!count || stringsLen > len - __SCREEN_HEADER_SIZE || (stringsLen && d[len - 1])) {
+        return NULL;
+    }
+    strings = &d[len - stringsLen];
+    
+    /* Memory for all widgets is known from header */
+    head = __SCREEN_ALIGN(sizeof(GUI_SCREEN_t) + (count - 1) * sizeof(GUI_HANDLE_t));
+    size = head;
+    types = 0;
+    for (i = 0; i < GUI_SCREEN_TYPE_COUNT; i++) {
+        c = __SCREEN_U16(&d[8 + 2 * i]);
+        types += c;
+        size += c * __SCREEN_ALIGN(Sizes[i]);
+    }
+    if (types != count) {
+        return NULL;
+    }
+    screen = (GUI_SCREEN_t *)__GUI_MEMALLOC(size);
+    if (!screen) {
+        return NULL;
+    }
+    memset((void *)screen, 0x00, head);
+    screen->Window = GUI.WindowActive;
+    screen->Size = size;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    __GUI_WIDGET_SetMemory((uint8_t *)screen + head, size - head);  /* Create widgets in block */
+    
+    rec = &d[__SCREEN_HEADER_SIZE];
+    for (i = 0; i < count; i++) {
+        if (rec + __SCREEN_WIDGET_SIZE > strings) {
+            break;
+        }
+        type = rec[0];
+        font = rec[1];
+        parent = __SCREEN_U16(&rec[2]);
+        text = __SCREEN_U16(&rec[14]);
+        colors = rec[16];
+        if (rec + __SCREEN_WIDGET_SIZE + colors * __SCREEN_COLOR_SIZE > strings) {
+            break;
+        }
+        
+        /* First widget is screen window in active window, others are inside earlier windows */
+        if (!i) {
+            if (parent != __SCREEN_NONE || type != GUI_SCREEN_TYPE_WINDOW) {
+                break;
+            }
+            GUI.WindowActive = screen->Window;
+        } else {
+            if (parent >= i || !screen->Widgets[parent]->Widget->MetaData.AllowChildren) {
+                break;
+            }
+            GUI.WindowActive = screen->Widgets[parent];
+        }
+        
+        h = __Create(type, (GUI_ID_t)__SCREEN_U16(&rec[4]), (int16_t)__SCREEN_U16(&rec[6]), (int16_t)__SCREEN_U16(&rec[8]), __SCREEN_U16(&rec[10]), __SCREEN_U16(&rec[12]));
+        if (!h) {
+            break;
+        }
+        screen->Widgets[i] = h;
+        screen->Count = i + 1;
+        
+        if (font != 0xFF) {
+            if (!fonts || font >= fontsCount) {
+                break;
+            }
+            h->Font = fonts[font];
+        }
+        if (text != __SCREEN_NONE) {
+            if (text >= stringsLen) {
+                break;
+            }
+            h->Text = (char *)&strings[text];       /* Text stays in description */
+        }
+        for (c = 0; c < colors; c++) {
+            if (!__SetColor(h, type, rec[__SCREEN_WIDGET_SIZE + c * __SCREEN_COLOR_SIZE], __SCREEN_U32(&rec[__SCREEN_WIDGET_SIZE + c * __SCREEN_COLOR_SIZE + 1]))) {
+                break;
+            }
+        }
+        if (c < colors) {
+            break;
+        }
+        rec += __SCREEN_WIDGET_SIZE + colors * __SCREEN_COLOR_SIZE;
+    }
+    
+    __GUI_WIDGET_SetMemory(NULL, 0);                /* Back to normal allocation */
+    GUI.WindowActive = screen->Window;              /* Loading does not change active window */
+    __GUI_LEAVE();                                  /* Leave GUI */
+    
+    if (i < count || rec != strings) {              /* Invalid description, remove what was created */
+        GUI_SCREEN_Unload(&screen);
+        return NULL;
+    }
+    return screen;
+}
+
+void GUI_SCREEN_Unload(GUI_SCREEN_t** screen) {
+    GUI_SCREEN_t* s;
+    GUI_HANDLE_t h;
+    
+    __GUI_ASSERTPARAMSVOID(screen && *screen);      /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    s = *screen;
+    if (s->Count) {                                 /* Remove screen window with all children, also widgets created after load */
+        h = s->Widgets[0];
+        __GUI_WIDGET_Remove(&h);
+    }
+    
+    __GUI_MEMFREE(s);                               /* Single free for all widgets */
+    *screen = NULL;
+    __GUI_LEAVE();                                  /* Leave GUI */
+}
+
+GUI_HANDLE_t GUI_SCREEN_GetWidget(GUI_SCREEN_t* screen, GUI_ID_t id) {
+    uint32_t i;
+    
+    __GUI_ASSERTPARAMS(screen);                     /* Check input parameters */
+    
+    for (i = 0; i < screen->Count; i++) {
+        if (screen->Widgets[i]->Id == id) {
+            return screen->Widgets[i];
+        }
+    }
+    return NULL;
+}
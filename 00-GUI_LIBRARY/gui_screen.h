@@ -0,0 +1,185 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI screens loaded from binary description
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_SCREEN_H
+#define GUI_SCREEN_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_SCREEN
+ * \brief         Screens loaded from binary description
+ *
+ * Screen description contains complete widget tree with geometry, fonts, colors and texts.
+ * It is made from JSON file on host with tools/gui_screenc.py and is usually placed in flash as constant array.
+ *
+ * Loader creates all widgets in one pass. Memory for all widgets is taken from single allocation
+ * with size calculated from description header, unload releases it with single free.
+ *
+ * Texts are not copied, description must stay in memory while screen is loaded.
+ *
+ * \par Binary format
+ *
+ * All values are little endian.
+ *
+\verbatim
+Header, 16 bytes
+  0   char[3]   "GSC"
+  3   uint8     Version, GUI_SCREEN_VERSION
+  4   uint16    Number of widgets
+  6   uint16    Size of string table in bytes
+  8   uint16[4] Number of widgets by type, window, button, led, progress bar
+
+Widget, 18 bytes + 5 bytes per color, in creation order
+  0   uint8     Type, GUI_SCREEN_TYPE_t
+  1   uint8     Font index in table passed to loader, 0xFF for default
+  2   uint16    Parent widget index, must be window before this widget, 0xFFFF for first widget only
+  4   uint16    Widget ID
+  6   int16     X position relative to parent
+  8   int16     Y position relative to parent
+  10  uint16    Width
+  12  uint16    Height
+  14  uint16    Text offset in string table, 0xFFFF for no text
+  16  uint8     Number of colors
+  17  uint8     Reserved
+  18  Colors, uint8 color index followed by uint32 color
+
+String table, zero terminated strings
+\endverbatim
+ *
+ * Colors are stored as \ref GUI_Color_t values. Top byte is transparency, not alpha,
+ * 0x00 is opaque and 0xFF is fully transparent, as \ref GUI_COLOR_TRANSPARENT.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_SCREEN_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+#define GUI_SCREEN_VERSION          1       /*!< Supported version of binary description */
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_SCREEN_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Widget types in screen description
+ */
+typedef enum GUI_SCREEN_TYPE_t {
+    GUI_SCREEN_TYPE_WINDOW = 0x00,          /*!< Child window, other widgets are placed inside */
+    GUI_SCREEN_TYPE_BUTTON,                 /*!< Button */
+    GUI_SCREEN_TYPE_LED,                    /*!< LED */
+    GUI_SCREEN_TYPE_PROGBAR,                /*!< Progress bar */
+    GUI_SCREEN_TYPE_COUNT                   /*!< Number of types */
+} GUI_SCREEN_TYPE_t;
+
+/**
+ * \brief         Loaded screen, placed at the beginning of widgets memory block
+ */
+typedef struct GUI_SCREEN_t {
+    GUI_HANDLE_t Window;                    /*!< Window which was active before load */
+    uint32_t Size;                          /*!< Size of memory block in units of bytes */
+    uint16_t Count;                         /*!< Number of widgets */
+    GUI_HANDLE_t Widgets[1];                /*!< Widgets in creation order, first one is screen window */
+} GUI_SCREEN_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_SCREEN_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+/**
+ * \brief         Create all widgets from screen description
+ * \note          First widget is created in active window, active window is not changed
+ * \param[in]     data: Pointer to binary screen description
+ * \param[in]     len: Length of description in units of bytes
+ * \param[in]     fonts: Table of fonts used by font index in description
+ * \param[in]     fontsCount: Number of fonts in table
+ * \retval        Pointer to loaded screen or NULL on invalid description or no memory, \ref GUI_STORE_SIZE limits number of widgets too
+ */
+GUI_SCREEN_t* GUI_SCREEN_Load(const void* data, uint32_t len, GUI_Const GUI_FONT_t* const* fonts, uint8_t fontsCount);
+
+/**
+ * \brief         Remove all widgets of screen and release its memory
+ * \note          Widgets created inside screen windows after load are removed too
+ * \param[in,out] screen: Pointer to screen pointer, set to NULL after unload
+ */
+void GUI_SCREEN_Unload(GUI_SCREEN_t** screen);
+
+/**
+ * \brief         Get widget of screen by ID
+ * \param[in]     screen: Pointer to loaded screen
+ * \param[in]     id: Widget ID from description
+ * \retval        Widget handle or NULL if not found
+ */
+GUI_HANDLE_t GUI_SCREEN_GetWidget(GUI_SCREEN_t* screen, GUI_ID_t id);
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_store.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __SetBit(set, index)        ((set)[(index) >> 5] |= 1UL << ((index) & 0x1F))
+#define __ClearBit(set, index)      ((set)[(index) >> 5] &= ~(1UL << ((index) & 0x1F)))
+#define __IsBit(set, index)         (((set)[(index) >> 5] >> ((index) & 0x1F)) & 1UL)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_STORE_t GUI_Store;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_STORE_Init(void) {
+    memset((void *)&GUI_Store, 0x00, sizeof(GUI_Store));
+    GUI_Store.Free = GUI_STORE_NONE;                /* No free entries below used ones */
+}
+
+uint8_t __GUI_STORE_Add(GUI_HANDLE_t h) {
+    uint16_t i;
+    
+    if (GUI_Store.Free != GUI_STORE_NONE) {         /* Reuse free entry first */
+        i = GUI_Store.Free;
+        GUI_Store.Free = GUI_Store.Parent[i];
+    } else if (GUI_Store.Used < GUI_STORE_SIZE) {
+        i = GUI_Store.Used++;
+    } else {
+        return 0;
+    }
+    
+    h->Index = i;
+    GUI_Store.Handle[i] = h;
+    GUI_Store.Parent[i] = h->Parent ? h->Parent->Index : GUI_STORE_NONE;
+    __ClearBit(GUI_Store.Dirty, i);                 /* Removed entries have no redraw state, clear for sure */
+    __ClearBit(GUI_Store.Subtree, i);
+    if (!h->Parent || ((GUI_Store.Flags[h->Parent->Index] & GUI_STORE_FLAG_CHILDREN) && __IsBit(GUI_Store.Drawn, h->Parent->Index))) {
+        __SetBit(GUI_Store.Drawn, i);
+    } else {
+        __ClearBit(GUI_Store.Drawn, i);
+    }
+    GUI_Store.Flags[i] = 0;
+    __GUI_STORE_UpdateFlags(h);
+    __GUI_STORE_UpdateRect(h);
+    if (h->Parent) {
+        GUI_Store.Flags[h->Parent->Index] |= GUI_STORE_FLAG_LIST;  /* Parent has linked list with children now */
+    }
+    return 1;
+}
+
+void __GUI_STORE_Remove(GUI_HANDLE_t h) {
+    GUI_HANDLE_t c;
+    
+    if (h->Index == GUI_STORE_NONE) {
+        return;
+    }
+    if (GUI_Store.Flags[h->Index] & GUI_STORE_FLAG_LIST) {  /* Children can't exist without parent, rows of scroll view too */
+        for (c = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)h, 0); c; c = __GUI_LINKEDLIST_GetNextWidget(NULL, c)) {
+            __GUI_STORE_Remove(c);
+        }
+    }
+    
+    __GUI_STORE_ClearDirty(h);                      /* Removed widget is never drawn */
+    GUI_Store.Handle[h->Index] = NULL;
+    GUI_Store.Parent[h->Index] = GUI_Store.Free;    /* Add to list of free entries */
+    GUI_Store.Free = h->Index;
+    h->Index = GUI_STORE_NONE;
+}
+
+void __GUI_STORE_UpdateRect(GUI_HANDLE_t h) {
+    GUI_Display_t* r;
+    GUI_HANDLE_t c;
+    
+    if (h->Index == GUI_STORE_NONE) {               /* Widget was already removed */
+        return;
+    }
+    r = &GUI_Store.Rect[h->Index];
+    if (h->Parent) {                                /* Position is relative to parent */
+        r->X1 = GUI_Store.Rect[h->Parent->Index].X1 + h->X;
+        r->Y1 = GUI_Store.Rect[h->Parent->Index].Y1 + h->Y;
+    } else {
+        r->X1 = h->X;
+        r->Y1 = h->Y;
+    }
+    r->X2 = r->X1 + h->Width;
+    r->Y2 = r->Y1 + h->Height;
+    
+    if (GUI_Store.Flags[h->Index] & GUI_STORE_FLAG_CHILDREN) {  /* Children moved together with widget */
+        for (c = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)h, 0); c; c = __GUI_LINKEDLIST_GetNextWidget(NULL, c)) {
+            __GUI_STORE_UpdateRect(c);
+        }
+    }
+}
+
+void __GUI_STORE_UpdateFlags(GUI_HANDLE_t h) {
+    uint8_t f;
+    
+    if (h->Index == GUI_STORE_NONE) {
+        return;
+    }
+    f = GUI_Store.Flags[h->Index] & GUI_STORE_FLAG_LIST;    /* Keep flags not copied from widget */
+    
+    if (h->Widget->MetaData.AllowChildren) {
+        f |= GUI_STORE_FLAG_CHILDREN;
+    }
+    if (h->Flags & GUI_FLAG_OPAQUE) {
+        f |= GUI_STORE_FLAG_OPAQUE;
+    }
+    if (h->Flags & GUI_FLAG_CACHE) {
+        f |= GUI_STORE_FLAG_CACHE;
+    }
+    GUI_Store.Flags[h->Index] = f;
+}
+
+void __GUI_STORE_SetDirty(GUI_HANDLE_t h) {
+    uint16_t i = h->Index;
+    
+    if (i == GUI_STORE_NONE || __IsBit(GUI_Store.Dirty, i)) {   /* Removed or already counted */
+        return;
+    }
+    __SetBit(GUI_Store.Dirty, i);
+    if (__IsBit(GUI_Store.Drawn, i)) {
+        GUI_Store.Pending++;
+        for (i = GUI_Store.Parent[i]; i != GUI_STORE_NONE; i = GUI_Store.Parent[i]) {
+            __SetBit(GUI_Store.Subtree, i);         /* Mark path from top level widget */
+        }
+    }
+}
+
+void __GUI_STORE_SetChildDirty(GUI_HANDLE_t h) {
+    if (h->Index == GUI_STORE_NONE || __IsBit(GUI_Store.Dirty, h->Index)) {
+        return;
+    }
+    __SetBit(GUI_Store.Dirty, h->Index);
+    if (__IsBit(GUI_Store.Drawn, h->Index)) {
+        GUI_Store.Pending++;
+    }
+}
+
+void __GUI_STORE_ClearDirty(GUI_HANDLE_t h) {
+    if (h->Index == GUI_STORE_NONE || !__IsBit(GUI_Store.Dirty, h->Index)) {
+        return;
+    }
+    __ClearBit(GUI_Store.Dirty, h->Index);
+    if (__IsBit(GUI_Store.Drawn, h->Index)) {
+        GUI_Store.Pending--;
+    }
+}
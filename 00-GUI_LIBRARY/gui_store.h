@@ -0,0 +1,227 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI widget state store
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_STORE_H
+#define GUI_STORE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_STORE
+ * \brief         Widget state store
+ *
+ * Values checked for every widget on each frame are kept in arrays indexed by widget store index,
+ * instead of being read through widget handles spread over heap:
+ *
+ *  - Redraw state as bitset with number of widgets waiting for redraw, check for pending redraw is one compare
+ *  - Subtree state as bitset, widget is marked when any of its children waits for redraw.
+ *    Redraw goes only to marked parts of widget tree, unchanged parts are skipped.
+ *  - Absolute widget rectangle on screen, position is not calculated through all parents
+ *  - Parent index, used to check if redraw is pending inside part of widget tree
+ *  - Flags used when looking for widgets which hide other widgets
+ *
+ * Children of widgets without children support (rows of scroll view) are drawn by their parent.
+ * Their redraw state is kept but it is not counted as pending redraw.
+ *
+ * Store index is assigned on widget creation and saved to handle, widget handles stay as they are.
+ * Library must update store when widget position, size or listed flags change.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_STORE_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+/**
+ * \brief         Maximal number of widgets existing at the same time
+ * \note          Widget creation fails when store is full, rows of scroll views are counted too.
+ *                Each widget takes 16 bytes of store memory.
+ */
+#ifndef GUI_STORE_SIZE
+#define GUI_STORE_SIZE              512
+#endif
+
+#define GUI_STORE_NONE              0xFFFF  /*!< Invalid store index */
+
+#define GUI_STORE_FLAG_CHILDREN     0x01    /*!< Widget allows children widgets */
+#define GUI_STORE_FLAG_OPAQUE       0x02    /*!< Copy of \ref GUI_FLAG_OPAQUE */
+#define GUI_STORE_FLAG_CACHE        0x04    /*!< Copy of \ref GUI_FLAG_CACHE */
+#define GUI_STORE_FLAG_LIST         0x08    /*!< Widget has children in its linked list, rows of scroll view too */
+
+#if GUI_STORE_SIZE >= GUI_STORE_NONE
+#error "GUI_STORE_SIZE must be smaller than 0xFFFF"
+#endif
+
+/**
+ * \brief         Check redraw state of widget
+ */
+#define __GUI_STORE_IsDirty(h)      ((GUI_Store.Dirty[(h)->Index >> 5] >> ((h)->Index & 0x1F)) & 1UL)
+
+/**
+ * \brief         Check if any child of widget, on any level, may wait for redraw
+ * \note          State is cleared only when redraw goes through widget, it can be set when nothing waits anymore
+ */
+#define __GUI_STORE_IsSubtreeDirty(h)       ((GUI_Store.Subtree[(h)->Index >> 5] >> ((h)->Index & 0x1F)) & 1UL)
+
+/**
+ * \brief         Clear subtree state of widget when redraw goes through its children
+ */
+#define __GUI_STORE_ClearSubtreeDirty(h)    (GUI_Store.Subtree[(h)->Index >> 5] &= ~(1UL << ((h)->Index & 0x1F)))
+
+/**
+ * \brief         Check if any widget waits for redraw
+ */
+#define __GUI_STORE_IsPending()     (GUI_Store.Pending != 0)
+
+/**
+ * \brief         Get absolute rectangle of widget on screen
+ */
+#define __GUI_STORE_GetRect(h)      (&GUI_Store.Rect[(h)->Index])
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_STORE_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Widget state arrays
+ */
+typedef struct GUI_STORE_t {
+    uint32_t Dirty[(GUI_STORE_SIZE + 31) / 32]; /*!< Redraw state of widgets, one bit per widget */
+    uint32_t Subtree[(GUI_STORE_SIZE + 31) / 32];   /*!< Widgets with children waiting for redraw */
+    uint32_t Drawn[(GUI_STORE_SIZE + 31) / 32]; /*!< Widgets drawn by library and not by their parent widget */
+    GUI_Display_t Rect[GUI_STORE_SIZE];     /*!< Absolute widget rectangles */
+    uint16_t Parent[GUI_STORE_SIZE];        /*!< Parent index, next free index for free entries */
+    uint8_t Flags[GUI_STORE_SIZE];          /*!< Widget flags, GUI_STORE_FLAG_x values */
+    GUI_HANDLE_t Handle[GUI_STORE_SIZE];    /*!< Widget handles, NULL for free entries */
+    uint16_t Used;                          /*!< Number of entries from start which were ever used */
+    uint16_t Free;                          /*!< First free entry below Used */
+    uint16_t Pending;                       /*!< Number of widgets drawn by library waiting for redraw */
+} GUI_STORE_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_STORE_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+extern GUI_STORE_t GUI_Store;
+
+/**
+ * \brief         Reset store, called before any widget is created
+ */
+void __GUI_STORE_Init(void);
+
+/**
+ * \brief         Add widget to store and set its index
+ * \note          Parent, position, size and flags must be already set
+ * \param[in,out] h: Widget handle
+ * \retval        1 on success, 0 when store is full
+ */
+uint8_t __GUI_STORE_Add(GUI_HANDLE_t h);
+
+/**
+ * \brief         Remove widget and all its children from store
+ * \note          Index of removed widget is set to \ref GUI_STORE_NONE, functions to update store ignore such widget
+ * \param[in]     h: Widget handle
+ */
+void __GUI_STORE_Remove(GUI_HANDLE_t h);
+
+/**
+ * \brief         Calculate absolute rectangle of widget and its children after position or size change
+ * \param[in]     h: Widget handle
+ */
+void __GUI_STORE_UpdateRect(GUI_HANDLE_t h);
+
+/**
+ * \brief         Copy flags of widget to store after change
+ * \param[in]     h: Widget handle
+ */
+void __GUI_STORE_UpdateFlags(GUI_HANDLE_t h);
+
+/**
+ * \brief         Set redraw state of widget and mark its parents up to top level widget
+ * \param[in]     h: Widget handle
+ */
+void __GUI_STORE_SetDirty(GUI_HANDLE_t h);
+
+/**
+ * \brief         Set redraw state of widget while redraw goes through its parent
+ * \note          Parents are not marked, they are drawn at the moment
+ * \param[in]     h: Widget handle
+ */
+void __GUI_STORE_SetChildDirty(GUI_HANDLE_t h);
+
+/**
+ * \brief         Clear redraw state of widget
+ * \param[in]     h: Widget handle
+ */
+void __GUI_STORE_ClearDirty(GUI_HANDLE_t h);
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
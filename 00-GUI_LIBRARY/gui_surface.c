@@ -0,0 +1,286 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_surface.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/**
+ * \brief           Memory arena for surfaces
+ */
+typedef struct __SURFACE_Arena_t {
+    uint32_t Start;                                 /*!< Start address of arena */
+    uint32_t End;                                   /*!< First address after arena */
+    uint32_t Counter;                               /*!< Use counter for least recently used eviction */
+} __SURFACE_Arena_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __SURFACE_ALIGN             32              /* Align surfaces to cache line size */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_SURFACE_t Surfaces[GUI_SURFACE_MAX_COUNT];
+static __SURFACE_Arena_t Arena;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get surface entry for widget */
+static GUI_SURFACE_t* __SURFACE_Find(GUI_HANDLE_t h) {
+    uint8_t i;
+    for (i = 0; i < GUI_SURFACE_MAX_COUNT; i++) {
+        if (Surfaces[i].Owner == h) {
+            return &Surfaces[i];
+        }
+    }
+    return 0;
+}
+
+/* Release arena memory of surface */
+static void __SURFACE_Free(GUI_SURFACE_t* s) {
+    s->Address = 0;
+    s->MemSize = 0;
+    s->Valid = 0;                                   /* Content must be drawn again */
+}
+
+/* Find first free block of memory in arena, returns 0 if there is no space */
+static uint32_t __SURFACE_FindGap(uint32_t size) {
+    uint32_t addr = Arena.Start;
+    uint8_t i, moved;
+    
+    do {
+        moved = 0;
+        for (i = 0; i < GUI_SURFACE_MAX_COUNT; i++) {
+            GUI_SURFACE_t* t = &Surfaces[i];
+            if (t->Address && addr < (t->Address + t->MemSize) && t->Address < (addr + size)) {
+                addr = t->Address + t->MemSize;     /* Try right after overlapping block */
+                moved = 1;
+            }
+        }
+    } while (moved);
+    
+    if (size > (Arena.End - Arena.Start) || addr > (Arena.End - size)) {
+        return 0;
+    }
+    return addr;
+}
+
+/* Allocate memory for surface, evict least recently used surfaces when arena is full */
+static uint8_t __SURFACE_Alloc(GUI_SURFACE_t* s) {
+    uint32_t size, addr;
+    uint8_t i;
+    
+    size = (uint32_t)GUI.LCD.PixelSize * s->Width * s->Height;
+    size = (size + __SURFACE_ALIGN - 1) & ~(uint32_t)(__SURFACE_ALIGN - 1);
+    if (!size || !Arena.Start) {
+        return 0;
+    }
+    
+    while (!(addr = __SURFACE_FindGap(size))) {
+        GUI_SURFACE_t* victim = 0;
+        for (i = 0; i < GUI_SURFACE_MAX_COUNT; i++) {
+            GUI_SURFACE_t* t = &Surfaces[i];
+            if (t != s && t->Address && !t->InUse && (!victim || t->LastUsed < victim->LastUsed)) {
+                victim = t;
+            }
+        }
+        if (!victim) {                              /* Nothing left to evict */
+            return 0;
+        }
+        __SURFACE_Free(victim);
+    }
+    
+    s->Address = addr;
+    s->MemSize = size;
+    s->Valid = 0;                                   /* Memory content is undefined */
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint8_t GUI_SURFACE_SetArena(uint32_t address, uint32_t size) {
+    uint32_t start;
+    uint8_t i;
+    
+    start = (address + __SURFACE_ALIGN - 1) & ~(uint32_t)(__SURFACE_ALIGN - 1);
+    for (i = 0; i < GUI_SURFACE_MAX_COUNT; i++) {
+        __SURFACE_Free(&Surfaces[i]);               /* Old memory is not valid anymore */
+    }
+    if (!size || size <= (start - address)) {       /* Disable surfaces */
+        Arena.Start = Arena.End = 0;
+        return 0;
+    }
+    Arena.Start = start;
+    Arena.End = address + size;
+    return 1;
+}
+
+GUI_HANDLE_t GUI_SURFACE_EnableCache(GUI_HANDLE_t h) {
+    GUI_SURFACE_t* s;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check input parameters */
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    if (!(h->Flags & GUI_FLAG_CACHE)) {
+        s = __SURFACE_Find(0);                      /* Find free entry */
+        if (s) {
+            memset((void *)s, 0x00, sizeof(*s));
+            s->Owner = h;
+            h->Flags |= GUI_FLAG_CACHE;             /* Draw widget through surface from now on */
+            __GUI_STORE_UpdateFlags(h);
+        }
+    }
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+GUI_HANDLE_t GUI_SURFACE_DisableCache(GUI_HANDLE_t h) {
+    GUI_SURFACE_t* s;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check input parameters */
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    if (h->Flags & GUI_FLAG_CACHE) {
+        s = __SURFACE_Find(h);
+        if (s) {
+            __SURFACE_Free(s);                      /* Give memory back to arena */
+            s->Owner = 0;                           /* Entry is free */
+        }
+        h->Flags &= ~GUI_FLAG_CACHE;
+        __GUI_STORE_UpdateFlags(h);
+    }
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+/* Get surface with allocated memory for widget, returns NULL when widget must be drawn without cache */
+GUI_SURFACE_t* __GUI_SURFACE_Get(GUI_HANDLE_t h) {
+    GUI_SURFACE_t* s;
+    
+    s = __SURFACE_Find(h);
+    if (!s) {
+        return 0;
+    }
+    if (s->Address && (s->Width != h->Width || s->Height != h->Height)) {
+        __SURFACE_Free(s);                          /* Widget size changed */
+    }
+    if (!s->Address) {
+        s->Width = h->Width;
+        s->Height = h->Height;
+        if (!__SURFACE_Alloc(s)) {
+            return 0;
+        }
+    }
+    s->LastUsed = ++Arena.Counter;                  /* Mark as recently used */
+    return s;
+}
+
+/* Mark surface content as invalid, widget and all its children will be drawn again */
+void __GUI_SURFACE_Invalidate(GUI_HANDLE_t h) {
+    GUI_SURFACE_t* s = __SURFACE_Find(h);
+    if (s) {
+        s->Valid = 0;
+    }
+}
+
+/*
+ * Redirect all drawings to surface placed at absolute position x and y
+ *
+ * Drawing layer start address is moved so that absolute screen coordinates inside
+ * surface area point to surface memory and line width is set to surface width.
+ * Widgets are drawn with their normal coordinates and no drawing routine needs to know about surface.
+ * Clipping region is limited to surface, complete surface is used when content is not valid.
+ */
+void __GUI_SURFACE_Begin(GUI_SURFACE_t* s, GUI_Dim_t x, GUI_Dim_t y) {
+    GUI_Layer_t* layer = &GUI.LCD.Layers[GUI.LCD.DrawingLayer];
+    
+    s->LayerAddress = layer->StartAddress;          /* Save current drawing target */
+    s->LayerWidth = GUI.LCD.Width;
+    memcpy((void *)&s->Display, (void *)&GUI.Display, sizeof(GUI_Display_t));
+    s->InUse = 1;
+    
+    layer->StartAddress = s->Address - GUI.LCD.PixelSize * ((uint32_t)s->Width * y + x);
+    GUI.LCD.Width = s->Width;
+    
+    if (s->Valid) {                                 /* Update only changed part */
+        GUI.Display.X1 = GUI.Display.X1 > x ? GUI.Display.X1 : x;
+        GUI.Display.Y1 = GUI.Display.Y1 > y ? GUI.Display.Y1 : y;
+        GUI.Display.X2 = GUI.Display.X2 < (x + s->Width) ? GUI.Display.X2 : (x + s->Width);
+        GUI.Display.Y2 = GUI.Display.Y2 < (y + s->Height) ? GUI.Display.Y2 : (y + s->Height);
+        if (GUI.Display.X2 < GUI.Display.X1) {
+            GUI.Display.X2 = GUI.Display.X1;
+        }
+        if (GUI.Display.Y2 < GUI.Display.Y1) {
+            GUI.Display.Y2 = GUI.Display.Y1;
+        }
+    } else {
+        GUI.Display.X1 = x;
+        GUI.Display.Y1 = y;
+        GUI.Display.X2 = x + s->Width;
+        GUI.Display.Y2 = y + s->Height;
+    }
+}
+
+/* Restore drawing target after drawing to surface */
+void __GUI_SURFACE_End(GUI_SURFACE_t* s) {
+    GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress = s->LayerAddress;
+    GUI.LCD.Width = s->LayerWidth;
+    memcpy((void *)&GUI.Display, (void *)&s->Display, sizeof(GUI_Display_t));
+    s->InUse = 0;
+    s->Valid = 1;                                   /* Surface now matches widget */
+}
+
+/* Copy part of surface inside clipping region to drawing layer */
+void __GUI_SURFACE_Blit(GUI_SURFACE_t* s, GUI_Dim_t x, GUI_Dim_t y) {
+    GUI_Dim_t x1, y1, x2, y2;
+    uint32_t src, dst;
+    
+    x1 = GUI.Display.X1 > x ? GUI.Display.X1 : x;
+    y1 = GUI.Display.Y1 > y ? GUI.Display.Y1 : y;
+    x2 = GUI.Display.X2 < (x + s->Width) ? GUI.Display.X2 : (x + s->Width);
+    y2 = GUI.Display.Y2 < (y + s->Height) ? GUI.Display.Y2 : (y + s->Height);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    
+    src = s->Address + GUI.LCD.PixelSize * ((uint32_t)s->Width * (y1 - y) + (x1 - x));
+    dst = GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress + GUI.LCD.PixelSize * ((uint32_t)GUI.LCD.Width * y1 + x1);
+    GUI.LL.Copy(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)(uintptr_t)src, (void *)(uintptr_t)dst, x2 - x1, y2 - y1, s->Width - (x2 - x1), GUI.LCD.Width - (x2 - x1));
+}
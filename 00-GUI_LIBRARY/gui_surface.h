@@ -0,0 +1,148 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI off-screen surfaces for cached widget drawing
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_SURFACE_H
+#define GUI_SURFACE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_SURFACE
+ * \brief         Off-screen surfaces for cached widgets
+ *
+ * Widget with enabled cache is drawn together with all its children to its own surface.
+ * When nothing inside widget has changed, redraw of widget is single copy from surface to layer.
+ *
+ * Surface memory is taken from arena set by low-level driver with \ref GUI_SURFACE_SetArena.
+ * When arena is full, least recently used surfaces are evicted and rendered again on next use.
+ * If surface can not be allocated at all, widget is drawn directly to layer as without cache.
+ *
+ * \note          Cached widget must cover its complete area with opaque drawing
+ *                and children are clipped to widget area
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_SURFACE_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+/**
+ * \brief         Maximal number of widgets with cache enabled at the same time
+ */
+#ifndef GUI_SURFACE_MAX_COUNT
+#define GUI_SURFACE_MAX_COUNT       8
+#endif
+
+/**
+ * \brief         Size of memory for surfaces in units of bytes, set to 0 to disable surfaces
+ */
+#ifndef GUI_SURFACE_ARENA_SIZE
+#define GUI_SURFACE_ARENA_SIZE      0
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_SURFACE_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Off-screen surface for single widget
+ */
+typedef struct GUI_SURFACE_t {
+    GUI_HANDLE_t Owner;                     /*!< Widget drawn to this surface, NULL if entry is free */
+    uint32_t Address;                       /*!< Start address of pixels in arena, 0 when memory is not allocated */
+    uint32_t MemSize;                       /*!< Number of bytes reserved in arena */
+    GUI_Dim_t Width;                        /*!< Surface width in units of pixels */
+    GUI_Dim_t Height;                       /*!< Surface height in units of pixels */
+    uint32_t LastUsed;                      /*!< Use counter value when surface was last used, for eviction */
+    uint8_t Valid;                          /*!< Surface content matches widget */
+    uint8_t InUse;                          /*!< Drawing to surface is in progress, surface can not be evicted */
+    
+    uint32_t LayerAddress;                  /*!< Saved drawing layer start address while drawing to surface */
+    GUI_Dim_t LayerWidth;                   /*!< Saved LCD width while drawing to surface */
+    GUI_Display_t Display;                  /*!< Saved clipping region while drawing to surface */
+} GUI_SURFACE_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_SURFACE_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+uint8_t GUI_SURFACE_SetArena(uint32_t address, uint32_t size);
+GUI_HANDLE_t GUI_SURFACE_EnableCache(GUI_HANDLE_t h);
+GUI_HANDLE_t GUI_SURFACE_DisableCache(GUI_HANDLE_t h);
+
+GUI_SURFACE_t* __GUI_SURFACE_Get(GUI_HANDLE_t h);
+void __GUI_SURFACE_Invalidate(GUI_HANDLE_t h);
+void __GUI_SURFACE_Begin(GUI_SURFACE_t* s, GUI_Dim_t x, GUI_Dim_t y);
+void __GUI_SURFACE_End(GUI_SURFACE_t* s);
+void __GUI_SURFACE_Blit(GUI_SURFACE_t* s, GUI_Dim_t x, GUI_Dim_t y);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,308 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_trace.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+/* Event counter access, exporter can run in another thread */
+#if defined(__GNUC__)
+#define __TRACE_LoadAcquire(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define __TRACE_StoreRelease(ptr, value)    __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define __TRACE_Claim(ptr)                  __atomic_fetch_add((ptr), 1, __ATOMIC_RELAXED)
+#else
+#define __TRACE_LoadAcquire(ptr)            (*(ptr))
+#define __TRACE_StoreRelease(ptr, value)    do { __dmb(0xF); *(ptr) = (value); } while (0)
+#define __TRACE_Claim(ptr)                  ((*(ptr))++)    /* Single thread only */
+#endif
+
+/* Count low-level call and forward it to driver */
+#define __TRACE_LL(name, arg, call)     do {        \
+    GUI_TRACE_BEGIN(GUI_TRACE_CAT_LL, name, arg);   \
+    call;                                           \
+    GUI_TRACE_END(GUI_TRACE_CAT_LL, name);          \
+} while (0)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_TRACE_Buffer_t Buffers[GUI_TRACE_THREADS];
+static volatile uint32_t BuffersUsed;       /* Number of buffers given to threads */
+static GUI_TRACE_THREAD_LOCAL GUI_TRACE_Buffer_t* Buffer;   /* Buffer of current thread */
+static GUI_TRACE_THREAD_LOCAL uint8_t NoBuffer; /* All buffers were used when thread started */
+static GUI_TRACE_Counter_t Counter;
+static uint32_t Frequency = 1000000;
+static volatile uint8_t Recording;
+static uint8_t Waiting;                     /* Layer swap was waiting for confirmation at the end of last process call */
+static GUI_LL_t LL;                         /* Original low-level functions */
+
+static const char* Args[] = {"value", "id", "size", "layer", "value"};
+static const char* Cats[] = {"gui", "widget", "ll", "layer", "user"};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get buffer of current thread */
+static GUI_TRACE_Buffer_t* __GetBuffer(void) {
+    uint32_t i;
+    
+    if (!Buffer && !NoBuffer) {             /* First event of this thread */
+        i = __TRACE_Claim(&BuffersUsed);
+        if (i < GUI_TRACE_THREADS) {
+            Buffer = &Buffers[i];
+        } else {
+            NoBuffer = 1;
+        }
+    }
+    return Buffer;
+}
+
+/* Low-level wrappers */
+static void __SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    __TRACE_LL("SetPixel", 1, LL.SetPixel(LCD, layer, x, y, color));
+}
+
+static void __Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLine, GUI_Color_t color) {
+    __TRACE_LL("Fill", (uint32_t)xSize * ySize, LL.Fill(LCD, layer, dst, xSize, ySize, offLine, color));
+}
+
+static void __Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    __TRACE_LL("Copy", (uint32_t)xSize * ySize * LCD->PixelSize, LL.Copy(LCD, layer, src, dst, xSize, ySize, offLineSrc, offLineDst));
+}
+
+static void __DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    __TRACE_LL("DrawHLine", length, LL.DrawHLine(LCD, layer, x, y, length, color));
+}
+
+static void __DrawVLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    __TRACE_LL("DrawVLine", length, LL.DrawVLine(LCD, layer, x, y, length, color));
+}
+
+static void __FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    __TRACE_LL("FillRect", (uint32_t)xSize * ySize, LL.FillRect(LCD, layer, x, y, xSize, ySize, color));
+}
+
+static void __BlendHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, const GUI_Byte* alpha, GUI_Color_t color) {
+    __TRACE_LL("BlendHLine", length, LL.BlendHLine(LCD, layer, x, y, length, alpha, color));
+}
+
+static void __FillBlend(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    __TRACE_LL("FillBlend", (uint32_t)xSize * ySize, LL.FillBlend(LCD, layer, x, y, xSize, ySize, color));
+}
+
+static void __CopyBlend(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst, GUI_Byte alpha) {
+    __TRACE_LL("CopyBlend", (uint32_t)xSize * ySize * LCD->PixelSize, LL.CopyBlend(LCD, layer, src, dst, xSize, ySize, offLineSrc, offLineDst, alpha));
+}
+
+static uint8_t __DecodeJPEG(GUI_LCD_t* LCD, const GUI_Byte* data, uint32_t len, const GUI_Display_t* clip, GUI_JPEG_Callback_t cb, void* param) {
+    uint8_t res;
+    __TRACE_LL("DecodeJPEG", len, res = LL.DecodeJPEG(LCD, data, len, clip, cb, param));
+    return res;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_TRACE_Init(void) {
+    memcpy((void *)&LL, (void *)&GUI.LL, sizeof(GUI_LL_t));    /* Save driver functions and put events around them */
+    
+    if (LL.SetPixel)    { GUI.LL.SetPixel = __SetPixel; }   /* GetPixel is not traced, it is called per pixel when blending */
+    if (LL.Fill)        { GUI.LL.Fill = __Fill; }
+    if (LL.Copy)        { GUI.LL.Copy = __Copy; }
+    if (LL.DrawHLine)   { GUI.LL.DrawHLine = __DrawHLine; }
+    if (LL.DrawVLine)   { GUI.LL.DrawVLine = __DrawVLine; }
+    if (LL.FillRect)    { GUI.LL.FillRect = __FillRect; }
+    if (LL.BlendHLine)  { GUI.LL.BlendHLine = __BlendHLine; }
+    if (LL.FillBlend)   { GUI.LL.FillBlend = __FillBlend; }
+    if (LL.CopyBlend)   { GUI.LL.CopyBlend = __CopyBlend; }
+    if (LL.DecodeJPEG)  { GUI.LL.DecodeJPEG = __DecodeJPEG; }
+}
+
+void __GUI_TRACE_Event(GUI_TRACE_CAT_t cat, const char* name, uint32_t arg, char phase) {
+    GUI_TRACE_Buffer_t* b;
+    GUI_TRACE_Event_t* e;
+    uint32_t count;
+    
+    if (phase == 'E') {                     /* End events are kept after stop to close open events */
+        if (!(b = Buffer)) {
+            return;
+        }
+    } else if (!Recording || !(b = __GetBuffer())) {
+        return;
+    }
+    count = b->Count;                       /* Only this thread changes it */
+    if (phase == 'E') {
+        if (b->Skip) {                      /* Begin event was dropped, drop end too */
+            b->Skip--;
+            b->Dropped++;
+            return;
+        }
+        if (!b->Open) {                     /* Recording started inside event */
+            return;
+        }
+        b->Open--;                          /* Space was reserved with begin event */
+    } else if (count + b->Open + (phase == 'B') >= GUI_TRACE_EVENTS) {   /* Keep space for end events */
+        if (phase == 'B') {
+            b->Skip++;
+        }
+        b->Dropped++;
+        return;
+    } else if (phase == 'B') {
+        b->Open++;
+    }
+    e = &b->Events[count];
+    e->Time = Counter ? Counter() : 0;
+    e->Name = name;
+    e->Arg = arg;
+    e->Cat = (uint8_t)cat;
+    e->Phase = phase;
+    __TRACE_StoreRelease(&b->Count, count + 1); /* Publish event to exporter */
+}
+
+uint32_t __GUI_TRACE_ProcessBegin(void) {
+    GUI_TRACE_Buffer_t* b;
+    uint32_t mark;
+    
+    if (!Recording || !(b = __GetBuffer())) {
+        return 0;
+    }
+    mark = b->Count;
+    GUI_TRACE_BEGIN(GUI_TRACE_CAT_GUI, "GUI_Process", 0);
+    if (b->Count == mark) {                 /* Buffer is full */
+        return 0;
+    }
+    mark = b->Count;                        /* Count right after begin event */
+    
+    /* Confirmation comes from interrupt, record it here to keep events in GUI thread */
+    if (Waiting && !(GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM)) {
+        GUI_TRACE_INSTANT(GUI_TRACE_CAT_LAYER, "LayerConfirmed", GUI.LCD.ActiveLayer);
+    }
+    return mark;
+}
+
+void __GUI_TRACE_ProcessEnd(uint32_t mark) {
+    GUI_TRACE_Buffer_t* b = Buffer;
+    
+    Waiting = !!(GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM);
+    if (b && mark && b->Count == mark) {    /* Nothing was recorded inside, remove idle call */
+        __TRACE_StoreRelease(&b->Count, mark - 1);
+        b->Open--;
+        return;
+    }
+    GUI_TRACE_END(GUI_TRACE_CAT_GUI, "GUI_Process");
+}
+
+void GUI_TRACE_SetCounter(GUI_TRACE_Counter_t counter, uint32_t frequency) {
+    Counter = counter;
+    Frequency = frequency ? frequency : 1;
+}
+
+void GUI_TRACE_Start(void) {
+    Recording = 1;
+}
+
+void GUI_TRACE_Stop(void) {
+    Recording = 0;
+}
+
+void GUI_TRACE_Reset(void) {
+    uint32_t i;
+    
+    for (i = 0; i < GUI_TRACE_THREADS; i++) {
+        Buffers[i].Count = 0;
+        Buffers[i].Dropped = 0;
+        Buffers[i].Open = 0;
+        Buffers[i].Skip = 0;
+    }
+}
+
+uint32_t GUI_TRACE_Export(GUI_TRACE_Write_t write, void* param) {
+    char str[160];
+    uint32_t t, i, count, total = 0, used;
+    const GUI_TRACE_Event_t* e;
+    uint64_t base = (uint64_t)-1;
+    double us;
+    int len;
+    
+    __GUI_ASSERTPARAMS(write);              /* Check input parameters */
+    
+    used = __TRACE_LoadAcquire(&BuffersUsed);
+    if (used > GUI_TRACE_THREADS) {
+        used = GUI_TRACE_THREADS;
+    }
+    for (t = 0; t < used; t++) {            /* Find first event time, timeline starts at 0 */
+        if (__TRACE_LoadAcquire(&Buffers[t].Count) && Buffers[t].Events[0].Time < base) {
+            base = Buffers[t].Events[0].Time;
+        }
+    }
+    
+    write("{\"traceEvents\":[", 16, param);
+    for (t = 0; t < used; t++) {
+        count = __TRACE_LoadAcquire(&Buffers[t].Count);
+        for (i = 0; i < count; i++) {
+            e = &Buffers[t].Events[i];
+            us = (double)(e->Time - base) * 1000000.0 / Frequency;
+            len = snprintf(str, sizeof(str), "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                total ? "," : "", e->Name, Cats[e->Cat], e->Phase, us, (unsigned)(t + 1));
+            if (len > 0 && len < (int)sizeof(str) && e->Phase != 'E') {
+                len += snprintf(&str[len], sizeof(str) - len, "%s,\"args\":{\"%s\":%u}}",
+                    e->Phase == 'i' ? ",\"s\":\"t\"" : "", Args[e->Cat], (unsigned)e->Arg);
+            } else if (len > 0 && len < (int)sizeof(str)) {
+                len += snprintf(&str[len], sizeof(str) - len, "}");
+            }
+            if (len > 0 && len < (int)sizeof(str)) {
+                write(str, len, param);
+                total++;
+            }
+        }
+    }
+    len = snprintf(str, sizeof(str), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%u}}\n", (unsigned)GUI_TRACE_GetDropped());
+    write(str, len, param);
+    return total;
+}
+
+uint32_t GUI_TRACE_GetDropped(void) {
+    uint32_t i, dropped = 0;
+    
+    for (i = 0; i < GUI_TRACE_THREADS; i++) {
+        dropped += Buffers[i].Dropped;
+    }
+    return dropped;
+}
@@ -0,0 +1,274 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI timeline trace in Chrome trace event format
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_TRACE_H
+#define GUI_TRACE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+
+/**
+ * \defgroup      GUI_TRACE
+ * \brief         Timeline trace of GUI processing
+ *
+ * Library records begin and end events for \ref GUI_Process, widgets redraw,
+ * drawing function of each widget and every low-level driver call,
+ * and instant events when layers are swapped.
+ * Events are exported in Chrome trace event JSON format, which can be opened
+ * in Perfetto UI or chrome://tracing.
+ *
+ * Each thread writes events to its own buffer without locking.
+ * On systems without thread local storage (\ref GUI_TRACE_THREAD_LOCAL is empty)
+ * there is single buffer and events must be written from GUI thread only.
+ * Buffer is never overwritten, when it is full new events are dropped and counted.
+ * Space for end events of open begin events is always kept, exported events are balanced.
+ * \ref GUI_Process calls where nothing was done are removed from buffer.
+ *
+ * Trace is compiled in with \ref GUI_TRACE_ENABLED. When it is 0, all hooks are removed.
+ *
+ * Overhead when enabled and started is one counter read and one 24-byte store per event,
+ * 2 events per widget draw and per low-level call, plus 4 per drawn frame.
+ * Frame overhead is bounded by (4 + 2 * (widgets + low-level calls)) * event time.
+ * On x86-64 host with clock_gettime counter an event takes about 25 ns.
+ * When trace is stopped, each hook is single flag check.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_TRACE_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+/**
+ * \brief         Enables timeline trace
+ */
+#ifndef GUI_TRACE_ENABLED
+#define GUI_TRACE_ENABLED           0
+#endif
+
+/**
+ * \brief         Number of events in buffer of each thread
+ */
+#ifndef GUI_TRACE_EVENTS
+#define GUI_TRACE_EVENTS            1024
+#endif
+
+/**
+ * \brief         Maximal number of threads writing events
+ */
+#ifndef GUI_TRACE_THREADS
+#define GUI_TRACE_THREADS           4
+#endif
+
+/**
+ * \brief         Storage class for per thread buffer pointer
+ */
+#ifndef GUI_TRACE_THREAD_LOCAL
+#if defined(__linux__) || defined(__APPLE__)
+#define GUI_TRACE_THREAD_LOCAL      __thread
+#else
+#define GUI_TRACE_THREAD_LOCAL
+#endif
+#endif
+
+#if GUI_TRACE_ENABLED || defined(__DOXYGEN__)
+/**
+ * \brief         Write begin event
+ * \param[in]     cat: Event category, member of \ref GUI_TRACE_CAT_t enumeration
+ * \param[in]     name: Event name, must be constant string
+ * \param[in]     arg: Event value, exported as argument
+ */
+#define GUI_TRACE_BEGIN(cat, name, arg)     __GUI_TRACE_Event((cat), (name), (arg), 'B')
+
+/**
+ * \brief         Write end event for last begin event
+ * \param[in]     cat: Event category, member of \ref GUI_TRACE_CAT_t enumeration
+ * \param[in]     name: Event name, same as in begin event
+ */
+#define GUI_TRACE_END(cat, name)            __GUI_TRACE_Event((cat), (name), 0, 'E')
+
+/**
+ * \brief         Write instant event
+ * \param[in]     cat: Event category, member of \ref GUI_TRACE_CAT_t enumeration
+ * \param[in]     name: Event name, must be constant string
+ * \param[in]     arg: Event value, exported as argument
+ */
+#define GUI_TRACE_INSTANT(cat, name, arg)   __GUI_TRACE_Event((cat), (name), (arg), 'i')
+
+#define __GUI_TRACE_INIT()                  __GUI_TRACE_Init()
+#define __GUI_TRACE_PROCESS_BEGIN()         uint32_t __trace = __GUI_TRACE_ProcessBegin()
+#define __GUI_TRACE_PROCESS_END()           __GUI_TRACE_ProcessEnd(__trace)
+#else
+#define GUI_TRACE_BEGIN(cat, name, arg)
+#define GUI_TRACE_END(cat, name)
+#define GUI_TRACE_INSTANT(cat, name, arg)
+#define __GUI_TRACE_INIT()
+#define __GUI_TRACE_PROCESS_BEGIN()
+#define __GUI_TRACE_PROCESS_END()
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_TRACE_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Event category, also selects name of argument in export
+ */
+typedef enum GUI_TRACE_CAT_t {
+    GUI_TRACE_CAT_GUI = 0x00,               /*!< GUI processing, argument is value */
+    GUI_TRACE_CAT_WIDGET,                   /*!< Widget drawing, argument is widget ID */
+    GUI_TRACE_CAT_LL,                       /*!< Low-level call, argument is number of pixels or bytes */
+    GUI_TRACE_CAT_LAYER,                    /*!< Layer change, argument is layer number */
+    GUI_TRACE_CAT_USER,                     /*!< User events, argument is value */
+} GUI_TRACE_CAT_t;
+
+/**
+ * \brief         Function returning free running 64-bit counter
+ */
+typedef uint64_t (*GUI_TRACE_Counter_t)(void);
+
+/**
+ * \brief         Function to write part of exported JSON text
+ * \param[in]     data: Text to write
+ * \param[in]     len: Number of characters
+ * \param[in]     param: User parameter passed to \ref GUI_TRACE_Export
+ */
+typedef void (*GUI_TRACE_Write_t)(const char* data, uint32_t len, void* param);
+
+/**
+ * \brief         Single trace event
+ */
+typedef struct GUI_TRACE_Event_t {
+    uint64_t Time;                          /*!< Counter value */
+    const char* Name;                       /*!< Event name */
+    uint32_t Arg;                           /*!< Event argument */
+    uint8_t Cat;                            /*!< Event category */
+    char Phase;                             /*!< Event phase, B for begin, E for end and i for instant */
+} GUI_TRACE_Event_t;
+
+/**
+ * \brief         Event buffer of single thread
+ */
+typedef struct GUI_TRACE_Buffer_t {
+    volatile uint32_t Count;                /*!< Number of events ready for export */
+    uint32_t Dropped;                       /*!< Number of events dropped because buffer was full */
+    uint16_t Open;                          /*!< Number of recorded begin events without end event */
+    uint16_t Skip;                          /*!< Number of dropped begin events without end event */
+    GUI_TRACE_Event_t Events[GUI_TRACE_EVENTS]; /*!< Events */
+} GUI_TRACE_Buffer_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_TRACE_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+/**
+ * \brief         Set counter for event time
+ * \param[in]     counter: Function returning free running counter
+ * \param[in]     frequency: Counter frequency in units of Hz
+ */
+void GUI_TRACE_SetCounter(GUI_TRACE_Counter_t counter, uint32_t frequency);
+
+/**
+ * \brief         Start recording events
+ */
+void GUI_TRACE_Start(void);
+
+/**
+ * \brief         Stop recording events
+ */
+void GUI_TRACE_Stop(void);
+
+/**
+ * \brief         Clear events of all threads
+ * \note          Recording must be stopped and no thread may write events
+ */
+void GUI_TRACE_Reset(void);
+
+/**
+ * \brief         Export recorded events as Chrome trace event JSON
+ * \note          Only events recorded before call are exported, recording may continue meanwhile
+ * \param[in]     write: Function to write output text
+ * \param[in]     param: User parameter for write function
+ * \retval        Number of exported events
+ */
+uint32_t GUI_TRACE_Export(GUI_TRACE_Write_t write, void* param);
+
+/**
+ * \brief         Get number of events dropped because of full buffers
+ * \retval        Number of dropped events in all threads
+ */
+uint32_t GUI_TRACE_GetDropped(void);
+
+void __GUI_TRACE_Init(void);
+void __GUI_TRACE_Event(GUI_TRACE_CAT_t cat, const char* name, uint32_t arg, char phase);
+uint32_t __GUI_TRACE_ProcessBegin(void);
+void __GUI_TRACE_ProcessEnd(uint32_t mark);
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
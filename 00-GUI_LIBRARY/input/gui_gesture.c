@@ -0,0 +1,270 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_gesture.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+typedef struct __GUI_GESTURE_Point_t {
+    GUI_Dim_t X;
+    GUI_Dim_t Y;
+    uint32_t Time;
+} __GUI_GESTURE_Point_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GESTURE_HISTORY       8                   /* Number of last positions for velocity, power of 2 */
+
+#define __ABS(x)                ((x) < 0 ? -(x) : (x))
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static struct {
+    uint8_t Active;                                 /* Finger is pressed */
+    uint8_t Moved;                                  /* Finger moved out of tap area */
+    uint8_t Multi;                                  /* More than one finger used, single finger gestures disabled */
+    uint8_t LongPress;                              /* Long press was already reported */
+    __GUI_GESTURE_Point_t Start;                    /* First touch position */
+    __GUI_GESTURE_Point_t History[__GESTURE_HISTORY];   /* Last positions */
+    uint8_t HistoryCount;                           /* Number of all positions, wraps around */
+    uint32_t PinchStart;                            /* Distance between fingers on pinch start */
+    uint32_t PinchScale;                            /* Last reported scale */
+    void (*Callback)(const GUI_GESTURE_t *);
+} G;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Integer square root */
+static uint32_t __Sqrt(uint32_t x) {
+    uint32_t r = 0, b = 1UL << 30;
+    
+    while (b > x) {
+        b >>= 2;
+    }
+    while (b) {
+        if (x >= r + b) {
+            x -= r + b;
+            r = (r >> 1) + b;
+        } else {
+            r >>= 1;
+        }
+        b >>= 2;
+    }
+    return r;
+}
+
+/* Distance between first two fingers */
+static uint32_t __Distance(const GUI_TouchData_t* ts) {
+    int32_t dx = (int32_t)ts->X[1] - ts->X[0];
+    int32_t dy = (int32_t)ts->Y[1] - ts->Y[0];
+    return __Sqrt((uint32_t)(dx * dx + dy * dy));
+}
+
+/* Prepare gesture with start data and send it to user */
+static void __Report(GUI_GESTURE_t* g, GUI_GESTURE_TYPE_t type, uint32_t time) {
+    g->Type = type;
+    g->Time = time;
+    if (G.Callback) {
+        G.Callback(g);
+    }
+}
+
+/* Get last position from history */
+#define __LAST()                (&G.History[(G.HistoryCount - 1) & (__GESTURE_HISTORY - 1)])
+
+/* Calculate velocity from positions in last time window before release */
+static void __Velocity(GUI_GESTURE_t* g, uint32_t time) {
+    __GUI_GESTURE_Point_t *last, *p, *first;
+    uint8_t i, cnt;
+    uint32_t dt;
+    
+    last = __LAST();
+    if ((uint32_t)(time - last->Time) > GUI_GESTURE_VELOCITY_TIME) {
+        return;                                     /* Finger stopped before release */
+    }
+    first = last;
+    cnt = G.HistoryCount < __GESTURE_HISTORY ? G.HistoryCount : __GESTURE_HISTORY;
+    for (i = 2; i <= cnt; i++) {                    /* Find oldest position inside time window */
+        p = &G.History[(G.HistoryCount - i) & (__GESTURE_HISTORY - 1)];
+        if ((uint32_t)(last->Time - p->Time) > GUI_GESTURE_VELOCITY_TIME) {
+            break;
+        }
+        first = p;
+    }
+    dt = last->Time - first->Time;
+    if (dt) {
+        g->VelocityX = ((int32_t)last->X - first->X) * 1000 / (int32_t)dt;
+        g->VelocityY = ((int32_t)last->Y - first->Y) * 1000 / (int32_t)dt;
+    }
+}
+
+/* Finger released, check for tap, swipe and fling */
+static void __Release(uint32_t time) {
+    GUI_GESTURE_t g;
+    __GUI_GESTURE_Point_t* last = __LAST();
+    int32_t adx, ady;
+    
+    memset((void *)&g, 0x00, sizeof(g));
+    g.X = G.Start.X;
+    g.Y = G.Start.Y;
+    g.DX = (GUI_iDim_t)((int32_t)last->X - G.Start.X);
+    g.DY = (GUI_iDim_t)((int32_t)last->Y - G.Start.Y);
+    g.Scale = 256;
+    
+    if (!G.Moved) {
+        if (!G.LongPress) {
+            __Report(&g, GUI_GESTURE_TYPE_TAP, time);
+        }
+        return;
+    }
+    
+    __Velocity(&g, time);
+    adx = __ABS(g.DX);
+    ady = __ABS(g.DY);
+    if ((adx >= GUI_GESTURE_SWIPE_DISTANCE || ady >= GUI_GESTURE_SWIPE_DISTANCE) && (uint32_t)(time - G.Start.Time) <= GUI_GESTURE_SWIPE_TIME) {
+        if (adx >= ady) {
+            g.Direction = g.DX > 0 ? GUI_GESTURE_DIR_RIGHT : GUI_GESTURE_DIR_LEFT;
+        } else {
+            g.Direction = g.DY > 0 ? GUI_GESTURE_DIR_DOWN : GUI_GESTURE_DIR_UP;
+        }
+        __Report(&g, GUI_GESTURE_TYPE_SWIPE, time);
+    }
+    if (__ABS(g.VelocityX) >= GUI_GESTURE_FLING_VELOCITY || __ABS(g.VelocityY) >= GUI_GESTURE_FLING_VELOCITY) {
+        g.Direction = GUI_GESTURE_DIR_NONE;
+        __Report(&g, GUI_GESTURE_TYPE_FLING, time);
+    }
+}
+
+/* Two or more fingers are pressed, check for pinch */
+static void __Pinch(const GUI_TouchData_t* ts) {
+    GUI_GESTURE_t g;
+    uint32_t dist, scale;
+    
+    dist = __Distance(ts);
+    if (!G.PinchStart) {                            /* Start measuring from first valid distance */
+        G.PinchStart = dist;
+        G.PinchScale = 256;
+        return;
+    }
+    scale = dist * 256 / G.PinchStart;
+    if (__ABS((int32_t)scale - (int32_t)G.PinchScale) < GUI_GESTURE_PINCH_STEP) {
+        return;
+    }
+    G.PinchScale = scale;
+    
+    memset((void *)&g, 0x00, sizeof(g));
+    g.X = (ts->X[0] + ts->X[1]) / 2;
+    g.Y = (ts->Y[0] + ts->Y[1]) / 2;
+    g.Scale = scale;
+    __Report(&g, GUI_GESTURE_TYPE_PINCH, ts->Time);
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_GESTURE_Init(void) {
+    memset((void *)&G, 0x00, sizeof(G));
+}
+
+/* Process new touch sample */
+void __GUI_GESTURE_Add(const GUI_TouchData_t* ts) {
+    __GUI_GESTURE_Point_t* p;
+    
+    if (ts->Status != GUI_TouchState_PRESSED || !ts->Count) {
+        if (G.Active) {
+            G.Active = 0;
+            if (!G.Multi) {
+                __Release(ts->Time);
+            }
+        }
+        return;
+    }
+    
+    if (!G.Active) {                                /* New touch started */
+        G.Active = 1;
+        G.Moved = G.Multi = G.LongPress = 0;
+        G.HistoryCount = 0;
+        G.PinchStart = 0;
+        G.Start.X = ts->X[0];
+        G.Start.Y = ts->Y[0];
+        G.Start.Time = ts->Time;
+    }
+    if (ts->Count > 1) {
+        G.Multi = 1;
+        __Pinch(ts);
+        return;
+    }
+    if (G.Multi) {                                  /* Wait for all fingers to be released */
+        return;
+    }
+    
+    p = &G.History[G.HistoryCount++ & (__GESTURE_HISTORY - 1)];
+    if (G.HistoryCount == 2 * __GESTURE_HISTORY) {  /* Keep count small, but not below history size */
+        G.HistoryCount = __GESTURE_HISTORY;
+    }
+    p->X = ts->X[0];
+    p->Y = ts->Y[0];
+    p->Time = ts->Time;
+    if (__ABS((int32_t)p->X - G.Start.X) > GUI_GESTURE_SLOP || __ABS((int32_t)p->Y - G.Start.Y) > GUI_GESTURE_SLOP) {
+        G.Moved = 1;
+    }
+}
+
+/* Check time based gestures, called once per GUI_Process */
+void __GUI_GESTURE_Process(void) {
+    GUI_GESTURE_t g;
+    
+    if (G.Active && !G.Moved && !G.Multi && !G.LongPress && (uint32_t)(GUI.Time - G.Start.Time) >= GUI_GESTURE_LONG_PRESS_TIME) {
+        G.LongPress = 1;
+        memset((void *)&g, 0x00, sizeof(g));
+        g.X = G.Start.X;
+        g.Y = G.Start.Y;
+        g.Scale = 256;
+        __Report(&g, GUI_GESTURE_TYPE_LONG_PRESS, GUI.Time);
+    }
+}
+
+uint8_t GUI_GESTURE_SetCallback(void (*callback)(const GUI_GESTURE_t *)) {
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    G.Callback = callback;
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
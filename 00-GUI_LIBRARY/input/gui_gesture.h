@@ -0,0 +1,171 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI touch gesture recognizer
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_GESTURE_H
+#define GUI_GESTURE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "..\gui.h"
+
+/**
+ * \defgroup      GUI_GESTURE
+ * \brief         Touch gestures
+ *
+ * Gestures are recognized from touch samples read in \ref GUI_Process
+ * and reported to user callback, independent of widget touch events.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_GESTURE_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+#ifndef GUI_GESTURE_SLOP
+#define GUI_GESTURE_SLOP                10      /*!< Movement in pixels before touch is no longer tap */
+#endif
+#ifndef GUI_GESTURE_LONG_PRESS_TIME
+#define GUI_GESTURE_LONG_PRESS_TIME     500     /*!< Time in milliseconds for long press */
+#endif
+#ifndef GUI_GESTURE_SWIPE_DISTANCE
+#define GUI_GESTURE_SWIPE_DISTANCE      50      /*!< Minimal swipe distance in pixels */
+#endif
+#ifndef GUI_GESTURE_SWIPE_TIME
+#define GUI_GESTURE_SWIPE_TIME          300     /*!< Maximal swipe time in milliseconds */
+#endif
+#ifndef GUI_GESTURE_FLING_VELOCITY
+#define GUI_GESTURE_FLING_VELOCITY      500     /*!< Minimal release velocity for fling in pixels per second */
+#endif
+#ifndef GUI_GESTURE_VELOCITY_TIME
+#define GUI_GESTURE_VELOCITY_TIME       100     /*!< Time window in milliseconds for release velocity */
+#endif
+#ifndef GUI_GESTURE_PINCH_STEP
+#define GUI_GESTURE_PINCH_STEP          8       /*!< Minimal scale change for new pinch event, 256 is 100% */
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_GESTURE_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Gesture type
+ */
+typedef enum GUI_GESTURE_TYPE_t {
+    GUI_GESTURE_TYPE_TAP = 0x00,            /*!< Short touch without movement */
+    GUI_GESTURE_TYPE_LONG_PRESS,            /*!< Long touch without movement, reported while finger is still pressed */
+    GUI_GESTURE_TYPE_SWIPE,                 /*!< Fast straight movement in one direction */
+    GUI_GESTURE_TYPE_PINCH,                 /*!< Distance between two fingers changed */
+    GUI_GESTURE_TYPE_FLING,                 /*!< Finger released while moving */
+} GUI_GESTURE_TYPE_t;
+
+/**
+ * \brief         Swipe direction
+ */
+typedef enum GUI_GESTURE_DIR_t {
+    GUI_GESTURE_DIR_NONE = 0x00,            /*!< No direction */
+    GUI_GESTURE_DIR_LEFT,                   /*!< Finger moved left */
+    GUI_GESTURE_DIR_RIGHT,                  /*!< Finger moved right */
+    GUI_GESTURE_DIR_UP,                     /*!< Finger moved up */
+    GUI_GESTURE_DIR_DOWN,                   /*!< Finger moved down */
+} GUI_GESTURE_DIR_t;
+
+/**
+ * \brief         Recognized gesture
+ */
+typedef struct GUI_GESTURE_t {
+    GUI_GESTURE_TYPE_t Type;                /*!< Gesture type */
+    GUI_Dim_t X;                            /*!< Start X position, center between fingers for pinch */
+    GUI_Dim_t Y;                            /*!< Start Y position, center between fingers for pinch */
+    GUI_iDim_t DX;                          /*!< X movement from start position */
+    GUI_iDim_t DY;                          /*!< Y movement from start position */
+    GUI_GESTURE_DIR_t Direction;            /*!< Swipe direction */
+    int32_t VelocityX;                      /*!< X velocity on release in pixels per second */
+    int32_t VelocityY;                      /*!< Y velocity on release in pixels per second */
+    uint32_t Scale;                         /*!< Pinch distance relative to start distance, 256 is 100% */
+    uint32_t Time;                          /*!< Time of gesture in units of milliseconds */
+} GUI_GESTURE_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_GESTURE_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+/**
+ * \brief         Set function called on every recognized gesture
+ * \param[in]     *callback: Callback function, set to NULL to disable gestures
+ * \retval        1
+ */
+uint8_t GUI_GESTURE_SetCallback(void (*callback)(const GUI_GESTURE_t *));
+
+//Internal purpose only
+void __GUI_GESTURE_Init(void);
+void __GUI_GESTURE_Add(const GUI_TouchData_t* ts);
+void __GUI_GESTURE_Process(void);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -36,15 +36,30 @@
 /***                           Private definitions                           **/
 /******************************************************************************/
 /******************************************************************************/
-#define __TOUCH_BUFFER_SIZE     (10 * sizeof(GUI_TouchData_t))
-BUFFER_t Buffer;
-GUI_Byte_t BufferData[__TOUCH_BUFFER_SIZE + 1];
+#define __TOUCH_QUEUE_MASK      (GUI_INPUT_TOUCH_QUEUE_SIZE - 1)
+
+#if (GUI_INPUT_TOUCH_QUEUE_SIZE & __TOUCH_QUEUE_MASK)
+#error "GUI_INPUT_TOUCH_QUEUE_SIZE must be power of 2"
+#endif
+
+/* Prevent compiler to reorder sample and index access, single core does not need more */
+#if defined(__GNUC__)
+#define __TOUCH_BARRIER()       __asm volatile ("" ::: "memory")
+#else
+#define __TOUCH_BARRIER()       __schedule_barrier()
+#endif
 
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private variables                            **/
 /******************************************************************************/
 /******************************************************************************/
+static GUI_TouchData_t Queue[GUI_INPUT_TOUCH_QUEUE_SIZE];
+static volatile uint32_t QueueIn;                   /* Number of written samples, changed by producer only */
+static volatile uint32_t QueueOut;                  /* Number of read samples, changed by GUI only */
+static volatile uint32_t Added, Dropped;
+static GUI_INPUT_Stats_t Stats;                     /* Statistics updated by GUI */
+static GUI_TouchData_t Last, Prev;                  /* Last two samples given to GUI */
 
 /******************************************************************************/
 /******************************************************************************/
@@ -57,17 +72,118 @@ GUI_Byte_t BufferData[__TOUCH_BUFFER_SIZE + 1];
 /***                                Public API                               **/
 /******************************************************************************/
 /******************************************************************************/
-void GUI_INPUT_AddTouch(const GUI_TouchData_t* Data) {
-    BUFFER_Write(&Buffer, Data, sizeof(GUI_TouchData_t));   /* Write data to buffer */
+GUI_Byte_t GUI_INPUT_AddTouch(const GUI_TouchData_t* Data) {
+    GUI_TouchData_t* t;
+    uint32_t in = QueueIn;
+    
+    if ((uint32_t)(in - QueueOut) >= GUI_INPUT_TOUCH_QUEUE_SIZE) {  /* Queue is full */
+        Dropped++;
+        return 0;
+    }
+    t = &Queue[in & __TOUCH_QUEUE_MASK];
+    memcpy((void *)t, (void *)Data, sizeof(GUI_TouchData_t));   /* Copy sample to queue */
+    if (t->Count > GUI_TOUCH_MAX_PRESSES) {
+        t->Count = GUI_TOUCH_MAX_PRESSES;
+    }
+    t->Time = GUI.Time;                             /* Set sample time */
+    __TOUCH_BARRIER();                              /* Sample must be written before it is visible to GUI */
+    QueueIn = in + 1;
+    Added++;
+    return 1;
+}
+
+uint32_t GUI_INPUT_GetDroppedTouch(void) {
+    return Dropped;
+}
+
+GUI_Byte_t GUI_INPUT_GetStats(GUI_INPUT_Stats_t* stats, GUI_Byte_t reset) {
+    __GUI_ASSERTPARAMS(stats);                      /* Check input parameters */
+    
+    memcpy((void *)stats, (void *)&Stats, sizeof(GUI_INPUT_Stats_t));
+    stats->Added = Added;
+    stats->Dropped = Dropped;
+    if (reset) {
+        memset((void *)&Stats, 0x00, sizeof(GUI_INPUT_Stats_t));
+        Added = Dropped = 0;
+    }
+    return 1;
 }
 
 void __GUI_INPUT_Init(void) {
-    BUFFER_Init(&Buffer, sizeof(BufferData), BufferData);
+    QueueIn = QueueOut = 0;
+    Added = Dropped = 0;
+    memset((void *)&Stats, 0x00, sizeof(Stats));
+    memset((void *)&Last, 0x00, sizeof(Last));
+    memset((void *)&Prev, 0x00, sizeof(Prev));
 }
 
+/*
+ * Read next touch sample from queue
+ *
+ * When finger was already pressed, all following move samples with
+ * the same number of touch points are merged to the newest one.
+ */
 GUI_Byte_t __GUI_INPUT_ReadTouch(GUI_TouchData_t* Data) {
-    if (BUFFER_GetFull(&Buffer) >= sizeof(GUI_TouchData_t)) {
-        return (GUI_Byte_t)BUFFER_Read(&Buffer, Data, sizeof(GUI_TouchData_t)); /* Read data fro mbuffer */
+    GUI_TouchData_t* t;
+    uint32_t out = QueueOut, in = QueueIn;
+    
+    if (out == in) {                                /* Nothing in queue */
+        return 0;
+    }
+    __TOUCH_BARRIER();                              /* Read index before sample */
+    memcpy((void *)Data, (void *)&Queue[out++ & __TOUCH_QUEUE_MASK], sizeof(GUI_TouchData_t));
+    if (Last.Status == GUI_TouchState_PRESSED) {    /* Merge moves, press and release are never merged */
+        while (Data->Status == GUI_TouchState_PRESSED && out != in) {
+            t = &Queue[out & __TOUCH_QUEUE_MASK];
+            if (t->Status != GUI_TouchState_PRESSED || t->Count != Data->Count) {
+                break;
+            }
+            memcpy((void *)Data, (void *)t, sizeof(GUI_TouchData_t));
+            out++;
+            Stats.Merged++;
+        }
+    }
+    __TOUCH_BARRIER();                              /* Samples must be read before entries are released */
+    QueueOut = out;
+    
+    if ((uint32_t)(GUI.Time - Data->Time) > Stats.MaxLatency) {
+        Stats.MaxLatency = GUI.Time - Data->Time;
+    }
+    memcpy((void *)&Prev, (void *)&Last, sizeof(GUI_TouchData_t));
+    memcpy((void *)&Last, (void *)Data, sizeof(GUI_TouchData_t));
+    return 1;
+}
+
+/*
+ * Called for every move event given to widget
+ *
+ * When prediction is requested, touch points are moved ahead by velocity
+ * of last two samples read. Returns 1 if position was changed.
+ */
+GUI_Byte_t __GUI_INPUT_PrepareMove(GUI_TouchData_t* Data, GUI_Byte_t predict) {
+    Stats.Moves++;
+#if GUI_INPUT_TOUCH_PREDICTION
+    if (predict) {
+        int32_t v;
+        uint32_t dt;
+        uint8_t i, changed = 0;
+        
+        dt = Data->Time - Prev.Time;
+        if (Prev.Status != GUI_TouchState_PRESSED || Prev.Count != Data->Count || !dt || dt > 100) {
+            return 0;                               /* No valid velocity */
+        }
+        for (i = 0; i < Data->Count; i++) {
+            v = ((int32_t)Data->X[i] - Prev.X[i]) * GUI_INPUT_TOUCH_PREDICTION / (int32_t)dt + Data->X[i];
+            v = v < 0 ? 0 : (v >= GUI.LCD.Width ? GUI.LCD.Width - 1 : v);
+            changed |= v != Data->X[i];
+            Data->X[i] = v;
+            v = ((int32_t)Data->Y[i] - Prev.Y[i]) * GUI_INPUT_TOUCH_PREDICTION / (int32_t)dt + Data->Y[i];
+            v = v < 0 ? 0 : (v >= GUI.LCD.Height ? GUI.LCD.Height - 1 : v);
+            changed |= v != Data->Y[i];
+            Data->Y[i] = v;
+        }
+        return changed;
     }
+#endif
     return 0;
 }
@@ -50,6 +50,23 @@ extern "C" {
  * @{
  */
 
+/**
+ * \brief         Number of touch samples in input queue, must be power of 2
+ * \note          Consecutive move samples are merged on read when GUI is late with processing
+ */
+#ifndef GUI_INPUT_TOUCH_QUEUE_SIZE
+#define GUI_INPUT_TOUCH_QUEUE_SIZE      16
+#endif
+
+/**
+ * \brief         Time in milliseconds to predict touch position ahead for dragged widgets
+ * \note          Prediction uses velocity of last samples and hides part of touch and display latency.
+ *                  Widget gets real position when touch is released. Set to 0 to disable.
+ */
+#ifndef GUI_INPUT_TOUCH_PREDICTION
+#define GUI_INPUT_TOUCH_PREDICTION      0
+#endif
+
 /**
  * \}
  */
@@ -60,6 +77,17 @@ extern "C" {
  * \{
  */
 
+/**
+ * \brief         Touch input statistics
+ */
+typedef struct GUI_INPUT_Stats_t {
+    uint32_t Added;                         /*!< Number of samples added to queue */
+    uint32_t Dropped;                       /*!< Number of samples dropped because of full queue */
+    uint32_t Merged;                        /*!< Number of move samples merged to newer samples */
+    uint32_t Moves;                         /*!< Number of move events sent to widgets */
+    uint32_t MaxLatency;                    /*!< Maximal time in milliseconds from adding sample to processing it */
+} GUI_INPUT_Stats_t;
+
 /**
  * @}
  */
@@ -70,11 +98,34 @@ extern "C" {
  * \{
  */
 
-void GUI_INPUT_AddTouch(const GUI_TouchData_t* Data);
+/**
+ * \brief         Add new touch sample to input queue
+ * \note          Function may be called from interrupt, while \ref GUI_Process reads samples.
+ *                  Only one producer is allowed at a time.
+ * \param[in]     *Data: Touch data, sample time is set by function
+ * \retval        1: Sample added
+ * \retval        0: Queue is full, sample dropped
+ */
+GUI_Byte_t GUI_INPUT_AddTouch(const GUI_TouchData_t* Data);
+
+/**
+ * \brief         Get number of touch samples dropped because of full queue
+ * \retval        Number of dropped samples since init
+ */
+uint32_t GUI_INPUT_GetDroppedTouch(void);
+
+/**
+ * \brief         Get touch input statistics
+ * \param[out]    *stats: Pointer to structure to save statistics to
+ * \param[in]     reset: Set to 1 to reset statistics after read
+ * \retval        1
+ */
+GUI_Byte_t GUI_INPUT_GetStats(GUI_INPUT_Stats_t* stats, GUI_Byte_t reset);
 
 //Internal purpose only
 void __GUI_INPUT_Init(void);
 GUI_Byte_t __GUI_INPUT_ReadTouch(GUI_TouchData_t* Data);
+GUI_Byte_t __GUI_INPUT_PrepareMove(GUI_TouchData_t* Data, GUI_Byte_t predict);
 
 /**
  * \}
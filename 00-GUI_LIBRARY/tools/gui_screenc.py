@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""
+Screen description compiler for GUI_SCREEN_Load.
+
+Converts JSON widget tree to binary description documented in gui_screen.h.
+
+JSON input:
+
+    {
+        "fonts": ["Arial_Narrow_Italic_22", "Calibri_Bold_8"],
+        "screen": {
+            "type": "window", "id": 1, "x": 0, "y": 0, "width": 480, "height": 272,
+            "colors": {"bg": "0x00202020"},
+            "children": [
+                {"type": "button", "id": 257, "x": 10, "y": 10, "width": 100, "height": 40,
+                 "font": "Arial_Narrow_Italic_22", "text": "OK", "colors": {"bg": "0x000000FF"}}
+            ]
+        }
+    }
+
+Font is name from "fonts" list or index into it. Order of "fonts" list is
+order of font table passed to GUI_SCREEN_Load. Color is name or index of
+widget color and 32-bit color value as number or string, same as GUI_COLOR_x
+values: top byte is transparency, 0x00 for opaque and 0xFF for fully
+transparent, followed by red, green and blue bytes.
+
+Usage:
+
+    gui_screenc.py screen.json -o screen.bin
+    gui_screenc.py screen.json -c screen_main -o screen_main.c
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+VERSION = 1
+NONE = 0xFFFF
+
+# Type name, type value, color names by index, same as GUI_SCREEN_TYPE_t and widget color indexes
+TYPES = {
+    "window":  (0, ["bg"]),
+    "button":  (1, ["fg", "bg", "border"]),
+    "led":     (2, ["on", "off", "on_border", "off_border"]),
+    "progbar": (3, ["bg", "fg", "border"]),
+}
+
+
+def error(msg):
+    sys.exit("gui_screenc: " + msg)
+
+
+def number(value, what):
+    if isinstance(value, str):
+        try:
+            return int(value, 0)
+        except ValueError:
+            error("invalid %s: %s" % (what, value))
+    if isinstance(value, bool) or not isinstance(value, int):
+        error("invalid %s: %r" % (what, value))
+    return value
+
+
+def flatten(node, parent, out):
+    """Put widgets to list in creation order, parent is always before its children"""
+    if node.get("type") not in TYPES:
+        error("unknown widget type: %r" % node.get("type"))
+    if parent != NONE and out[parent][0].get("type") != "window":
+        error("only window can have children")
+    index = len(out)
+    out.append((node, parent))
+    for child in node.get("children", []):
+        flatten(child, index, out)
+
+
+def compile_screen(desc):
+    fonts = desc.get("fonts", [])
+    if len(fonts) > 0xFF:
+        error("too many fonts")
+    if "screen" not in desc:
+        error("missing screen")
+
+    widgets = []
+    flatten(desc["screen"], NONE, widgets)
+    if widgets[0][0]["type"] != "window":
+        error("screen must be window")
+    if len(widgets) >= NONE:
+        error("too many widgets")
+
+    strings = bytearray()
+    offsets = {}
+    counts = [0] * len(TYPES)
+    body = bytearray()
+
+    for node, parent in widgets:
+        type, names = TYPES[node["type"]]
+        counts[type] += 1
+
+        font = node.get("font")
+        if font is None:
+            font = 0xFF
+        elif isinstance(font, str) and font in fonts:
+            font = fonts.index(font)
+        else:
+            font = number(font, "font")
+            if font >= len(fonts):
+                error("font index out of range: %d" % font)
+
+        text = node.get("text")
+        if text is None:
+            text = NONE
+        else:
+            if text not in offsets:             # Same texts share one string
+                offsets[text] = len(strings)
+                strings += text.encode("utf-8") + b"\0"
+            text = offsets[text]
+            if text >= NONE:
+                error("string table too big")
+
+        colors = []
+        for name, value in node.get("colors", {}).items():
+            index = names.index(name) if name in names else number(name, "color index")
+            if index >= len(names):
+                error("color index out of range for %s: %s" % (node["type"], name))
+            colors.append((index, number(value, "color") & 0xFFFFFFFF))
+
+        body += struct.pack("<BBHHhhHHHBB", type, font, parent,
+                            number(node.get("id", 0), "id"),
+                            number(node.get("x", 0), "x"), number(node.get("y", 0), "y"),
+                            number(node.get("width", 0), "width"), number(node.get("height", 0), "height"),
+                            text, len(colors), 0)
+        for index, color in colors:
+            body += struct.pack("<BI", index, color)
+
+    if len(strings) > NONE:
+        error("string table too big")
+
+    header = b"GSC" + struct.pack("<BHH4H", VERSION, len(widgets), len(strings), *counts)
+    return header + body + strings
+
+
+def c_array(name, data):
+    lines = ["/* Generated by gui_screenc.py, do not edit */", "#include \"stdint.h\"", "",
+             "const uint8_t %s[%d] = {" % (name, len(data))]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile JSON screen to GUI_SCREEN binary description")
+    parser.add_argument("input", help="JSON screen file")
+    parser.add_argument("-o", "--output", help="output file, stdout if not set")
+    parser.add_argument("-c", "--c-array", metavar="NAME", help="output C source with constant array NAME")
+    args = parser.parse_args()
+
+    with open(args.input, "r") as f:
+        data = compile_screen(json.load(f))
+
+    if args.c_array:
+        out = c_array(args.c_array, data).encode("ascii")
+    else:
+        out = data
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(out)
+    else:
+        sys.stdout.buffer.write(out)
+
+
+if __name__ == "__main__":
+    main()
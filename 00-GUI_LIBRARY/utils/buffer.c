@@ -25,6 +25,25 @@
  */
 #include "buffer.h"
 
+/* Index access for single producer single consumer buffer */
+#if defined(__GNUC__)
+#define BUFFER_LoadAcquire(ptr)             __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define BUFFER_StoreRelease(ptr, value)     __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+/* Read index written by other side, data access can not be moved before it */
+static uint32_t BUFFER_LoadAcquire(volatile uint32_t* ptr) {
+	uint32_t value = *ptr;
+	__dmb(0xF);
+	return value;
+}
+
+/* Write own index, data access can not be moved after it */
+static void BUFFER_StoreRelease(volatile uint32_t* ptr, uint32_t value) {
+	__dmb(0xF);
+	*ptr = value;
+}
+#endif
+
 uint8_t BUFFER_Init(BUFFER_t* Buffer, uint32_t Size, void* BufferPtr) {
 	if (Buffer == NULL) {									/* Check buffer structure */
 		return 1;
@@ -254,69 +273,108 @@ void BUFFER_Reset(BUFFER_t* Buffer) {
 	Buffer->Out = 0;
 }
 
+/* Get data in buffer as up to 2 contiguous parts, returns number of parts */
+static uint8_t BUFFER_GetParts(BUFFER_t* Buffer, uint8_t** ptr, uint32_t* len) {
+	uint32_t Num, Out;
+	
+	Num = BUFFER_GetFull(Buffer);
+	Out = Buffer->Out;
+	if (Out >= Buffer->Size) {								/* Check output overflow */
+		Out = 0;
+	}
+	ptr[0] = &Buffer->Buffer[Out];							/* Data until end of memory */
+	len[0] = Buffer->Size - Out;
+	if (len[0] > Num) {
+		len[0] = Num;
+	}
+	ptr[1] = Buffer->Buffer;								/* Rest of data on beginning of memory */
+	len[1] = Num - len[0];
+	return len[1] ? 2 : 1;
+}
+
 int32_t BUFFER_FindElement(BUFFER_t* Buffer, uint8_t Element) {
-	uint32_t Num, Out, retval = 0;
+	uint8_t *ptr[2], *found;
+	uint32_t len[2], pos = 0;
+	uint8_t i, parts;
 	
 	if (Buffer == NULL) {									/* Check buffer structure */
 		return -1;
 	}
 	
-	Num = BUFFER_GetFull(Buffer);							/* Create temporary variables */
-	Out = Buffer->Out;
-	while (Num > 0) {										/* Go through input elements */
-		if (Out >= Buffer->Size) {							/* Check output overflow */
-			Out = 0;
-		}
-		if ((uint8_t)Buffer->Buffer[Out] == (uint8_t)Element) {	/* Check for element */
-			return retval;									/* Element found, return position in buffer */
+	parts = BUFFER_GetParts(Buffer, ptr, len);
+	for (i = 0; i < parts; i++) {							/* Check each part with fast library function */
+		found = (uint8_t *)memchr(ptr[i], Element, len[i]);
+		if (found) {
+			return pos + (found - ptr[i]);					/* Element found, return position in buffer */
 		}
-		Out++;												/* Set new variables */
-		Num--;
-		retval++;
+		pos += len[i];
 	}
 	return -1;												/* Element is not in buffer */
 }
 
 int32_t BUFFER_Find(BUFFER_t* Buffer, const void* Data, uint32_t Size) {
-	uint32_t Num, Out, i, retval = 0;
-	uint8_t found = 0;
-    uint8_t* d = (uint8_t *)Data;
-
-	if (Buffer == NULL || (Num = BUFFER_GetFull(Buffer)) < Size) {	/* Check buffer structure and number of elements in buffer */
+	uint32_t stackFail[BUFFER_FIND_STACK], *fail;
+	uint32_t len[2], pos = 0, q, j, k;
+	uint8_t *ptr[2], *p;
+	const uint8_t* d = (const uint8_t *)Data;
+	uint8_t i, parts;
+	int32_t retval = -1;
+	
+	if (Buffer == NULL || Size == 0 || BUFFER_GetFull(Buffer) < Size) {	/* Check buffer structure and number of elements in buffer */
 		return -1;
 	}
-	Out = Buffer->Out;										/* Create temporary variables */
-	while (Num > 0) {										/* Go through input elements in buffer */
-		if (Out >= Buffer->Size) {							/* Check output overflow */
-			Out = 0;
+	if (Size == 1) {
+		return BUFFER_FindElement(Buffer, d[0]);
+	}
+	
+	fail = stackFail;										/* Use stack for short sequences */
+	if (Size > BUFFER_FIND_STACK) {
+		fail = (uint32_t *) LIB_ALLOC_FUNC(Size * sizeof(uint32_t));
+		if (!fail) {
+			return -1;
 		}
-		if ((uint8_t)Buffer->Buffer[Out] == d[0]) {	        /* Check if current element in buffer matches first element in data array */
-			found = 1;
+	}
+	fail[0] = 0;											/* Length of longest proper prefix which is also suffix */
+	for (k = 0, j = 1; j < Size; j++) {
+		while (k && d[j] != d[k]) {
+			k = fail[k - 1];
 		}
-		
-		Out++;												/* Set new variables */
-		Num--;
-		retval++;
-		if (found) {										/* We have found first element */
-			i = 1;											/* First character found */
-			while (i < Size && Num > 0) {					/* Check others */	
-				if (Out >= Buffer->Size) {					/* Check output overflow */
-					Out = 0;
-				}
-				if ((uint8_t)Buffer->Buffer[Out] != d[i]) {	/* Check if current character in buffer matches character in string */
-					retval += i - 1;
+		if (d[j] == d[k]) {
+			k++;
+		}
+		fail[j] = k;
+	}
+	
+	/* Knuth-Morris-Pratt search over both parts, so sequence may wrap around memory end */
+	q = 0;
+	parts = BUFFER_GetParts(Buffer, ptr, len);
+	for (i = 0; i < parts && retval < 0; i++) {
+		for (j = 0; j < len[i]; j++) {
+			if (q == 0) {									/* Skip to first element of sequence */
+				p = (uint8_t *)memchr(&ptr[i][j], d[0], len[i] - j);
+				if (!p) {
 					break;
 				}
-				Out++;										/* Set new variables */
-				Num--;
-				i++;
+				j = p - ptr[i];
+			}
+			while (q && ptr[i][j] != d[q]) {
+				q = fail[q - 1];
 			}
-			if (i == Size) {								/* We have found data sequence in buffer */
-				return retval - 1;
+			if (ptr[i][j] == d[q]) {
+				q++;
+			}
+			if (q == Size) {								/* We have found data sequence in buffer */
+				retval = pos + j + 1 - Size;
+				break;
 			}
 		}
+		pos += len[i];
+	}
+	
+	if (fail != stackFail) {
+		LIB_FREE_FUNC(fail);
 	}
-	return -1;												/* Data sequence is not in buffer */
+	return retval;
 }
 
 uint32_t BUFFER_WriteString(BUFFER_t* Buffer, const char* buff) {
@@ -325,36 +383,30 @@ uint32_t BUFFER_WriteString(BUFFER_t* Buffer, const char* buff) {
 
 uint32_t BUFFER_ReadString(BUFFER_t* Buffer, char* buff, uint32_t buffsize) {
 	uint32_t i = 0, freeMem, fullMem;
-	uint8_t ch;
+	int32_t delimiter;
 	if (Buffer == NULL) {
 		return 0;											/* Check value buffer */
 	}
 	
 	freeMem = BUFFER_GetFree(Buffer);						/* Get free memory */
 	fullMem = BUFFER_GetFull(Buffer);						/* Get full memory */
+	delimiter = BUFFER_FindElement(Buffer, Buffer->StringDelimiter);	/* Get position of string delimiter */
 	if (													/* Check for any data in buffer */
 		fullMem == 0 ||                                 	/* Buffer empty */
 		(
-			BUFFER_FindElement(Buffer, Buffer->StringDelimiter) < 0 && 	/* String delimiter is not in buffer */
+			delimiter < 0 && 								/* String delimiter is not in buffer */
 			freeMem != 0 &&                                 /* Buffer is not full */
 			fullMem < buffsize                              /* User buffer size is larger than number of elements in buffer */
 		)
 	) {
 		return 0;											/* Return with no elements read */
 	}
-	while (i < (buffsize - 1)) {							/* If available buffer size is more than 0 characters */
-		BUFFER_Read(Buffer, &ch, 1);						/* We have available data */
-		buff[i] = (char)ch;									/* Save character */
-		if ((char)buff[i] == (char)Buffer->StringDelimiter) {	/* Check for end of string */
-			break;											/* Done */
-		}
-		i++;												/* Increase */
-	}
-	if (i == (buffsize - 1)) {								/* Add zero to the end of string */
-		buff[i] = 0;
-	} else {
-		buff[++i] = 0;
+	i = delimiter < 0 ? fullMem : (uint32_t)delimiter + 1;	/* Read until delimiter including it */
+	if (i > (buffsize - 1)) {								/* Check user buffer size */
+		i = buffsize - 1;
 	}
+	i = BUFFER_Read(Buffer, buff, i);						/* Read all characters at once */
+	buff[i] = 0;											/* Add zero to the end of string */
 	return i;												/* Return number of characters in buffer */
 }
 
@@ -379,3 +431,131 @@ int8_t BUFFER_CheckElement(BUFFER_t* Buffer, uint32_t pos, uint8_t* element) {
 	}
 	return 0;												/* Return zero */
 }
+
+uint8_t BUFFER_SPSC_Init(BUFFER_SPSC_t* Buffer, uint32_t Size, void* BufferPtr) {
+	if (Buffer == NULL || Size == 0 || (Size & (Size - 1))) {	/* Check buffer structure and size */
+		return 1;
+	}
+	memset(Buffer, 0, sizeof(BUFFER_SPSC_t));				/* Set buffer values to all zeros */
+	
+	Buffer->Mask = Size - 1;
+	Buffer->Buffer = BufferPtr;
+	if (!Buffer->Buffer) {									/* Check if malloc should be used */
+		Buffer->Buffer = (uint8_t *) LIB_ALLOC_FUNC(Size * sizeof(uint8_t));
+		if (!Buffer->Buffer) {
+			Buffer->Mask = 0;
+			return 1;
+		}
+		Buffer->Flags |= BUFFER_MALLOC;
+	}
+	Buffer->Flags |= BUFFER_INITIALIZED;					/* We are initialized */
+	
+	return 0;
+}
+
+void BUFFER_SPSC_Free(BUFFER_SPSC_t* Buffer) {
+	if (Buffer == NULL) {									/* Check buffer structure */
+		return;
+	}
+	if (Buffer->Flags & BUFFER_MALLOC) {					/* If malloc was used for allocation */
+		LIB_FREE_FUNC(Buffer->Buffer);
+	}
+	Buffer->Flags = 0;
+	Buffer->Mask = 0;
+}
+
+uint32_t BUFFER_SPSC_Write(BUFFER_SPSC_t* Buffer, const void* Data, uint32_t count) {
+	uint32_t free, in, tocopy;
+	const uint8_t* d = (const uint8_t *)Data;
+	
+	free = BUFFER_SPSC_GetFree(Buffer);						/* Get free memory */
+	if (count > free) {
+		count = free;
+	}
+	if (!count) {
+		return 0;
+	}
+	in = Buffer->In & Buffer->Mask;
+	tocopy = Buffer->Mask + 1 - in;							/* Memory until end of array */
+	if (tocopy > count) {
+		tocopy = count;
+	}
+	memcpy(&Buffer->Buffer[in], d, tocopy);
+	if (count > tocopy) {									/* Continue on beginning */
+		memcpy(Buffer->Buffer, &d[tocopy], count - tocopy);
+	}
+	BUFFER_SPSC_Commit(Buffer, count);
+	return count;
+}
+
+uint32_t BUFFER_SPSC_Read(BUFFER_SPSC_t* Buffer, void* Data, uint32_t count) {
+	uint32_t full, out, tocopy;
+	uint8_t* d = (uint8_t *)Data;
+	
+	full = BUFFER_SPSC_GetFull(Buffer);						/* Get number of elements */
+	if (count > full) {
+		count = full;
+	}
+	if (!count) {
+		return 0;
+	}
+	out = Buffer->Out & Buffer->Mask;
+	tocopy = Buffer->Mask + 1 - out;						/* Data until end of array */
+	if (tocopy > count) {
+		tocopy = count;
+	}
+	memcpy(d, &Buffer->Buffer[out], tocopy);
+	if (count > tocopy) {									/* Continue on beginning */
+		memcpy(&d[tocopy], Buffer->Buffer, count - tocopy);
+	}
+	BUFFER_SPSC_Consume(Buffer, count);
+	return count;
+}
+
+uint32_t BUFFER_SPSC_GetFree(BUFFER_SPSC_t* Buffer) {
+	if (Buffer == NULL || !Buffer->Buffer) {				/* Check buffer structure */
+		return 0;
+	}
+	return Buffer->Mask + 1 - (Buffer->In - BUFFER_LoadAcquire(&Buffer->Out));
+}
+
+uint32_t BUFFER_SPSC_GetFull(BUFFER_SPSC_t* Buffer) {
+	if (Buffer == NULL || !Buffer->Buffer) {				/* Check buffer structure */
+		return 0;
+	}
+	return BUFFER_LoadAcquire(&Buffer->In) - Buffer->Out;
+}
+
+uint32_t BUFFER_SPSC_Reserve(BUFFER_SPSC_t* Buffer, void** Data) {
+	uint32_t in, free, tocopy;
+	
+	free = BUFFER_SPSC_GetFree(Buffer);
+	if (!free) {
+		return 0;
+	}
+	in = Buffer->In & Buffer->Mask;
+	tocopy = Buffer->Mask + 1 - in;							/* Memory until end of array */
+	*Data = &Buffer->Buffer[in];
+	return tocopy < free ? tocopy : free;
+}
+
+void BUFFER_SPSC_Commit(BUFFER_SPSC_t* Buffer, uint32_t count) {
+	BUFFER_StoreRelease(&Buffer->In, Buffer->In + count);	/* Data must be written before index */
+}
+
+uint32_t BUFFER_SPSC_Peek(BUFFER_SPSC_t* Buffer, const void** Data) {
+	uint32_t out, full, tocopy;
+	
+	full = BUFFER_SPSC_GetFull(Buffer);
+	if (!full) {
+		return 0;
+	}
+	out = Buffer->Out & Buffer->Mask;
+	tocopy = Buffer->Mask + 1 - out;						/* Data until end of array */
+	*Data = &Buffer->Buffer[out];
+	return tocopy < full ? tocopy : full;
+}
+
+void BUFFER_SPSC_Consume(BUFFER_SPSC_t* Buffer, uint32_t count) {
+	BUFFER_StoreRelease(&Buffer->Out, Buffer->Out + count);	/* Data must be read before memory is released */
+}
@@ -97,6 +97,11 @@ extern "C" {
 #define BUFFER_FAST            1
 #endif
 
+/* Maximal sequence length for BUFFER_Find without heap allocation */
+#ifndef BUFFER_FIND_STACK
+#define BUFFER_FIND_STACK      32
+#endif
+
 /**
  * \}
  */
@@ -120,6 +125,19 @@ typedef struct _BUFFER_t {
 	void* UserParameters;    /*!< Pointer to user value if needed */
 } BUFFER_t;
 
+/**
+ * \brief  Single producer single consumer buffer structure
+ * \note   Producer and consumer may run in different threads or interrupts without locking.
+ *           Index values count all elements ever written and read and are masked on access.
+ */
+typedef struct _BUFFER_SPSC_t {
+	volatile uint32_t In;    /*!< Number of written elements, changed by producer only */
+	volatile uint32_t Out;   /*!< Number of read elements, changed by consumer only */
+	uint32_t Mask;           /*!< Buffer size minus one, size is power of 2 */
+	uint8_t* Buffer;         /*!< Pointer to buffer data array */
+	uint8_t Flags;           /*!< Flags for buffer */
+} BUFFER_SPSC_t;
+
 /**
  * \}
  */
@@ -258,6 +276,93 @@ uint32_t BUFFER_ReadString(BUFFER_t* Buffer, char* buff, uint32_t buffsize);
  */
 int8_t BUFFER_CheckElement(BUFFER_t* Buffer, uint32_t pos, uint8_t* element);
 
+/**
+ * \brief  Initializes single producer single consumer buffer
+ * \note   Whole buffer size can be used for data, unlike \ref BUFFER_t
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure to initialize
+ * \param  Size: Size of buffer in units of bytes, must be power of 2
+ * \param  *BufferPtr: Pointer to array for buffer storage or NULL to allocate memory on heap
+ * \retval Buffer initialization status:
+ *            - 0: Buffer initialized OK
+ *            - > 0: Size is not power of 2 or allocation failed
+ */
+uint8_t BUFFER_SPSC_Init(BUFFER_SPSC_t* Buffer, uint32_t Size, void* BufferPtr);
+
+/**
+ * \brief  Free memory for buffer allocated using \ref malloc
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \retval None
+ */
+void BUFFER_SPSC_Free(BUFFER_SPSC_t* Buffer);
+
+/**
+ * \brief  Writes data to buffer, call from producer only
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \param  *Data: Pointer to data to be written
+ * \param  count: Number of bytes to write
+ * \retval Number of bytes written to buffer
+ */
+uint32_t BUFFER_SPSC_Write(BUFFER_SPSC_t* Buffer, const void* Data, uint32_t count);
+
+/**
+ * \brief  Reads data from buffer, call from consumer only
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \param  *Data: Pointer to save read data to
+ * \param  count: Number of bytes to read
+ * \retval Number of bytes read from buffer
+ */
+uint32_t BUFFER_SPSC_Read(BUFFER_SPSC_t* Buffer, void* Data, uint32_t count);
+
+/**
+ * \brief  Gets number of free bytes in buffer
+ * \note   Value is exact for producer, consumer may only see less than actual
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \retval Number of free bytes
+ */
+uint32_t BUFFER_SPSC_GetFree(BUFFER_SPSC_t* Buffer);
+
+/**
+ * \brief  Gets number of bytes in buffer
+ * \note   Value is exact for consumer, producer may only see more than actual
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \retval Number of bytes in buffer
+ */
+uint32_t BUFFER_SPSC_GetFull(BUFFER_SPSC_t* Buffer);
+
+/**
+ * \brief  Gets contiguous free memory to write data directly, call from producer only
+ * \note   Data are visible to consumer after \ref BUFFER_SPSC_Commit
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \param  **Data: Pointer to save start of free memory to
+ * \retval Number of bytes available at returned address
+ */
+uint32_t BUFFER_SPSC_Reserve(BUFFER_SPSC_t* Buffer, void** Data);
+
+/**
+ * \brief  Adds bytes written to reserved memory to buffer, call from producer only
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \param  count: Number of bytes written, not more than reserved
+ * \retval None
+ */
+void BUFFER_SPSC_Commit(BUFFER_SPSC_t* Buffer, uint32_t count);
+
+/**
+ * \brief  Gets contiguous memory with data to read it directly, call from consumer only
+ * \note   Memory stays valid until \ref BUFFER_SPSC_Consume
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \param  **Data: Pointer to save start of data to
+ * \retval Number of bytes available at returned address
+ */
+uint32_t BUFFER_SPSC_Peek(BUFFER_SPSC_t* Buffer, const void** Data);
+
+/**
+ * \brief  Removes bytes from buffer after they were processed, call from consumer only
+ * \param  *Buffer: Pointer to \ref BUFFER_SPSC_t structure
+ * \param  count: Number of bytes to remove, not more than peeked
+ * \retval None
+ */
+void BUFFER_SPSC_Consume(BUFFER_SPSC_t* Buffer, uint32_t count);
+
 /**
  * \}
  */
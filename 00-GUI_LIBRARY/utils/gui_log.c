@@ -0,0 +1,205 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_log.h"
+#include "gui.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#if GUI_LOG_BUFFER_SIZE & (GUI_LOG_BUFFER_SIZE - 1)
+#error "GUI_LOG_BUFFER_SIZE must be power of 2"
+#endif
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static uint8_t LogData[GUI_LOG_BUFFER_SIZE];
+static BUFFER_SPSC_t Log = {0, 0, GUI_LOG_BUFFER_SIZE - 1, LogData, BUFFER_INITIALIZED};    /* Ready before GUI_Init */
+static GUI_LOG_Send_t Send;                 /* Output send function */
+static GUI_LOG_Busy_t Busy;                 /* Output busy check function */
+static uint32_t Sending;                    /* Number of bytes given to output and not yet released */
+static uint8_t Level = GUI_LOG_LEVEL;       /* Runtime level */
+static uint32_t Unreported;                 /* Number of dropped messages not yet reported */
+static GUI_LOG_Stats_t Stats;
+static const char Levels[] = " EWID";       /* Level characters in message prefix */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Write complete message to buffer or drop it */
+static uint8_t __Put(const void* data, uint32_t count) {
+    char line[32];
+    int len;
+    
+    if (Unreported) {                       /* Report dropped messages before new ones */
+        len = snprintf(line, sizeof(line), "%u W: %u messages dropped\r\n", (unsigned)GUI.Time, (unsigned)Unreported);
+        if (len > 0 && len < (int)sizeof(line) && BUFFER_SPSC_GetFree(&Log) >= (uint32_t)len + count) {
+            BUFFER_SPSC_Write(&Log, line, len);
+            Unreported = 0;
+        } else {
+            Unreported++;
+            Stats.Dropped++;
+            return 0;
+        }
+    } else if (BUFFER_SPSC_GetFree(&Log) < count) {
+        Unreported++;
+        Stats.Dropped++;
+        return 0;
+    }
+    BUFFER_SPSC_Write(&Log, data, count);
+    Stats.Written++;
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void GUI_LOG_SetOutput(GUI_LOG_Send_t send, GUI_LOG_Busy_t busy) {
+    Busy = busy;
+    Send = send;
+}
+
+void GUI_LOG_SetLevel(uint8_t level) {
+    Level = level;
+}
+
+void GUI_LOG_Printf(uint8_t level, const char* fmt, ...) {
+    va_list args;
+    
+    va_start(args, fmt);
+    GUI_LOG_VPrintf(level, fmt, args);
+    va_end(args);
+}
+
+void GUI_LOG_VPrintf(uint8_t level, const char* fmt, va_list args) {
+    char line[GUI_LOG_LINE_SIZE];
+    int len, n;
+    
+    if (!level || level > Level || level > GUI_LOG_LEVEL_DEBUG) {
+        return;
+    }
+    len = snprintf(line, sizeof(line), "%u %c: ", (unsigned)GUI.Time, Levels[level]);
+    if (len < 0 || len >= (int)sizeof(line)) {
+        return;
+    }
+    n = vsnprintf(&line[len], sizeof(line) - len, fmt, args);
+    if (n < 0) {
+        return;
+    }
+    len += n;
+    if (len >= (int)sizeof(line)) {         /* Message was truncated, keep line end */
+        len = sizeof(line) - 1;
+        line[len - 2] = '\r';
+        line[len - 1] = '\n';
+    }
+    __Put(line, len);
+}
+
+uint8_t GUI_LOG_Write(uint8_t level, const void* data, uint32_t count) {
+    if (!level || level > Level || !data || !count) {
+        return 0;
+    }
+    return __Put(data, count);
+}
+
+uint8_t __GUI_LOG_RateCheck(GUI_LOG_Rate_t* rate, uint8_t level, uint32_t interval) {
+    if (!level || level > Level) {
+        return 0;
+    }
+    if (rate->Used && (GUI.Time - rate->Last) < interval) {
+        if (rate->Skipped < 0xFFFF) {
+            rate->Skipped++;
+        }
+        Stats.Skipped++;
+        return 0;
+    }
+    if (rate->Skipped) {                    /* Tell how many messages were not written */
+        GUI_LOG_Printf(level, "%u similar messages skipped\r\n", (unsigned)rate->Skipped);
+        rate->Skipped = 0;
+    }
+    rate->Used = 1;
+    rate->Last = GUI.Time;
+    return 1;
+}
+
+void GUI_LOG_Process(void) {
+    const void* data;
+    uint32_t count;
+    
+    if (!Send) {
+        return;
+    }
+    while (1) {
+        if (Sending) {                      /* Release memory after output is done with it */
+            if (Busy && Busy()) {
+                return;
+            }
+            BUFFER_SPSC_Consume(&Log, Sending);
+            Stats.Sent += Sending;
+            Sending = 0;
+        }
+        count = BUFFER_SPSC_Peek(&Log, &data);  /* Get linear block, second part after wrap follows in next loop */
+        if (!count) {
+            return;
+        }
+        Sending = Send(data, count);
+        if (!Sending) {                     /* Output not ready */
+            return;
+        }
+    }
+}
+
+void GUI_LOG_Flush(void) {
+    if (!Send) {
+        return;
+    }
+    do {
+        GUI_LOG_Process();
+    } while (Sending || BUFFER_SPSC_GetFull(&Log));
+}
+
+void GUI_LOG_GetStats(GUI_LOG_Stats_t* stats, uint8_t reset) {
+    if (stats) {
+        *stats = Stats;
+    }
+    if (reset) {
+        memset(&Stats, 0x00, sizeof(Stats));
+    }
+}
@@ -0,0 +1,273 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI non-blocking log output
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_LOG_H
+#define GUI_LOG_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "stdint.h"
+#include "stdarg.h"
+
+/**
+ * \defgroup      GUI_LOG
+ * \brief         Non-blocking log output
+ *
+ * Log functions only format message and copy it to ring buffer, they never wait for output.
+ * Buffer is sent in background by \ref GUI_LOG_Process in as large blocks as possible,
+ * for example with single DMA transfer per block.
+ *
+ * Messages are written by GUI thread and ring is emptied by \ref GUI_LOG_Process.
+ * Both sides may run in different threads or interrupts, but there must be only one of each.
+ * When buffer is full, complete messages are dropped and number of dropped messages
+ * is reported in output as soon as there is memory again.
+ *
+ * Set \ref GUI_LOG_LEVEL to \ref GUI_LOG_LEVEL_NONE to remove all log calls and strings from code.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_LOG_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+#define GUI_LOG_LEVEL_NONE          0       /*!< Log is disabled */
+#define GUI_LOG_LEVEL_ERROR         1       /*!< Errors only */
+#define GUI_LOG_LEVEL_WARNING       2       /*!< Errors and warnings */
+#define GUI_LOG_LEVEL_INFO          3       /*!< Errors, warnings and informations */
+#define GUI_LOG_LEVEL_DEBUG         4       /*!< All messages */
+
+/**
+ * \brief         Highest level compiled into code
+ * \note          Messages with higher level are removed by compiler
+ */
+#ifndef GUI_LOG_LEVEL
+#define GUI_LOG_LEVEL               GUI_LOG_LEVEL_DEBUG
+#endif
+
+/**
+ * \brief         Size of log ring buffer in units of bytes
+ * \note          Must be power of 2
+ */
+#ifndef GUI_LOG_BUFFER_SIZE
+#define GUI_LOG_BUFFER_SIZE         1024
+#endif
+
+/**
+ * \brief         Maximal length of single formatted message, longer messages are truncated
+ * \note          Message is formatted on stack before it is copied to buffer
+ */
+#ifndef GUI_LOG_LINE_SIZE
+#define GUI_LOG_LINE_SIZE           96
+#endif
+
+#if GUI_LOG_LEVEL > GUI_LOG_LEVEL_NONE
+/**
+ * \brief         Write formatted message if level is enabled
+ * \param[in]     level: Message level, one of GUI_LOG_LEVEL_x values
+ * \param[in]     fmt: Format string, followed by arguments
+ */
+#define GUI_LOG(level, fmt, ...)    do {                \
+    if ((level) <= GUI_LOG_LEVEL) {                     \
+        GUI_LOG_Printf((level), fmt, ##__VA_ARGS__);    \
+    }                                                   \
+} while (0)
+
+/**
+ * \brief         Write formatted message at most once per interval from this line of code
+ * \note          Skipped messages are counted and number is written with next message
+ * \param[in]     level: Message level, one of GUI_LOG_LEVEL_x values
+ * \param[in]     interval: Minimal time between 2 messages in units of milliseconds
+ * \param[in]     fmt: Format string, followed by arguments
+ */
+#define GUI_LOG_RATE(level, interval, fmt, ...) do {    \
+    if ((level) <= GUI_LOG_LEVEL) {                     \
+        static GUI_LOG_Rate_t __rate;                   \
+        if (__GUI_LOG_RateCheck(&__rate, (level), (interval))) {    \
+            GUI_LOG_Printf((level), fmt, ##__VA_ARGS__);    \
+        }                                               \
+    }                                                   \
+} while (0)
+#else
+#define GUI_LOG(level, fmt, ...)                do { } while (0)
+#define GUI_LOG_RATE(level, interval, fmt, ...) do { } while (0)
+#endif
+
+#define GUI_LOG_ERROR(fmt, ...)     GUI_LOG(GUI_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define GUI_LOG_WARNING(fmt, ...)   GUI_LOG(GUI_LOG_LEVEL_WARNING, fmt, ##__VA_ARGS__)
+#define GUI_LOG_INFO(fmt, ...)      GUI_LOG(GUI_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define GUI_LOG_DEBUG(fmt, ...)     GUI_LOG(GUI_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_LOG_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Function to start sending block of log data
+ * \note          Data stay valid and unchanged until \ref GUI_LOG_Busy_t returns 0
+ * \param[in]     data: Pointer to data to send
+ * \param[in]     count: Number of bytes available to send
+ * \retval        Number of bytes accepted for sending, 0 if output is not ready
+ */
+typedef uint32_t (*GUI_LOG_Send_t)(const void* data, uint32_t count);
+
+/**
+ * \brief         Function to check if last block is still being sent
+ * \retval        1: Output is still using data
+ * \retval        0: Output is done with data
+ */
+typedef uint8_t (*GUI_LOG_Busy_t)(void);
+
+/**
+ * \brief         Rate limit state for single message
+ */
+typedef struct GUI_LOG_Rate_t {
+    uint32_t Last;                          /*!< Time of last written message */
+    uint16_t Skipped;                       /*!< Number of skipped messages since last written */
+    uint8_t Used;                           /*!< Message was already written */
+} GUI_LOG_Rate_t;
+
+/**
+ * \brief         Log statistics
+ */
+typedef struct GUI_LOG_Stats_t {
+    uint32_t Written;                       /*!< Number of messages written to buffer */
+    uint32_t Dropped;                       /*!< Number of messages dropped because of full buffer */
+    uint32_t Skipped;                       /*!< Number of messages skipped by rate limit */
+    uint32_t Sent;                          /*!< Number of bytes sent to output */
+} GUI_LOG_Stats_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_LOG_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+/**
+ * \brief         Set function to send log data
+ * \param[in]     send: Function to start sending block of data
+ * \param[in]     busy: Function to check if sending is in progress.
+ *                   Set to NULL when send function is blocking and data are sent on return
+ */
+void GUI_LOG_SetOutput(GUI_LOG_Send_t send, GUI_LOG_Busy_t busy);
+
+/**
+ * \brief         Set highest level of messages written to buffer at runtime
+ * \note          Levels above \ref GUI_LOG_LEVEL are removed at compile time
+ * \param[in]     level: One of GUI_LOG_LEVEL_x values
+ */
+void GUI_LOG_SetLevel(uint8_t level);
+
+/**
+ * \brief         Write formatted message to log buffer
+ * \note          Message is prefixed with GUI time and level character
+ * \param[in]     level: Message level, one of GUI_LOG_LEVEL_x values
+ * \param[in]     fmt: Format string, followed by arguments
+ */
+void GUI_LOG_Printf(uint8_t level, const char* fmt, ...);
+
+/**
+ * \brief         Write formatted message to log buffer with argument list
+ * \param[in]     level: Message level, one of GUI_LOG_LEVEL_x values
+ * \param[in]     fmt: Format string
+ * \param[in]     args: Argument list
+ */
+void GUI_LOG_VPrintf(uint8_t level, const char* fmt, va_list args);
+
+/**
+ * \brief         Write raw data to log buffer without formatting and prefix
+ * \note          Data are written completely or not at all
+ * \param[in]     level: Message level, one of GUI_LOG_LEVEL_x values
+ * \param[in]     data: Pointer to data
+ * \param[in]     count: Number of bytes to write
+ * \retval        1: Data were written
+ * \retval        0: Level is disabled or there is not enough memory
+ */
+uint8_t GUI_LOG_Write(uint8_t level, const void* data, uint32_t count);
+
+/**
+ * \brief         Send next block of buffered data when output is ready
+ * \note          Called from \ref GUI_Process, can be called from elsewhere to empty buffer faster
+ */
+void GUI_LOG_Process(void);
+
+/**
+ * \brief         Send all buffered data and wait for output to finish
+ * \note          Blocks until buffer is empty, use only before reset or in fault handlers
+ */
+void GUI_LOG_Flush(void);
+
+/**
+ * \brief         Get log statistics
+ * \param[out]    stats: Pointer to \ref GUI_LOG_Stats_t structure to fill
+ * \param[in]     reset: Set to 1 to reset counters after read
+ */
+void GUI_LOG_GetStats(GUI_LOG_Stats_t* stats, uint8_t reset);
+
+uint8_t __GUI_LOG_RateCheck(GUI_LOG_Rate_t* rate, uint8_t level, uint32_t interval);
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -92,8 +92,8 @@ static void __Draw(GUI_Display_t* disp, void* ptr) {
         GUI_DRAW_FilledRectangle(disp, x, y, b->C.Width, b->C.Height, c1);
         GUI_DRAW_Rectangle3D(disp, x, y, b->C.Width, b->C.Height, h->Flags & GUI_FLAG_ACTIVE ? GUI_DRAW_3D_State_Lowered : GUI_DRAW_3D_State_Raised);
     } else {
-        GUI_DRAW_FilledRoundedRectangle(disp, x, y, b->C.Width, b->C.Height, b->BorderRadius, c1);
-        GUI_DRAW_RoundedRectangle(disp, x, y, b->C.Width, b->C.Height, b->BorderRadius, c2);
+        GUI_DRAW_FilledRoundedRectangleAA(disp, x, y, b->C.Width, b->C.Height, b->BorderRadius, c1);
+        GUI_DRAW_RoundedRectangleAA(disp, x, y, b->C.Width, b->C.Height, b->BorderRadius, c2);
     }
     
     /* Draw text if possible */
@@ -117,8 +117,8 @@ static GUI_iDim_t tX, tY;
 /* Process touch check */
 static __GUI_TouchStatus_t __TouchDown(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
     /* Get X and Y positions relative on widget */
-    tX = ts->X - __GUI_WIDGET_GetAbsoluteX(ptr);
-    tY = ts->Y - __GUI_WIDGET_GetAbsoluteY(ptr);
+    tX = ts->X[0] - __GUI_WIDGET_GetAbsoluteX(ptr);
+    tY = ts->Y[0] - __GUI_WIDGET_GetAbsoluteY(ptr);
     
     return touchHANDLED;
 }
@@ -130,7 +130,7 @@ static __GUI_TouchStatus_t __TouchMove(void* ptr, GUI_TouchData_t* ts, __GUI_Tou
     x = __GUI_WIDGET_GetAbsoluteX(h->Parent);
     y = __GUI_WIDGET_GetAbsoluteY(h->Parent);
     
-    __GUI_WIDGET_SetXY(h, ts->X - x - tX, ts->Y - y - tY);
+    __GUI_WIDGET_SetXY(h, ts->X[0] - x - tX, ts->Y[0] - y - tY);
     
     return touchHANDLED;
 }
@@ -95,6 +95,7 @@ typedef struct GUI_BUTTON_t {
 /**
  * \brief           Initializes button widget
  * \note            This function should not be called by user
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
  */
 GUI_HANDLE_t GUI_BUTTON_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height);
 void GUI_BUTTON_Remove(GUI_HANDLE_t* ptr);
@@ -111,6 +111,10 @@ typedef struct GUI_GRAPH_t {
  * \{
  */
 
+/**
+ * \brief           Create graph widget
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
 GUI_HANDLE_t GUI_GRAPH_Create(GUI_ID_t id, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height);
 void GUI_GRAPH_Remove(GUI_HANDLE_t* h);
 
@@ -0,0 +1,126 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_image.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GI(x)             ((GUI_IMAGE_t *)(x))
+
+static void __Draw(GUI_Display_t* disp, void* ptr);
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+const static GUI_WIDGET_t Widget = {
+    {
+        "IMAGE",                                    /*!< Widget name */
+        sizeof(GUI_IMAGE_t),                        /*!< Size of widget for memory allocation */
+        0,                                          /*!< Allow children objects on widget */
+    },
+    __Draw,                                         /*!< Widget draw function */
+    {
+        0, 0, 0
+    }
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+static void __Draw(GUI_Display_t* disp, void* ptr) {
+    GUI_Display_t clip;
+    GUI_Dim_t x, y;
+    
+    if (!__GI(ptr)->Image) {
+        return;
+    }
+    x = __GUI_WIDGET_GetAbsoluteX(ptr);
+    y = __GUI_WIDGET_GetAbsoluteY(ptr);
+    
+    clip.X1 = disp->X1 > x ? disp->X1 : x;          /* Image bigger than widget must not be drawn outside */
+    clip.Y1 = disp->Y1 > y ? disp->Y1 : y;
+    clip.X2 = disp->X2 < (x + __GH(ptr)->Width) ? disp->X2 : (x + __GH(ptr)->Width);
+    clip.Y2 = disp->Y2 < (y + __GH(ptr)->Height) ? disp->Y2 : (y + __GH(ptr)->Height);
+    if (clip.X1 >= clip.X2 || clip.Y1 >= clip.Y2) {
+        return;
+    }
+    GUI_DRAW_Image(&clip, x, y, __GI(ptr)->Image);  /* Image is drawn at top left corner of widget */
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_HANDLE_t GUI_IMAGE_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height) {
+    GUI_IMAGE_t* ptr;
+    
+    __GUI_ASSERTACTIVEWIN();                        /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ptr = (GUI_IMAGE_t *)__GUI_WIDGET_Create(&Widget, id, x, y, width, height); /* Allocate memory for basic widget */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    
+    return (GUI_HANDLE_t)ptr;
+}
+
+void GUI_IMAGE_Remove(GUI_HANDLE_t* h) {
+    __GUI_ASSERTPARAMSVOID(h && *h);                /* Check parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+
+    __GUI_WIDGET_Remove(h);                         /* Remove widget */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+}
+
+GUI_HANDLE_t GUI_IMAGE_SetSource(GUI_HANDLE_t h, const GUI_IMAGE_DESC_t* img) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GI(h)->Image != img) {                    /* Any parameter changed */
+        __GI(h)->Image = img;                       /* Set parameter */
+        __GUI_WIDGET_SetOpaque(h, img &&            /* Image without transparency covering complete widget */
+            img->Format == GUI_IMAGE_FORMAT_RGB565 &&   /* JPEG decoding can fail, background must be drawn then */
+            img->xSize >= h->Width && img->ySize >= h->Height);
+        __GUI_WIDGET_InvalidateWithParent(h);       /* Redraw object, new image may not cover whole widget */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
@@ -0,0 +1,99 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI image widget
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_IMAGE_H
+#define GUI_IMAGE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_WIDGETS
+ * \{
+ */
+#include "gui_widget.h"
+
+/**
+ * \defgroup        GUI_IMAGE
+ */
+ 
+/**
+ * \defgroup        GUI_IMAGE_Typedefs
+ * \brief           Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief           Image structure
+ */
+typedef struct GUI_IMAGE_t {
+    GUI_HANDLE C;                           /*!< Global widget object */
+    const GUI_IMAGE_DESC_t* Image;          /*!< Pointer to image description */
+} GUI_IMAGE_t;
+
+/**
+ * \} GUI_IMAGE_Typedefs
+ */
+
+/**
+ * \defgroup        GUI_IMAGE_Functions
+ * \brief           Library Functions
+ * \{
+ */
+
+/**
+ * \brief           Create image widget
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
+GUI_HANDLE_t GUI_IMAGE_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height);
+void GUI_IMAGE_Remove(GUI_HANDLE_t* h);
+GUI_HANDLE_t GUI_IMAGE_SetSource(GUI_HANDLE_t h, const GUI_IMAGE_DESC_t* img);
+
+/**
+ * \} GUI_IMAGE_Functions
+ */
+ 
+/**
+ * \} GUI_IMAGE
+ */
+
+/**
+ * \} GUI
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -84,8 +84,8 @@ static void __Draw(GUI_Display_t* disp, void* ptr) {
         GUI_DRAW_FilledRectangle(disp, x + 1, y + 1, __GH(ptr)->Width - 2, __GH(ptr)->Height - 2, c1);
         GUI_DRAW_Rectangle(disp, x, y, __GH(ptr)->Width, __GH(ptr)->Height, c2);
     } else {
-        GUI_DRAW_FilledCircle(disp, x + __GH(ptr)->Width / 2, y + __GH(ptr)->Height / 2, __GH(ptr)->Width / 2, c1);
-        GUI_DRAW_Circle(disp, x + __GH(ptr)->Width / 2, y + __GH(ptr)->Height / 2, __GH(ptr)->Width / 2, c2);
+        GUI_DRAW_FilledCircleAA(disp, x + __GH(ptr)->Width / 2, y + __GH(ptr)->Height / 2, __GH(ptr)->Width / 2, c1);
+        GUI_DRAW_CircleAA(disp, x + __GH(ptr)->Width / 2, y + __GH(ptr)->Height / 2, __GH(ptr)->Width / 2, c2);
     }
 }
 
@@ -103,6 +103,10 @@ typedef struct GUI_LED_t {
  * \{
  */
 
+/**
+ * \brief           Create LED widget
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
 GUI_HANDLE_t GUI_LED_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height);
 void GUI_LED_Remove(GUI_HANDLE_t* h);
 GUI_HANDLE_t GUI_LED_SetColor(GUI_HANDLE_t h, GUI_LED_COLOR_t index, GUI_Color_t color);
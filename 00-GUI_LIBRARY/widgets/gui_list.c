@@ -0,0 +1,251 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_list.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Row widget, reused for rows scrolled into view */
+typedef struct GUI_LIST_ROW_t {
+    GUI_HANDLE C;                           /* GUI handle object, must always be first on list */
+    uint32_t Row;                           /* Row of data currently shown */
+} GUI_LIST_ROW_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GL(x)             ((GUI_LIST_t *)GUI_SCROLL_GetParam(x))
+#define __GR(x)             ((GUI_LIST_ROW_t *)(x))
+
+static void __Draw(GUI_Display_t* disp, void* ptr);
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+const static GUI_WIDGET_t Widget = {
+    {
+        "LISTROW",                                  /*!< Widget name */
+        sizeof(GUI_LIST_ROW_t),                     /*!< Size of widget for memory allocation */
+        0,                                          /*!< Allow children objects on widget */
+    },
+    __Draw,                                         /*!< Widget draw function */
+    {
+        0, 0, 0
+    }
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Draw single row with all cells */
+static void __Draw(GUI_Display_t* disp, void* ptr) {
+    GUI_HANDLE_t list = __GH(ptr)->Parent;
+    GUI_LIST_t* l = __GL(list);
+    GUI_DRAW_FONT_t f;
+    GUI_Dim_t x, y, cx, width;
+    const char* text;
+    uint8_t i;
+    
+    x = __GUI_WIDGET_GetAbsoluteX(ptr);             /* Get absolute X coordinate */
+    y = __GUI_WIDGET_GetAbsoluteY(ptr);             /* Get absolute Y coordinate */
+    
+    GUI_DRAW_FilledRectangle(disp, x, y, __GH(ptr)->Width, __GH(ptr)->Height, l->Color[__GR(ptr)->Row & 1 ? GUI_LIST_COLOR_BG_ALT : GUI_LIST_COLOR_BG]);
+    
+    for (i = 0, cx = x; i < l->ColumnsCount && cx < (x + __GH(ptr)->Width); i++, cx += width) {
+        width = l->Columns[i];
+        if ((cx + width) > (x + __GH(ptr)->Width)) {   /* Last visible column */
+            width = x + __GH(ptr)->Width - cx;
+        }
+        if (disp->X1 >= (cx + width) || disp->X2 <= cx) {   /* Cell is outside clipping region */
+            continue;
+        }
+        
+        if (l->Provider->DrawCell) {                /* Cell is drawn by provider */
+            l->Provider->DrawCell(list, disp, __GR(ptr)->Row, i, cx, y, width, __GH(ptr)->Height);
+        } else if (l->Provider->GetText && list->Font) {
+            text = l->Provider->GetText(list, __GR(ptr)->Row, i);
+            if (text && *text) {
+                memset((void *)&f, 0x00, sizeof(f));    /* Reset structure */
+                
+                f.X = cx + 2;
+                f.Y = y;
+                f.Width = width > 4 ? width - 4 : width;
+                f.Height = __GH(ptr)->Height;
+                f.Align = GUI_HALIGN_LEFT | GUI_VALIGN_CENTER;
+                f.Color1Width = f.Width;
+                f.Color1 = l->Color[GUI_LIST_COLOR_TEXT];
+                GUI_DRAW_WriteText(disp, list->Font, text, &f);
+            }
+        }
+    }
+}
+
+/* Create row widget for scroll view */
+static GUI_HANDLE_t __CreateRow(GUI_HANDLE_t h, uint8_t row) {
+    GUI_LIST_ROW_t* ptr;
+    
+    ptr = (GUI_LIST_ROW_t *)__GUI_WIDGET_Create(&Widget, 0, 0, 0, h->Width, 1); /* Size is set by scroll view */
+    if (ptr) {
+        ptr->Row = 0;
+    }
+    return (GUI_HANDLE_t)ptr;
+}
+
+/* Free list data when scroll view is removed */
+static void __Release(GUI_HANDLE_t h) {
+    __GUI_MEMFREE(__GL(h));
+}
+
+/* Show new row of data in row widget */
+static void __BindRow(GUI_HANDLE_t h, GUI_HANDLE_t row, uint32_t item) {
+    __GR(row)->Row = item;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_HANDLE_t GUI_LIST_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t rowHeight, const GUI_LIST_PROVIDER_t* provider) {
+    GUI_HANDLE_t h = 0;
+    GUI_LIST_t* l;
+    
+    __GUI_ASSERTPARAMS(provider && provider->GetCount && rowHeight);  /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    l = (GUI_LIST_t *)__GUI_MEMALLOC(sizeof(GUI_LIST_t));   /* Allocate memory for list data */
+    if (l) {
+        h = GUI_SCROLL_Create(id, x, y, width, height); /* List is scroll view with list rows */
+        if (h) {
+            memset((void *)l, 0x00, sizeof(GUI_LIST_t));
+            l->Provider = provider;
+            l->Color[GUI_LIST_COLOR_BG] = GUI_COLOR_WHITE;  /* Set default colors */
+            l->Color[GUI_LIST_COLOR_BG_ALT] = GUI_COLOR_LIGHTGRAY;
+            l->Color[GUI_LIST_COLOR_TEXT] = GUI_COLOR_BLACK;
+            l->Columns[0] = width;                  /* Single column by default */
+            l->ColumnsCount = 1;
+            
+            GUI_SCROLL_SetParam(h, l);
+            GUI_SCROLL_SetRelease(h, __Release);    /* List data lives as long as view */
+            GUI_SCROLL_SetRows(h, rowHeight, __CreateRow, __BindRow);
+            GUI_SCROLL_SetItemCount(h, provider->GetCount(h));
+        } else {
+            __GUI_MEMFREE(l);
+        }
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+void GUI_LIST_Remove(GUI_HANDLE_t* h) {
+    __GUI_ASSERTPARAMSVOID(h && *h);                /* Check parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    GUI_SCROLL_Remove(h);                           /* Remove scroll view with rows and list data */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+}
+
+GUI_HANDLE_t GUI_LIST_SetColumns(GUI_HANDLE_t h, const GUI_Dim_t* widths, uint8_t count) {
+    __GUI_ASSERTPARAMS(h && widths && count && count <= GUI_LIST_MAX_COLUMNS);  /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    memcpy((void *)__GL(h)->Columns, (void *)widths, count * sizeof(GUI_Dim_t));   /* Set property */
+    __GL(h)->ColumnsCount = count;
+    __GUI_WIDGET_Invalidate(h);                     /* Redraw widget */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_LIST_SetColor(GUI_HANDLE_t h, GUI_LIST_COLOR_t index, GUI_Color_t color) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GL(h)->Color[index] != color) {
+        __GL(h)->Color[index] = color;              /* Set property */
+        if (index == GUI_LIST_COLOR_BG) {
+            GUI_SCROLL_SetColor(h, GUI_SCROLL_COLOR_BG, color); /* Area below last row */
+        }
+        __GUI_WIDGET_Invalidate(h);                 /* Redraw widget */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_LIST_SetFont(GUI_HANDLE_t h, GUI_Const GUI_FONT_t* font) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GUI_WIDGET_SetFont(h, font);                  /* Set font for all rows */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+/*
+ * Read number of rows from provider
+ *
+ * Only new or removed rows are drawn. When list showed last row before,
+ * it is moved to show last row again.
+ */
+GUI_HANDLE_t GUI_LIST_Update(GUI_HANDLE_t h) {
+    uint32_t count;
+    uint8_t follow;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    count = __GL(h)->Provider->GetCount(h);
+    follow = count > ((GUI_SCROLL_t *)h)->ItemCount && GUI_SCROLL_IsAtEnd(h);
+    GUI_SCROLL_SetItemCount(h, count);
+    if (follow) {
+        GUI_SCROLL_SetOffset(h, 0x7FFFFFFF);        /* Offset is limited to last row */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_LIST_InvalidateRow(GUI_HANDLE_t h, uint32_t row) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    GUI_SCROLL_InvalidateItem(h, row);              /* Draw row again */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
@@ -0,0 +1,151 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI list widget
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_LIST_H
+#define GUI_LIST_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_WIDGETS
+ * \{
+ */
+#include "gui_widget.h"
+#include "gui_scroll.h"
+
+/**
+ * \defgroup        GUI_LIST
+ * \brief           List and table with data from provider callbacks
+ *
+ * List is scroll view with rows drawn from data provider.
+ * Data is never copied to list, only rows visible in view exist as widgets
+ * and memory does not depend on number of rows.
+ *
+ * Each row has one or more columns. Cell is drawn as text returned by provider
+ * or by provider cell draw function when set.
+ *
+ * When data is appended, only new rows are drawn. When last row was visible before,
+ * list follows end of data and moves old rows up.
+ * \{
+ */
+
+/**
+ * \defgroup        GUI_LIST_Macros
+ * \brief           Library defines
+ * \{
+ */
+
+/**
+ * \brief           Maximal number of columns in list
+ */
+#ifndef GUI_LIST_MAX_COLUMNS
+#define GUI_LIST_MAX_COLUMNS            8
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        GUI_LIST_Typedefs
+ * \brief           Library Typedefs
+ * \{
+ */
+
+typedef enum GUI_LIST_COLOR_t {
+    GUI_LIST_COLOR_BG = 0x00,               /*!< Background color index of even rows */
+    GUI_LIST_COLOR_BG_ALT,                  /*!< Background color index of odd rows */
+    GUI_LIST_COLOR_TEXT,                    /*!< Text color index */
+} GUI_LIST_COLOR_t;
+
+/**
+ * \brief           Data provider for list
+ * \note            Text returned by GetText is used only until function is called again
+ */
+typedef struct GUI_LIST_PROVIDER_t {
+    uint32_t (*GetCount)(GUI_HANDLE_t h);   /*!< Get number of rows */
+    const char* (*GetText)(GUI_HANDLE_t h, uint32_t row, uint8_t column);   /*!< Get text of cell */
+    void (*DrawCell)(GUI_HANDLE_t h, GUI_Display_t* disp, uint32_t row, uint8_t column, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height);   /*!< Draw cell, optional */
+} GUI_LIST_PROVIDER_t;
+
+/**
+ * \brief           List data, attached to scroll view as its parameter
+ */
+typedef struct GUI_LIST_t {
+    const GUI_LIST_PROVIDER_t* Provider;    /*!< Data provider */
+    GUI_Color_t Color[3];                   /*!< List of colors */
+    GUI_Dim_t Columns[GUI_LIST_MAX_COLUMNS];    /*!< Width of columns */
+    uint8_t ColumnsCount;                   /*!< Number of columns */
+} GUI_LIST_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        GUI_LIST_Functions
+ * \brief           Library Functions
+ * \{
+ */
+
+/**
+ * \brief           Create list widget with rows for visible items
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
+GUI_HANDLE_t GUI_LIST_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Dim_t rowHeight, const GUI_LIST_PROVIDER_t* provider);
+void GUI_LIST_Remove(GUI_HANDLE_t* h);
+GUI_HANDLE_t GUI_LIST_SetColumns(GUI_HANDLE_t h, const GUI_Dim_t* widths, uint8_t count);
+GUI_HANDLE_t GUI_LIST_SetColor(GUI_HANDLE_t h, GUI_LIST_COLOR_t index, GUI_Color_t color);
+GUI_HANDLE_t GUI_LIST_SetFont(GUI_HANDLE_t h, GUI_Const GUI_FONT_t* font);
+GUI_HANDLE_t GUI_LIST_Update(GUI_HANDLE_t h);
+GUI_HANDLE_t GUI_LIST_InvalidateRow(GUI_HANDLE_t h, uint32_t row);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -101,6 +101,10 @@ typedef struct GUI_PROGBAR_t {
  * \{
  */
 
+/**
+ * \brief           Create progress bar widget
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
 GUI_HANDLE_t GUI_PROGBAR_Create(GUI_ID_t id, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height);
 void GUI_PROGBAR_Remove(GUI_HANDLE_t* h);
 GUI_HANDLE_t GUI_PROGBAR_SetColor(GUI_HANDLE_t h, GUI_PROGBAR_COLOR_t index, GUI_Color_t color);
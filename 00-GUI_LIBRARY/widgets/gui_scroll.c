@@ -0,0 +1,687 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_scroll.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GS(x)             ((GUI_SCROLL_t *)(x))
+
+#define __NO_ITEM           ((uint32_t)0xFFFFFFFF)
+
+static void __Draw(GUI_Display_t* disp, void* ptr);
+static __GUI_TouchStatus_t __TouchDown(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status);
+static __GUI_TouchStatus_t __TouchUp(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status);
+static __GUI_TouchStatus_t __TouchMove(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status);
+static void __Remove(void* ptr);
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+const static GUI_WIDGET_t Widget = {
+    {
+        "SCROLL",                                   /*!< Widget name */
+        sizeof(GUI_SCROLL_t),                       /*!< Size of widget for memory allocation */
+        0,                                          /*!< Rows are drawn by scroll view */
+    },
+    __Draw,                                         /*!< Widget draw function */
+    {
+        __TouchDown,                                /*!< Touch down callback function */
+        __TouchUp,                                  /*!< Touch up callback function */
+        __TouchMove                                 /*!< Touch move callback function */
+    },
+    __Remove                                        /*!< Widget remove function */
+};
+
+static GUI_SCROLL_t* Moving;                        /* List of dragged and flinging scroll views */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+#define h          ((GUI_HANDLE_t)ptr)
+#define s          ((GUI_SCROLL_t *)ptr)
+
+/* Get maximal scroll offset */
+static int32_t __MaxOffset(void* ptr) {
+    int32_t max = (int32_t)s->ItemCount * s->ItemHeight - h->Height;
+    return max > 0 ? max : 0;
+}
+
+/* Check if view or any of its parents is drawn to cached surface */
+static uint8_t __IsCached(void* ptr) {
+    GUI_HANDLE_t a;
+    
+    for (a = h; a; a = a->Parent) {
+        if (a->Flags & GUI_FLAG_CACHE) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Check if widgets drawn after view overlap it, set redraw flag on them if required */
+static uint8_t __IsCovered(void* ptr, GUI_Dim_t x, GUI_Dim_t y, uint8_t redraw) {
+    GUI_HANDLE_t a, o;
+    uint8_t covered = 0;
+    
+    for (a = h; a; a = a->Parent) {
+        for (o = __GUI_LINKEDLIST_GetNextWidget(NULL, a); o; o = __GUI_LINKEDLIST_GetNextWidget(NULL, o)) {
+            if (__GUI_RECT_MATCH(x, y, h->Width, h->Height, __GUI_WIDGET_GetAbsoluteX(o), __GUI_WIDGET_GetAbsoluteY(o), o->Width, o->Height)) {
+                if (!redraw) {
+                    return 1;
+                }
+                __GUI_WIDGET_SetRedraw(o);
+                covered = 1;
+            }
+        }
+    }
+    return covered;
+}
+
+/* Check if old content on layer can be moved instead of drawing complete view */
+static uint8_t __CanMove(void* ptr, GUI_Dim_t x, GUI_Dim_t y, int32_t delta) {
+    return delta && delta < h->Height && -delta < h->Height &&
+        (h->Flags & GUI_FLAG_OPAQUE) && !__IsCached(h) && !__IsCovered(h, x, y, 0);
+}
+
+/* Add area to clipping region */
+static void __SetClip(GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2) {
+    if (GUI.Display.X1 > x1) {
+        GUI.Display.X1 = x1;
+    }
+    if (GUI.Display.Y1 > y1) {
+        GUI.Display.Y1 = y1;
+    }
+    if (GUI.Display.X2 < x2) {
+        GUI.Display.X2 = x2;
+    }
+    if (GUI.Display.Y2 < y2) {
+        GUI.Display.Y2 = y2;
+    }
+}
+
+/* Get part of view which must be drawn after content is moved by delta pixels */
+static void __GetStrip(void* ptr, GUI_Dim_t y, int32_t delta, GUI_Dim_t* y1, GUI_Dim_t* y2) {
+    if (delta > 0) {                                /* Content moved up, new items on bottom */
+        *y1 = y + h->Height - delta;
+        *y2 = y + h->Height;
+    } else {                                        /* Content moved down, new items on top */
+        *y1 = y;
+        *y2 = y - delta;
+    }
+}
+
+/* Check if part of view inside clipping region is only exposed strip, nothing else changed inside view */
+static uint8_t __IsStripOnly(GUI_Display_t* disp, void* ptr, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t y1, GUI_Dim_t y2) {
+    if (disp->X1 >= (x + h->Width) || disp->X2 <= x || disp->Y1 >= (y + h->Height) || disp->Y2 <= y) {
+        return 1;
+    }
+    return (disp->Y1 > y ? disp->Y1 : y) >= y1 && (disp->Y2 < (y + h->Height) ? disp->Y2 : (y + h->Height)) <= y2;
+}
+
+/* Draw complete view, widgets behind transparent view are drawn too */
+static void __InvalidateView(void* ptr) {
+    if (h->Flags & GUI_FLAG_OPAQUE) {
+        __GUI_WIDGET_Invalidate(h);
+    } else {
+        __GUI_WIDGET_InvalidateWithParent(h);
+    }
+    __IsCovered(h, __GUI_WIDGET_GetAbsoluteX(h), __GUI_WIDGET_GetAbsoluteY(h), 1);  /* Widgets of other parents over view */
+}
+
+/* Set new offset and mark only exposed strip for redraw when possible */
+static uint8_t __SetOffset(void* ptr, int32_t offset) {
+    GUI_Dim_t x, y, y1, y2;
+    
+    if (offset > __MaxOffset(h)) {
+        offset = __MaxOffset(h);
+    }
+    if (offset < 0) {
+        offset = 0;
+    }
+    if (offset == s->Offset) {
+        return 0;
+    }
+    s->Offset = offset;
+    
+    x = __GUI_WIDGET_GetAbsoluteX(h);
+    y = __GUI_WIDGET_GetAbsoluteY(h);
+    if (__CanMove(h, x, y, s->Offset - s->Drawn)) {
+        __GetStrip(h, y, s->Offset - s->Drawn, &y1, &y2);
+        __GUI_WIDGET_SetRedraw(h);
+        __SetClip(x, y1, x + h->Width, y2);         /* Only exposed part is drawn */
+    } else {
+        __InvalidateView(h);                        /* Draw complete view */
+    }
+    return 1;
+}
+
+/* Mark visible part of items between first and last for redraw */
+static void __InvalidateItems(void* ptr, uint32_t first, uint32_t last) {
+    GUI_Dim_t x, y;
+    int32_t y1, y2;
+    uint8_t i;
+    
+    for (i = 0; i < s->RowsCount; i++) {            /* Items must be bound to rows again */
+        if (s->Rows[i].Item >= first && s->Rows[i].Item < last) {
+            s->Rows[i].Item = __NO_ITEM;
+        }
+    }
+    
+    y1 = (int32_t)(first * s->ItemHeight) - s->Offset;  /* Part of items inside view */
+    y2 = (int32_t)(last * s->ItemHeight) - s->Offset;
+    y1 = y1 > 0 ? y1 : 0;
+    y2 = y2 < h->Height ? y2 : h->Height;
+    if (y1 >= y2) {
+        return;
+    }
+    
+    x = __GUI_WIDGET_GetAbsoluteX(h);
+    y = __GUI_WIDGET_GetAbsoluteY(h);
+    if (!(h->Flags & GUI_FLAG_OPAQUE) || __IsCached(h) || __IsCovered(h, x, y, 0)) {
+        __InvalidateView(h);
+    } else {
+        __GUI_WIDGET_SetRedraw(h);
+        __SetClip(x, y + y1, x + h->Width, y + y2);
+    }
+}
+
+/* Set content of row widget for item, row changes are not visible outside view */
+static void __BindRow(void* ptr, GUI_SCROLL_ROW_t* row, uint32_t item) {
+    GUI_Display_t disp;
+    uint32_t flags;
+    uint8_t redraw;
+    
+    row->Item = item;
+    if (s->Bind) {
+        memcpy((void *)&disp, (void *)&GUI.Display, sizeof(GUI_Display_t));
+        flags = h->Flags;
+        redraw = __GUI_WIDGET_IsRedraw(h);
+        s->Bind(h, row->Handle, item);
+        memcpy((void *)&GUI.Display, (void *)&disp, sizeof(GUI_Display_t));
+        h->Flags = flags;
+        if (!redraw) {
+            __GUI_WIDGET_ClearRedraw(h);
+        }
+    }
+}
+
+/* Draw row widget with its children */
+static void __DrawRow(GUI_Display_t* disp, GUI_HANDLE_t r) {
+    GUI_HANDLE_t c;
+    
+    __GUI_WIDGET_ClearRedraw(r);
+    if (r->Widget->WidgetDraw) {
+        r->Widget->WidgetDraw(disp, r);
+    }
+    if (r->Widget->MetaData.AllowChildren) {
+        for (c = __GUI_LINKEDLIST_GetNextWidget((GUI_HANDLE_ROOT_t *)r, 0); c; c = __GUI_LINKEDLIST_GetNextWidget(NULL, c)) {
+            __DrawRow(disp, c);
+        }
+    }
+}
+
+/*
+ * Draw background and rows inside clipping region
+ *
+ * Row partially above view would need negative coordinate.
+ * It is drawn at top of view instead while layer start address is moved up for hidden part of row.
+ */
+static void __DrawItems(GUI_Display_t* disp, void* ptr, GUI_Dim_t x, GUI_Dim_t y) {
+    GUI_Display_t clip, rc;
+    GUI_SCROLL_ROW_t* row;
+    GUI_Layer_t* layer = &GUI.LCD.Layers[GUI.LCD.DrawingLayer];
+    uint32_t item, last, shift;
+    int32_t top;
+    
+    clip.X1 = disp->X1 > x ? disp->X1 : x;
+    clip.Y1 = disp->Y1 > y ? disp->Y1 : y;
+    clip.X2 = disp->X2 < (x + h->Width) ? disp->X2 : (x + h->Width);
+    clip.Y2 = disp->Y2 < (y + h->Height) ? disp->Y2 : (y + h->Height);
+    if (clip.X1 >= clip.X2 || clip.Y1 >= clip.Y2) {
+        return;
+    }
+    
+    GUI_DRAW_FilledRectangle(&clip, x, y, h->Width, h->Height, s->Color[GUI_SCROLL_COLOR_BG]);
+    if (!s->RowsCount || !s->ItemHeight) {
+        return;
+    }
+    
+    item = (s->Offset + clip.Y1 - y) / s->ItemHeight;   /* First and last items inside clipping region */
+    last = (s->Offset + clip.Y2 - y - 1) / s->ItemHeight;
+    if (last >= s->ItemCount) {
+        last = s->ItemCount - 1;
+    }
+    if (last - item >= s->RowsCount) {              /* Pool is smaller than visible items when rows could not be created */
+        last = item + s->RowsCount - 1;
+    }
+    for (; item <= last && item < s->ItemCount; item++) {
+        top = (int32_t)(item * s->ItemHeight) - s->Offset;  /* Row position relative to view */
+        shift = top < 0 ? -top : 0;
+        
+        row = &s->Rows[item % s->RowsCount];
+        row->Handle->X = 0;                         /* Rows are always placed by view */
+        row->Handle->Y = top + shift;
+        row->Handle->Width = h->Width;
+        row->Handle->Height = s->ItemHeight;
+        __GUI_STORE_UpdateRect(row->Handle);
+        if (row->Item != item) {
+            __BindRow(h, row, item);                /* Reuse row widget for new item */
+        }
+        
+        rc.X1 = clip.X1;                            /* Part of row inside clipping region */
+        rc.X2 = clip.X2;
+        rc.Y1 = (y + top + shift) > clip.Y1 ? (y + top + shift) : clip.Y1;
+        rc.Y2 = (y + top + s->ItemHeight) < clip.Y2 ? (y + top + s->ItemHeight) : clip.Y2;
+        rc.Y1 += shift;                             /* Clipping region in row coordinates */
+        rc.Y2 += shift;
+        
+        layer->StartAddress -= GUI.LCD.PixelSize * GUI.LCD.Width * shift;
+        __DrawRow(&rc, row->Handle);
+        layer->StartAddress += GUI.LCD.PixelSize * GUI.LCD.Width * shift;
+    }
+}
+
+/* Draw scroll view */
+static void __Draw(GUI_Display_t* disp, void* ptr) {
+    GUI_Dim_t x, y, y1, y2;
+    GUI_Dim_t srcY, dstY;
+    int32_t delta;
+    
+    x = __GUI_WIDGET_GetAbsoluteX(ptr);             /* Get absolute X coordinate */
+    y = __GUI_WIDGET_GetAbsoluteY(ptr);             /* Get absolute Y coordinate */
+    
+    delta = s->Offset - s->Drawn;
+    if (delta) {
+        __GetStrip(h, y, delta, &y1, &y2);
+        if (__CanMove(h, x, y, delta) && __IsStripOnly(disp, h, x, y, y1, y2)) {
+            if (delta > 0) {                        /* Content goes up */
+                srcY = y + delta;
+                dstY = y;
+            } else {                                /* Content goes down */
+                srcY = y;
+                dstY = y - delta;
+            }
+            
+            /* Move content from last shown frame to new position */
+            GUI.LL.Copy(&GUI.LCD, GUI.LCD.DrawingLayer,
+                (void *)(uintptr_t)(GUI.LCD.Layers[GUI.LCD.ActiveLayer].StartAddress + GUI.LCD.PixelSize * ((uint32_t)GUI.LCD.Width * srcY + x)),
+                (void *)(uintptr_t)(GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress + GUI.LCD.PixelSize * ((uint32_t)GUI.LCD.Width * dstY + x)),
+                h->Width, h->Height - (delta > 0 ? delta : -delta), GUI.LCD.Width - h->Width, GUI.LCD.Width - h->Width);
+        } else {
+            __IsCovered(h, x, y, 1);                /* Widgets over view must be drawn again */
+            __SetClip(x, y, x + h->Width, y + h->Height);   /* Draw complete view */
+        }
+        s->Drawn = s->Offset;
+    }
+    __DrawItems(disp, h, x, y);
+}
+
+/* Add view to list of moving views */
+static void __AddMoving(void* ptr) {
+    GUI_SCROLL_t* m;
+    
+    for (m = Moving; m; m = m->Next) {
+        if (m == s) {
+            return;
+        }
+    }
+    s->Next = Moving;
+    Moving = s;
+}
+
+/* Remove view from list of moving views */
+static void __RemoveMoving(void* ptr) {
+    GUI_SCROLL_t** m;
+    
+    for (m = &Moving; *m; m = &(*m)->Next) {
+        if (*m == s) {
+            *m = s->Next;
+            break;
+        }
+    }
+    s->Next = 0;
+}
+
+/* Remove all row widgets */
+static void __RemoveRows(void* ptr) {
+    uint8_t i;
+    
+    for (i = 0; i < s->RowsCount; i++) {
+        __GUI_WIDGET_Remove(&s->Rows[i].Handle);
+    }
+    if (s->Rows) {
+        __GUI_MEMFREE(s->Rows);
+    }
+    s->Rows = 0;
+    s->RowsCount = 0;
+}
+
+/* Release resources of view, called on any widget removal path */
+static void __Remove(void* ptr) {
+    __RemoveMoving(h);                              /* Stop fling */
+    __RemoveRows(h);                                /* Remove row widgets */
+    if (s->Release) {
+        s->Release(h);                              /* Release user parameter */
+        s->Release = 0;
+    }
+}
+
+/* Process touch check */
+static __GUI_TouchStatus_t __TouchDown(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    s->LastY = ts->Y[0];
+    s->Travel = 0;
+    s->Moved = 0;
+    s->Velocity = 0;                                /* Touch stops fling */
+    s->Dragging = 1;
+    __AddMoving(s);                                 /* Measure velocity on every frame */
+    
+    return touchHANDLED;
+}
+
+/* Process touch check, fling moves view through this function too */
+static __GUI_TouchStatus_t __TouchMove(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    int32_t delta;
+    
+    delta = s->LastY - (GUI_iDim_t)ts->Y[0];        /* Finger up moves content up */
+    s->LastY = ts->Y[0];
+    s->Travel += delta > 0 ? delta : -delta;
+    s->Moved += delta;
+    __SetOffset(h, s->Offset + delta);
+    
+    return touchHANDLED;
+}
+
+/* Process touch check */
+static __GUI_TouchStatus_t __TouchUp(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    uint32_t item;
+    
+    if (s->Travel < GUI_SCROLL_CLICK_TRAVEL) {      /* Touch did not scroll view */
+        s->Velocity = 0;
+        if (s->Callback && s->ItemHeight) {
+            item = (s->Offset + ts->Y[0] - __GUI_WIDGET_GetAbsoluteY(h)) / s->ItemHeight;
+            if (item < s->ItemCount) {
+                s->Callback(h, item);               /* Notify about clicked item */
+            }
+        }
+    }
+    return touchHANDLED;
+}
+#undef h
+#undef s
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+/*
+ * Update dragged and flinging scroll views, called once per frame
+ *
+ * Velocity is measured while dragging as average movement per frame.
+ * After release, view keeps moving with decreasing velocity by touch movements made here.
+ */
+void __GUI_SCROLL_Process(void) {
+    GUI_SCROLL_t** m;
+    GUI_SCROLL_t* s;
+    GUI_TouchData_t ts;
+    int32_t offset, step;
+    
+    for (m = &Moving; *m; ) {
+        s = *m;
+        if (s->Dragging) {
+            if (GUI.ActiveWidget == (GUI_HANDLE_t)s) {  /* Still dragged */
+                s->Velocity = (s->Velocity + s->Moved * 256) / 2;
+                s->Moved = 0;
+                m = &s->Next;
+                continue;
+            }
+            s->Dragging = 0;                        /* Released, fling with last velocity */
+        }
+        if (s->Velocity < 256 && s->Velocity > -256) {  /* Stopped */
+            s->Velocity = 0;
+            *m = s->Next;
+            s->Next = 0;
+            continue;
+        }
+        
+        step = s->Velocity / 256;                   /* Movement in this frame */
+        if (step > __GH(s)->Height / 2) {
+            step = __GH(s)->Height / 2;
+        } else if (step < -(__GH(s)->Height / 2)) {
+            step = -(__GH(s)->Height / 2);
+        }
+        s->LastY = __GUI_WIDGET_GetAbsoluteY(s) + __GH(s)->Height / 2;
+        memset((void *)&ts, 0x00, sizeof(ts));
+        ts.X[0] = __GUI_WIDGET_GetAbsoluteX(s);
+        ts.Y[0] = s->LastY - step;
+        ts.Count = 1;
+        ts.Status = GUI_TouchState_PRESSED;
+        ts.Time = GUI.Time;
+        
+        offset = s->Offset;
+        __TouchMove(s, &ts, touchCONTINUE);         /* Move as finger would */
+        if (s->Offset == offset) {                  /* End of list reached */
+            s->Velocity = 0;
+        } else {
+            s->Velocity = s->Velocity * GUI_SCROLL_FLING_FRICTION / 256;
+        }
+        m = &s->Next;
+    }
+}
+
+GUI_HANDLE_t GUI_SCROLL_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height) {
+    GUI_SCROLL_t* ptr;
+    
+    __GUI_ASSERTACTIVEWIN();                        /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ptr = (GUI_SCROLL_t *)__GUI_WIDGET_Create(&Widget, id, x, y, width, height);   /* Allocate memory for basic widget */
+    if (ptr) {
+        ptr->Color[GUI_SCROLL_COLOR_BG] = GUI_COLOR_WHITE;  /* Set default color */
+        __GUI_WIDGET_SetOpaque(ptr, 1);             /* Background covers complete view */
+        
+        ptr->ItemCount = 0;
+        ptr->ItemHeight = 0;
+        ptr->Offset = 0;
+        ptr->Drawn = 0;
+        ptr->Rows = 0;
+        ptr->RowsCount = 0;
+        ptr->Bind = 0;
+        ptr->Callback = 0;
+        ptr->Param = 0;
+        ptr->Release = 0;
+        ptr->Velocity = 0;
+        ptr->Dragging = 0;
+        ptr->Next = 0;
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    
+    return (GUI_HANDLE_t)ptr;
+}
+
+void GUI_SCROLL_Remove(GUI_HANDLE_t* h) {
+    __GUI_ASSERTPARAMSVOID(h && *h);                /* Check parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GUI_WIDGET_Remove(h);                         /* Remove widget with rows */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetColor(GUI_HANDLE_t h, GUI_SCROLL_COLOR_t index, GUI_Color_t color) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GS(h)->Color[index] != color) {
+        __GS(h)->Color[index] = color;              /* Set property */
+        if (index == GUI_SCROLL_COLOR_BG) {
+            __GUI_WIDGET_SetOpaque(h, !(color & 0xFF000000));   /* Transparent background shows widgets behind view */
+        }
+        __GUI_WIDGET_InvalidateWithParent(h);       /* Redraw widget */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetRows(GUI_HANDLE_t h, GUI_Dim_t itemHeight, GUI_SCROLL_CreateRow_t create, GUI_SCROLL_BindRow_t bind) {
+    GUI_HANDLE_t parent, row;
+    uint32_t count;
+    uint8_t i;
+    
+    __GUI_ASSERTPARAMS(h && itemHeight && create);  /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __RemoveRows(h);                                /* Remove old row widgets */
+    
+    if (h->Height / itemHeight + 2 > 0xFF) {        /* Visible items must not share row widget, pool has up to 255 rows */
+        itemHeight = h->Height / (0xFF - 2) + 1;
+    }
+    count = h->Height / itemHeight + 2;             /* Rows partially visible on top and bottom */
+    __GS(h)->Rows = (GUI_SCROLL_ROW_t *)__GUI_MEMALLOC(count * sizeof(GUI_SCROLL_ROW_t));
+    if (__GS(h)->Rows) {
+        parent = GUI.WindowActive;
+        for (i = 0; i < count; i++) {
+            GUI.WindowActive = h;                   /* Rows are created as children of view */
+            row = create(h, i);
+            if (!row) {
+                break;
+            }
+            __GS(h)->Rows[i].Handle = row;
+            __GS(h)->Rows[i].Item = __NO_ITEM;
+        }
+        __GS(h)->RowsCount = i;
+        GUI.WindowActive = parent;
+    }
+    __GS(h)->ItemHeight = itemHeight;
+    __GS(h)->Bind = bind;
+    
+    __SetOffset(h, __GS(h)->Offset);                /* Check offset for new height */
+    __InvalidateView(h);                            /* Redraw widget */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetItemCount(GUI_HANDLE_t h, uint32_t count) {
+    uint32_t old;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    old = __GS(h)->ItemCount;
+    if (old != count) {
+        __GS(h)->ItemCount = count;                 /* Set property */
+        if (count > old) {                          /* Draw only added items */
+            __InvalidateItems(h, old, count);
+        } else {                                    /* Clear removed items */
+            __InvalidateItems(h, count, old);
+        }
+        __SetOffset(h, __GS(h)->Offset);            /* Check offset for new count */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_InvalidateItem(GUI_HANDLE_t h, uint32_t item) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (item < __GS(h)->ItemCount) {
+        __InvalidateItems(h, item, item + 1);       /* Bind and draw item again */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetOffset(GUI_HANDLE_t h, int32_t offset) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GS(h)->Velocity = 0;                          /* Stop fling */
+    __SetOffset(h, offset);                         /* Set property */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetCallback(GUI_HANDLE_t h, void (*callback)(GUI_HANDLE_t, uint32_t)) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GS(h)->Callback = callback;                   /* Set callback */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetParam(GUI_HANDLE_t h, void* param) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GS(h)->Param = param;                         /* Set parameter */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+GUI_HANDLE_t GUI_SCROLL_SetRelease(GUI_HANDLE_t h, void (*release)(GUI_HANDLE_t)) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GS(h)->Release = release;                     /* Set callback */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;                                       /* Return widget pointer */
+}
+
+uint8_t GUI_SCROLL_IsAtEnd(GUI_HANDLE_t h) {
+    uint8_t ret;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ret = __GS(h)->Offset >= __MaxOffset(h);        /* Last item is visible at bottom */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
@@ -0,0 +1,203 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI scroll view widget
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_SCROLL_H
+#define GUI_SCROLL_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_WIDGETS
+ * \{
+ */
+#include "gui_widget.h"
+
+/**
+ * \defgroup        GUI_SCROLL
+ * \brief           Vertical scroll view with virtualized rows
+ *
+ * Scroll view shows list of items with the same height. Only rows visible on screen exist as widgets,
+ * they are created once to fill the view and bound to new items when scrolled into view.
+ *
+ * When view is scrolled, already rendered content is moved on layer with single copy
+ * and only newly exposed strip is drawn. Complete view is drawn when content can not be moved,
+ * when view has transparent background, is drawn to cached surface or is covered by other widgets.
+ *
+ * \note            Rows belong to scroll view and are drawn by it, row content must be set only in bind callback.
+ *                  Use \ref GUI_SCROLL_InvalidateItem when data of item changes.
+ * \{
+ */
+
+/**
+ * \defgroup        GUI_SCROLL_Macros
+ * \brief           Library defines
+ * \{
+ */
+
+/**
+ * \brief           Touch travel in units of pixels below which touch is reported as item click
+ */
+#ifndef GUI_SCROLL_CLICK_TRAVEL
+#define GUI_SCROLL_CLICK_TRAVEL         8
+#endif
+
+/**
+ * \brief           Fling velocity decay per frame, multiplier in units of 1/256
+ */
+#ifndef GUI_SCROLL_FLING_FRICTION
+#define GUI_SCROLL_FLING_FRICTION       240
+#endif
+
+/**
+ * \brief           Get user parameter of scroll view
+ */
+#define GUI_SCROLL_GetParam(h)          (((GUI_SCROLL_t *)(h))->Param)
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        GUI_SCROLL_Typedefs
+ * \brief           Library Typedefs
+ * \{
+ */
+
+typedef enum GUI_SCROLL_COLOR_t {
+    GUI_SCROLL_COLOR_BG = 0x00,             /*!< Background color index */
+} GUI_SCROLL_COLOR_t;
+
+/**
+ * \brief           Callback to create widget for row with given index in row pool
+ * \note            Scroll view is set as active window, widget must be created at position 0, 0
+ */
+typedef GUI_HANDLE_t (*GUI_SCROLL_CreateRow_t)(GUI_HANDLE_t h, uint8_t row);
+
+/**
+ * \brief           Callback to set row widget content for item
+ */
+typedef void (*GUI_SCROLL_BindRow_t)(GUI_HANDLE_t h, GUI_HANDLE_t row, uint32_t item);
+
+/**
+ * \brief           Single row in pool of row widgets
+ */
+typedef struct GUI_SCROLL_ROW_t {
+    GUI_HANDLE_t Handle;                    /*!< Row widget */
+    uint32_t Item;                          /*!< Item currently bound to row widget */
+} GUI_SCROLL_ROW_t;
+
+/**
+ * \brief           Scroll view object structure
+ */
+typedef struct GUI_SCROLL_t {
+    GUI_HANDLE_ROOT_t C;                    /*!< GUI handle object, must always be first on list */
+    
+    GUI_Color_t Color[1];                   /*!< List of colors */
+    
+    uint32_t ItemCount;                     /*!< Number of items in list */
+    GUI_Dim_t ItemHeight;                   /*!< Height of single item in units of pixels */
+    int32_t Offset;                         /*!< Scroll offset of content in units of pixels */
+    int32_t Drawn;                          /*!< Scroll offset of content on layer */
+    
+    GUI_SCROLL_ROW_t* Rows;                 /*!< Pool of row widgets */
+    uint8_t RowsCount;                      /*!< Number of row widgets in pool */
+    GUI_SCROLL_BindRow_t Bind;              /*!< Callback to set row content */
+    void (*Callback)(GUI_HANDLE_t, uint32_t);   /*!< Callback when item is clicked */
+    void* Param;                            /*!< User parameter for callbacks */
+    void (*Release)(GUI_HANDLE_t);          /*!< Callback to release user parameter when view is removed */
+    
+    GUI_iDim_t LastY;                       /*!< Last touch Y position */
+    uint32_t Travel;                        /*!< Touch travel since touch down */
+    int32_t Moved;                          /*!< Touch movement since last frame */
+    int32_t Velocity;                       /*!< Scroll velocity in units of 1/256 pixels per frame */
+    uint8_t Dragging;                       /*!< Touch is active on widget */
+    struct GUI_SCROLL_t* Next;              /*!< Next scroll view on list of moving views */
+} GUI_SCROLL_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup        GUI_SCROLL_Functions
+ * \brief           Library Functions
+ * \{
+ */
+
+/**
+ * \brief           Create scroll view widget
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
+GUI_HANDLE_t GUI_SCROLL_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height);
+void GUI_SCROLL_Remove(GUI_HANDLE_t* h);
+GUI_HANDLE_t GUI_SCROLL_SetColor(GUI_HANDLE_t h, GUI_SCROLL_COLOR_t index, GUI_Color_t color);
+/**
+ * \brief           Set height of items and create pool of row widgets for visible items
+ * \note            Pool has up to 255 rows, item height is increased when more rows would be visible
+ */
+GUI_HANDLE_t GUI_SCROLL_SetRows(GUI_HANDLE_t h, GUI_Dim_t itemHeight, GUI_SCROLL_CreateRow_t create, GUI_SCROLL_BindRow_t bind);
+GUI_HANDLE_t GUI_SCROLL_SetItemCount(GUI_HANDLE_t h, uint32_t count);
+GUI_HANDLE_t GUI_SCROLL_InvalidateItem(GUI_HANDLE_t h, uint32_t item);
+GUI_HANDLE_t GUI_SCROLL_SetOffset(GUI_HANDLE_t h, int32_t offset);
+GUI_HANDLE_t GUI_SCROLL_SetCallback(GUI_HANDLE_t h, void (*callback)(GUI_HANDLE_t, uint32_t));
+GUI_HANDLE_t GUI_SCROLL_SetParam(GUI_HANDLE_t h, void* param);
+
+/**
+ * \brief           Set callback to release user parameter
+ * \note            Callback is called on any removal of view, also when its parent window is removed
+ */
+GUI_HANDLE_t GUI_SCROLL_SetRelease(GUI_HANDLE_t h, void (*release)(GUI_HANDLE_t));
+
+uint8_t GUI_SCROLL_IsAtEnd(GUI_HANDLE_t h);
+
+void __GUI_SCROLL_Process(void);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
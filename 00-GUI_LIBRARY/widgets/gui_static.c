@@ -0,0 +1,459 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_static.h"
+#include "gui_button.h"
+#include "gui_led.h"
+#include "gui_progbar.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GS(x)             ((GUI_STATIC_t *)(x))
+#define __STATIC_NONE       0xFFFF
+
+static void __Draw(GUI_Display_t* disp, void* ptr);
+static __GUI_TouchStatus_t __TouchDown(void* widget, GUI_TouchData_t* ts, __GUI_TouchStatus_t status);
+static __GUI_TouchStatus_t __TouchUp(void* widget, GUI_TouchData_t* ts, __GUI_TouchStatus_t status);
+static void __Remove(void* ptr);
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+const static GUI_WIDGET_t Widget = {
+    {
+        "STATIC",                                   /*!< Widget name */
+        sizeof(GUI_STATIC_t),                       /*!< Size of widget for memory allocation */
+        0,                                          /*!< Allow children objects on widget */
+    },
+    __Draw,                                         /*!< Widget draw function */
+    {
+        __TouchDown,                                /*!< Touch down callback function */
+        __TouchUp,                                  /*!< Touch up callback function */
+        0                                           /*!< Touch move callback function */
+    },
+    __Remove                                        /*!< Widget remove function */
+};
+
+/* Default colors when item does not have its own, same as defaults of normal widgets */
+static const GUI_Color_t ColorsLabel[] = {GUI_COLOR_BLACK};
+static const GUI_Color_t ColorsButton[] = {GUI_COLOR_BLACK, GUI_COLOR_GRAY};
+static const GUI_Color_t ColorsLed[] = {GUI_COLOR_LIGHTBLUE, GUI_COLOR_DARKBLUE, GUI_COLOR_GRAY, GUI_COLOR_BLACK};
+static const GUI_Color_t ColorsProgbar[] = {GUI_COLOR_GRAY, GUI_COLOR_DARKRED, GUI_COLOR_BLACK};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get item index by ID */
+static uint16_t __Find(GUI_HANDLE_t h, GUI_ID_t id) {
+    uint16_t i;
+    
+    for (i = 0; i < __GS(h)->Count; i++) {
+        if (__GS(h)->Items[i].Id == id) {
+            return i;
+        }
+    }
+    return __STATIC_NONE;
+}
+
+/* Redraw only area of single item */
+static void __InvalidateItem(GUI_HANDLE_t h, uint16_t index) {
+    const GUI_STATIC_ITEM_t* item = &__GS(h)->Items[index];
+    GUI_Display_t disp = GUI.Display;
+    GUI_Dim_t x, y;
+    
+    __GUI_WIDGET_Invalidate(h);                     /* Mark widget and widgets above it for redraw */
+    GUI.Display = disp;                             /* Keep clipping region to item only */
+    
+    x = __GUI_WIDGET_GetAbsoluteX(h) + item->X;
+    y = __GUI_WIDGET_GetAbsoluteY(h) + item->Y;
+    if (GUI.Display.X1 > x) {
+        GUI.Display.X1 = x;
+    }
+    if (GUI.Display.X2 < (x + item->Width)) {
+        GUI.Display.X2 = x + item->Width;
+    }
+    if (GUI.Display.Y1 > y) {
+        GUI.Display.Y1 = y;
+    }
+    if (GUI.Display.Y2 < (y + item->Height)) {
+        GUI.Display.Y2 = y + item->Height;
+    }
+}
+
+/* Write item text centered */
+static void __DrawText(GUI_Display_t* disp, const GUI_STATIC_ITEM_t* item, const char* text, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Color_t c1, GUI_Color_t c2) {
+    GUI_DRAW_FONT_t f;
+    
+    memset((void *)&f, 0x00, sizeof(f));            /* Reset structure */
+    f.X = x + 1;
+    f.Y = y + 1;
+    f.Width = item->Width - 2;
+    f.Height = item->Height - 2;
+    f.Align = GUI_HALIGN_CENTER | GUI_VALIGN_CENTER;
+    f.Color1Width = width;
+    f.Color1 = c1;
+    f.Color2 = c2;
+    GUI_DRAW_WriteText(disp, item->Font, text, &f);
+}
+
+static void __DrawItem(GUI_Display_t* disp, const GUI_STATIC_ITEM_t* item, const GUI_STATIC_STATE_t* state, GUI_Dim_t x, GUI_Dim_t y) {
+    const GUI_Color_t* c;
+    GUI_Color_t c1, c2;
+    GUI_Dim_t w;
+    char buff[24];
+    
+    switch (item->Type) {
+        case GUI_STATIC_TYPE_LABEL:
+            c = item->Color ? item->Color : ColorsLabel;
+            if (item->Font && item->Text) {
+                if (item->Style & GUI_STATIC_STYLE_VALUE) { /* Text is format for value */
+                    snprintf(buff, sizeof(buff), item->Text, state->Value);
+                    __DrawText(disp, item, buff, x, y, item->Width, c[0], c[0]);
+                } else {
+                    __DrawText(disp, item, item->Text, x, y, item->Width, c[0], c[0]);
+                }
+            }
+            break;
+        case GUI_STATIC_TYPE_BUTTON:
+            c = item->Color ? item->Color : ColorsButton;
+            if (state->Flags & GUI_STATIC_FLAG_PRESSED) {
+                c1 = c[GUI_BUTTON_COLOR_FG];
+                c2 = c[GUI_BUTTON_COLOR_BG];
+            } else {
+                c1 = c[GUI_BUTTON_COLOR_BG];
+                c2 = c[GUI_BUTTON_COLOR_FG];
+            }
+            if (item->Style & GUI_STATIC_STYLE_3D) {
+                GUI_DRAW_FilledRectangle(disp, x, y, item->Width, item->Height, c1);
+                GUI_DRAW_Rectangle3D(disp, x, y, item->Width, item->Height, state->Flags & GUI_STATIC_FLAG_PRESSED ? GUI_DRAW_3D_State_Lowered : GUI_DRAW_3D_State_Raised);
+            } else {
+                GUI_DRAW_FilledRoundedRectangleAA(disp, x, y, item->Width, item->Height, item->Radius, c1);
+                GUI_DRAW_RoundedRectangleAA(disp, x, y, item->Width, item->Height, item->Radius, c2);
+            }
+            if (item->Font && item->Text) {
+                __DrawText(disp, item, item->Text, x, y, item->Width, c2, c2);
+            }
+            break;
+        case GUI_STATIC_TYPE_LED:
+            c = item->Color ? item->Color : ColorsLed;
+            if (state->Value) {
+                c1 = c[GUI_LED_COLOR_ON];
+                c2 = c[GUI_LED_COLOR_ON_BORDER];
+            } else {
+                c1 = c[GUI_LED_COLOR_OFF];
+                c2 = c[GUI_LED_COLOR_OFF_BORDER];
+            }
+            if (item->Style & GUI_STATIC_STYLE_CIRCLE) {
+                GUI_DRAW_FilledCircleAA(disp, x + item->Width / 2, y + item->Height / 2, item->Width / 2, c1);
+                GUI_DRAW_CircleAA(disp, x + item->Width / 2, y + item->Height / 2, item->Width / 2, c2);
+            } else {
+                GUI_DRAW_FilledRectangle(disp, x + 1, y + 1, item->Width - 2, item->Height - 2, c1);
+                GUI_DRAW_Rectangle(disp, x, y, item->Width, item->Height, c2);
+            }
+            break;
+        case GUI_STATIC_TYPE_PROGBAR:
+            c = item->Color ? item->Color : ColorsProgbar;
+            w = 0;
+            if (item->Max > item->Min) {
+                w = ((item->Width - 2) * (state->Value - item->Min)) / (item->Max - item->Min);
+            }
+            GUI_DRAW_FilledRectangle(disp, x + w + 1, y, item->Width - w - 2, item->Height, c[GUI_PROGBAR_COLOR_BG]);
+            GUI_DRAW_FilledRectangle(disp, x + 1, y + 1, w, item->Height - 2, c[GUI_PROGBAR_COLOR_FG]);
+            GUI_DRAW_Rectangle(disp, x, y, item->Width, item->Height, c[GUI_PROGBAR_COLOR_BORDER]);
+            if (item->Font) {
+                const char* text = item->Text;
+                if ((item->Style & GUI_STATIC_STYLE_PERCENT) && item->Max > item->Min) {
+                    sprintf(buff, "%d%%", ((state->Value - item->Min) * 100) / (item->Max - item->Min));
+                    text = buff;
+                }
+                if (text) {
+                    __DrawText(disp, item, text, x, y, w ? w - 1 : 0, c[GUI_PROGBAR_COLOR_BG], c[GUI_PROGBAR_COLOR_FG]);
+                }
+            }
+            break;
+        case GUI_STATIC_TYPE_IMAGE:
+            if (item->Image) {
+                GUI_DRAW_Image(disp, x, y, item->Image);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void __Draw(GUI_Display_t* disp, void* ptr) {
+    const GUI_STATIC_ITEM_t* item;
+    GUI_Dim_t x, y, ix, iy;
+    uint16_t i;
+    
+    x = __GUI_WIDGET_GetAbsoluteX(ptr);             /* Get absolute position on screen */
+    y = __GUI_WIDGET_GetAbsoluteY(ptr);             /* Get absolute position on screen */
+    
+    GUI_DRAW_FilledRectangle(disp, x, y, __GH(ptr)->Width, __GH(ptr)->Height, __GS(ptr)->Color[GUI_STATIC_COLOR_BG]);
+    
+    for (i = 0; i < __GS(ptr)->Count; i++) {
+        item = &__GS(ptr)->Items[i];
+        ix = x + item->X;
+        iy = y + item->Y;
+        if ((__GS(ptr)->State[i].Flags & GUI_STATIC_FLAG_HIDDEN) ||    /* Skip hidden items and items outside clipping region */
+            ix >= disp->X2 || iy >= disp->Y2 || (ix + item->Width) <= disp->X1 || (iy + item->Height) <= disp->Y1) {
+            continue;
+        }
+        __DrawItem(disp, item, &__GS(ptr)->State[i], ix, iy);
+    }
+}
+
+/* Get top most button item at touch position */
+static uint16_t __GetButton(void* ptr, GUI_TouchData_t* ts) {
+    const GUI_STATIC_ITEM_t* item;
+    GUI_iDim_t x, y;
+    uint16_t i;
+    
+    x = ts->X[0] - __GUI_WIDGET_GetAbsoluteX(ptr);  /* Get touch position relative to widget */
+    y = ts->Y[0] - __GUI_WIDGET_GetAbsoluteY(ptr);
+    
+    for (i = __GS(ptr)->Count; i--; ) {             /* Items drawn later are on top */
+        item = &__GS(ptr)->Items[i];
+        if (x < item->X || x > item->X + item->Width || y < item->Y || y > item->Y + item->Height ||
+            (__GS(ptr)->State[i].Flags & GUI_STATIC_FLAG_HIDDEN)) {
+            continue;
+        }
+        if (item->Type != GUI_STATIC_TYPE_BUTTON || (__GS(ptr)->State[i].Flags & GUI_STATIC_FLAG_DISABLED)) {
+            return __STATIC_NONE;                   /* Item above button hides it */
+        }
+        return i;
+    }
+    return __STATIC_NONE;
+}
+
+static __GUI_TouchStatus_t __TouchDown(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    uint16_t i = __GetButton(ptr, ts);
+    
+    if (__GS(ptr)->Pressed != __STATIC_NONE) {      /* Release button when last touch ended outside widget */
+        __GS(ptr)->State[__GS(ptr)->Pressed].Flags &= ~GUI_STATIC_FLAG_PRESSED;
+        __InvalidateItem(__GH(ptr), __GS(ptr)->Pressed);
+        __GS(ptr)->Pressed = __STATIC_NONE;
+    }
+    if (i == __STATIC_NONE) {
+        return touchHANDLEDNOFOCUS;                 /* Handle touch on group but don't do anything */
+    }
+    __GS(ptr)->Pressed = i;
+    __GS(ptr)->State[i].Flags |= GUI_STATIC_FLAG_PRESSED;
+    __InvalidateItem(__GH(ptr), i);
+    return touchHANDLED;
+}
+
+static __GUI_TouchStatus_t __TouchUp(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    uint16_t i = __GS(ptr)->Pressed;
+    
+    if (i == __STATIC_NONE) {
+        return touchHANDLED;
+    }
+    __GS(ptr)->Pressed = __STATIC_NONE;
+    __GS(ptr)->State[i].Flags &= ~GUI_STATIC_FLAG_PRESSED;
+    __InvalidateItem(__GH(ptr), i);
+    if (__GetButton(ptr, ts) == i && __GS(ptr)->Callback) { /* Released on the same button */
+        __GS(ptr)->Callback(__GH(ptr), __GS(ptr)->Items[i].Id);
+    }
+    return touchHANDLED;
+}
+
+/* Free item states, called on any widget removal path */
+static void __Remove(void* ptr) {
+    if (__GS(ptr)->State) {
+        __GUI_MEMFREE(__GS(ptr)->State);            /* Free item states */
+        __GS(ptr)->State = NULL;
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_HANDLE_t GUI_STATIC_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, const GUI_STATIC_ITEM_t* items, uint16_t count) {
+    GUI_STATIC_t* ptr;
+    GUI_STATIC_STATE_t* state;
+    uint16_t i;
+    
+    __GUI_ASSERTACTIVEWIN();                        /* Check input parameters */
+    __GUI_ASSERTPARAMS(items || !count);
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    state = NULL;
+    if (count) {
+        state = (GUI_STATIC_STATE_t *)__GUI_MEMALLOC(count * sizeof(GUI_STATIC_STATE_t));   /* Only state of items is in RAM */
+    }
+    ptr = NULL;
+    if (state || !count) {
+        ptr = (GUI_STATIC_t *)__GUI_WIDGET_Create(&Widget, id, x, y, width, height);    /* Allocate memory for basic widget */
+    }
+    if (ptr) {
+        ptr->Color[GUI_STATIC_COLOR_BG] = GUI_COLOR_LIGHTGRAY;  /* Set default color */
+        __GUI_WIDGET_SetOpaque(ptr, 1);             /* Background covers complete widget */
+        
+        ptr->Items = items;
+        ptr->State = state;
+        ptr->Count = count;
+        ptr->Pressed = __STATIC_NONE;
+        for (i = 0; i < count; i++) {
+            state[i].Value = items[i].Type == GUI_STATIC_TYPE_PROGBAR ? items[i].Min : 0;
+            state[i].Flags = 0;
+        }
+    } else if (state) {
+        __GUI_MEMFREE(state);
+    }
+    __GUI_LEAVE();                                  /* Leave GUI */
+    
+    return (GUI_HANDLE_t)ptr;
+}
+
+void GUI_STATIC_Remove(GUI_HANDLE_t* h) {
+    __GUI_ASSERTPARAMSVOID(h && *h);                /* Check parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GUI_WIDGET_Remove(h);                         /* Remove widget with item states */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+}
+
+GUI_HANDLE_t GUI_STATIC_SetColor(GUI_HANDLE_t h, GUI_STATIC_COLOR_t index, GUI_Color_t color) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GS(h)->Color[index] != color) {           /* Any parameter changed */
+        __GS(h)->Color[index] = color;              /* Set parameter */
+        if (index == GUI_STATIC_COLOR_BG) {
+            __GUI_WIDGET_SetOpaque(h, !(color & 0xFF000000));   /* Transparent background shows widgets behind */
+        }
+        __GUI_WIDGET_InvalidateWithParent(h);       /* Redraw object */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+GUI_HANDLE_t GUI_STATIC_SetCallback(GUI_HANDLE_t h, void (*callback)(GUI_HANDLE_t, GUI_ID_t)) {
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GS(h)->Callback = callback;                   /* Set parameter */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+GUI_HANDLE_t GUI_STATIC_SetValue(GUI_HANDLE_t h, GUI_ID_t id, int16_t value) {
+    const GUI_STATIC_ITEM_t* item;
+    uint16_t i;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    i = __Find(h, id);
+    if (i != __STATIC_NONE) {
+        item = &__GS(h)->Items[i];
+        if (item->Type == GUI_STATIC_TYPE_PROGBAR) {    /* Keep value in range */
+            if (value < item->Min) {
+                value = item->Min;
+            } else if (value > item->Max) {
+                value = item->Max;
+            }
+        }
+        if (__GS(h)->State[i].Value != value) {     /* Any parameter changed */
+            __GS(h)->State[i].Value = value;        /* Set parameter */
+            if (!(__GS(h)->State[i].Flags & GUI_STATIC_FLAG_HIDDEN)) {
+                __InvalidateItem(h, i);             /* Redraw item */
+            }
+        }
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+int16_t GUI_STATIC_GetValue(GUI_HANDLE_t h, GUI_ID_t id) {
+    int16_t value = 0;
+    uint16_t i;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    i = __Find(h, id);
+    if (i != __STATIC_NONE) {
+        value = __GS(h)->State[i].Value;
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return value;
+}
+
+GUI_HANDLE_t GUI_STATIC_SetVisible(GUI_HANDLE_t h, GUI_ID_t id, GUI_Byte visible) {
+    uint16_t i;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    i = __Find(h, id);
+    if (i != __STATIC_NONE && !visible != !!(__GS(h)->State[i].Flags & GUI_STATIC_FLAG_HIDDEN)) {
+        __GS(h)->State[i].Flags ^= GUI_STATIC_FLAG_HIDDEN;  /* Toggle visibility */
+        __InvalidateItem(h, i);                     /* Redraw item area */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
+
+GUI_HANDLE_t GUI_STATIC_SetEnabled(GUI_HANDLE_t h, GUI_ID_t id, GUI_Byte enabled) {
+    uint16_t i;
+    
+    __GUI_ASSERTPARAMS(h);                          /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    i = __Find(h, id);
+    if (i != __STATIC_NONE) {
+        if (enabled) {
+            __GS(h)->State[i].Flags &= ~GUI_STATIC_FLAG_DISABLED;
+        } else {
+            __GS(h)->State[i].Flags |= GUI_STATIC_FLAG_DISABLED;
+        }
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return h;
+}
@@ -0,0 +1,216 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   GUI static items widget
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_STATIC_H
+#define GUI_STATIC_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_WIDGETS
+ * \{
+ */
+#include "gui_widget.h"
+
+/**
+ * \defgroup        GUI_STATIC
+ * \brief           Group of items described in constant memory
+ *
+ * Each item (label, button, LED, progress bar, image) is described with \ref GUI_STATIC_ITEM_t
+ * which is usually placed in flash. Geometry, colors, font, text and style are read from description.
+ * Only state of each item (value and flags) is kept in RAM, one \ref GUI_STATIC_STATE_t per item.
+ *
+ * Whole group is single widget. Items cannot be moved or resized and do not have children,
+ * use normal widgets when this is required.
+ *
+ * \code{c}
+const GUI_Color_t LedColors[] = {GUI_COLOR_GREEN, GUI_COLOR_DARKGREEN, GUI_COLOR_GRAY, GUI_COLOR_BLACK};
+const GUI_STATIC_ITEM_t Items[] = {
+    {GUI_STATIC_TYPE_LABEL,   0, 1, 10, 10, 100, 20, 0, 0, 0, NULL, &GUI_Font_Calibri_Bold_8, "Temp: %d C", NULL},
+    {GUI_STATIC_TYPE_LED,     GUI_STATIC_STYLE_CIRCLE, 2, 120, 10, 20, 20, 0, 0, 0, LedColors, NULL, NULL, NULL},
+    {GUI_STATIC_TYPE_PROGBAR, GUI_STATIC_STYLE_PERCENT, 3, 10, 40, 130, 20, 0, 0, 100, NULL, &GUI_Font_Calibri_Bold_8, NULL, NULL},
+    {GUI_STATIC_TYPE_BUTTON,  0, 4, 10, 70, 130, 30, 5, 0, 0, NULL, &GUI_Font_Calibri_Bold_8, "Reset", NULL},
+};
+
+h = GUI_STATIC_Create(0, 0, 0, 150, 110, Items, sizeof(Items) / sizeof(Items[0]));
+GUI_STATIC_SetValue(h, 1, 25);              //Label shows "Temp: 25 C"
+GUI_STATIC_SetValue(h, 2, 1);               //LED is on
+\endcode
+ * \{
+ */
+
+/**
+ * \defgroup        GUI_STATIC_Macros
+ * \brief           Library defines
+ * \{
+ */
+
+#define GUI_STATIC_STYLE_3D         0x01    /*!< Button is drawn with 3D style */
+#define GUI_STATIC_STYLE_CIRCLE     0x02    /*!< LED has circle shape */
+#define GUI_STATIC_STYLE_PERCENT    0x04    /*!< Progress bar shows value in percent */
+#define GUI_STATIC_STYLE_VALUE      0x08    /*!< Label text is format string for item value */
+
+#define GUI_STATIC_FLAG_HIDDEN      0x01    /*!< Item is not drawn and does not receive touch */
+#define GUI_STATIC_FLAG_DISABLED    0x02    /*!< Button item does not react on touch */
+#define GUI_STATIC_FLAG_PRESSED     0x04    /*!< Button item is pressed */
+
+/**
+ * \} GUI_STATIC_Macros
+ */
+ 
+/**
+ * \defgroup        GUI_STATIC_Typedefs
+ * \brief           Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief           List of item types
+ */
+typedef enum GUI_STATIC_TYPE_t {
+    GUI_STATIC_TYPE_LABEL = 0x00,           /*!< Text, colors: text */
+    GUI_STATIC_TYPE_BUTTON,                 /*!< Button, colors as \ref GUI_BUTTON_COLOR_FG and \ref GUI_BUTTON_COLOR_BG */
+    GUI_STATIC_TYPE_LED,                    /*!< LED, colors as \ref GUI_LED_COLOR_t, value is on/off state */
+    GUI_STATIC_TYPE_PROGBAR,                /*!< Progress bar, colors as \ref GUI_PROGBAR_COLOR_t */
+    GUI_STATIC_TYPE_IMAGE                   /*!< Image drawn at top left corner of item */
+} GUI_STATIC_TYPE_t;
+
+/**
+ * \brief           List of available colors for group
+ */
+typedef enum GUI_STATIC_COLOR_t {
+    GUI_STATIC_COLOR_BG = 0x00              /*!< Background color index */
+} GUI_STATIC_COLOR_t;
+
+/**
+ * \brief           Constant item description
+ */
+typedef struct GUI_STATIC_ITEM_t {
+    uint8_t Type;                           /*!< Item type, member of \ref GUI_STATIC_TYPE_t */
+    uint8_t Style;                          /*!< Item style, GUI_STATIC_STYLE_x values */
+    GUI_ID_t Id;                            /*!< Item ID, used to change item state */
+    GUI_iDim_t X;                           /*!< X position relative to group */
+    GUI_iDim_t Y;                           /*!< Y position relative to group */
+    GUI_Dim_t Width;                        /*!< Item width */
+    GUI_Dim_t Height;                       /*!< Item height */
+    GUI_Dim_t Radius;                       /*!< Border radius for button */
+    int16_t Min;                            /*!< Low value for progress bar */
+    int16_t Max;                            /*!< High value for progress bar */
+    const GUI_Color_t* Color;               /*!< List of colors in item color index order, NULL for default colors */
+    GUI_Const GUI_FONT_t* Font;             /*!< Font for text, NULL for no text */
+    const char* Text;                       /*!< Item text or format string with \ref GUI_STATIC_STYLE_VALUE */
+    const GUI_IMAGE_DESC_t* Image;          /*!< Image for image item */
+} GUI_STATIC_ITEM_t;
+
+/**
+ * \brief           Item state, only part of item in RAM
+ */
+typedef struct GUI_STATIC_STATE_t {
+    int16_t Value;                          /*!< Item value, LED is on when not zero */
+    uint8_t Flags;                          /*!< Item flags, GUI_STATIC_FLAG_x values */
+} GUI_STATIC_STATE_t;
+
+/**
+ * \brief           Group structure
+ */
+typedef struct GUI_STATIC_t {
+    GUI_HANDLE C;                           /*!< GUI handle object, must always be first on list */
+    
+    GUI_Color_t Color[1];                   /*!< List of colors */
+    
+    const GUI_STATIC_ITEM_t* Items;         /*!< Item descriptions */
+    GUI_STATIC_STATE_t* State;              /*!< Item states */
+    uint16_t Count;                         /*!< Number of items */
+    uint16_t Pressed;                       /*!< Index of pressed button item */
+    void (*Callback)(GUI_HANDLE_t, GUI_ID_t);   /*!< Callback when button item is clicked */
+} GUI_STATIC_t;
+
+/**
+ * \} GUI_STATIC_Typedefs
+ */
+
+/**
+ * \defgroup        GUI_STATIC_Functions
+ * \brief           Library Functions
+ * \{
+ */
+
+/**
+ * \brief           Create group of items
+ * \note            Item descriptions are not copied and must stay valid while group exists
+ * \param[in]       id: Widget unique ID to use for identity for callback processing
+ * \param[in]       x: Widget X position relative to parent widget
+ * \param[in]       y: Widget Y position relative to parent widget
+ * \param[in]       width: Widget width in units of pixels
+ * \param[in]       height: Widget height in units of pixels
+ * \param[in]       items: Pointer to item descriptions
+ * \param[in]       count: Number of items
+ * \retval          Widget handle or NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
+GUI_HANDLE_t GUI_STATIC_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, const GUI_STATIC_ITEM_t* items, uint16_t count);
+void GUI_STATIC_Remove(GUI_HANDLE_t* h);
+GUI_HANDLE_t GUI_STATIC_SetColor(GUI_HANDLE_t h, GUI_STATIC_COLOR_t index, GUI_Color_t color);
+GUI_HANDLE_t GUI_STATIC_SetCallback(GUI_HANDLE_t h, void (*callback)(GUI_HANDLE_t, GUI_ID_t));
+
+/**
+ * \brief           Set item value
+ * \note            Item is redrawn only when value changes
+ * \param[in]       h: Widget handle
+ * \param[in]       id: Item ID
+ * \param[in]       value: New value. Progress bar value is limited to its range
+ * \retval          Widget handle
+ */
+GUI_HANDLE_t GUI_STATIC_SetValue(GUI_HANDLE_t h, GUI_ID_t id, int16_t value);
+int16_t GUI_STATIC_GetValue(GUI_HANDLE_t h, GUI_ID_t id);
+GUI_HANDLE_t GUI_STATIC_SetVisible(GUI_HANDLE_t h, GUI_ID_t id, GUI_Byte visible);
+GUI_HANDLE_t GUI_STATIC_SetEnabled(GUI_HANDLE_t h, GUI_ID_t id, GUI_Byte enabled);
+
+/**
+ * \} GUI_STATIC_Functions
+ */
+ 
+/**
+ * \} GUI_STATIC
+ */
+
+/**
+ * \} GUI_WIDGETS
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,6 +25,9 @@
  */
 #include "gui_widget.h"
 #include "gui_window.h"
+#include "gui_surface.h"
+#include "gui_anim.h"
+#include "gui_prof.h"
 
 /******************************************************************************/
 /******************************************************************************/
@@ -37,12 +40,16 @@
 /***                           Private definitions                           **/
 /******************************************************************************/
 /******************************************************************************/
+#define __OCCLUSION_MAX_PIECES      8           /* Maximal number of visible rectangles while checking occlusion */
+#define __WIDGET_ALIGN(x)           (((x) + 7) & ~7UL)  /* Align widget size in memory block */
 
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private variables                            **/
 /******************************************************************************/
 /******************************************************************************/
+static uint8_t* Memory;                         /* Memory block for new widgets, NULL to use allocation */
+static uint32_t MemorySize;                     /* Remaining bytes in memory block */
 
 /******************************************************************************/
 /******************************************************************************/
@@ -73,15 +80,113 @@ void __GUI_WIDGET_SetClippingRegion(void* ptr) {
 }
 
 uint8_t __GUI_WIDGET_IsInsideClippingRegion(void* ptr) {
+    GUI_Display_t* r = __GUI_STORE_GetRect(__GH(ptr));  /* Get widget absolute position */
+
+    return __GUI_RECT_MATCH(r->X1, r->Y1, w, h, GUI.Display.X1, GUI.Display.Y1, GUI.Display.X2 - GUI.Display.X1, GUI.Display.Y2 - GUI.Display.Y1);
+}
+#undef w
+#undef h
+
+/* Add visible rectangle to list, returns 0 when list is full */
+static uint8_t __OCCLUSION_Add(GUI_Display_t* pieces, uint8_t* count, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2) {
+    if (*count == __OCCLUSION_MAX_PIECES) {
+        return 0;
+    }
+    pieces[*count].X1 = x1;
+    pieces[*count].Y1 = y1;
+    pieces[*count].X2 = x2;
+    pieces[*count].Y2 = y2;
+    (*count)++;
+    return 1;
+}
+
+/* Remove occluding rectangle from list of visible rectangles, returns 0 when list is full */
+static uint8_t __OCCLUSION_Subtract(GUI_Display_t* pieces, uint8_t* count, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2) {
+    GUI_Display_t p;
+    GUI_Dim_t top, bottom;
+    uint8_t i = 0;
+    
+    while (i < *count) {
+        p = pieces[i];
+        if (x1 >= p.X2 || x2 <= p.X1 || y1 >= p.Y2 || y2 <= p.Y1) {  /* Piece is not covered */
+            i++;
+            continue;
+        }
+        pieces[i] = pieces[--(*count)];         /* Remove piece and add its uncovered parts */
+        top = p.Y1 > y1 ? p.Y1 : y1;
+        bottom = p.Y2 < y2 ? p.Y2 : y2;
+        if ((p.Y1 < y1 && !__OCCLUSION_Add(pieces, count, p.X1, p.Y1, p.X2, y1)) ||    /* Part above */
+            (p.Y2 > y2 && !__OCCLUSION_Add(pieces, count, p.X1, y2, p.X2, p.Y2)) ||    /* Part below */
+            (p.X1 < x1 && !__OCCLUSION_Add(pieces, count, p.X1, top, x1, bottom)) ||   /* Part on the left */
+            (p.X2 > x2 && !__OCCLUSION_Add(pieces, count, x2, top, p.X2, bottom))) {   /* Part on the right */
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Remove area of opaque widget from visible rectangles, returns 0 when list is full */
+static uint8_t __OCCLUSION_SubtractWidget(GUI_Display_t* pieces, uint8_t* count, GUI_HANDLE_t o) {
+    GUI_Display_t* r;
+    
+    if (!(GUI_Store.Flags[o->Index] & GUI_STORE_FLAG_OPAQUE)) { /* Only opaque widgets hide other widgets */
+        return 1;
+    }
+    r = __GUI_STORE_GetRect(o);
+    return __OCCLUSION_Subtract(pieces, count, r->X1, r->Y1, r->X2, r->Y2);
+}
+
+/*
+ * Check if part of widget inside clipping region is completely hidden behind opaque widgets
+ *
+ * Widgets drawn later are checked front to back: children when withChildren is set,
+ * next widgets on the same list and next widgets of every parent.
+ * Widgets outside surface of cached parent are not checked as they are not drawn to surface.
+ * When area is split to too many pieces, widget is treated as visible.
+ */
+uint8_t __GUI_WIDGET_IsOccluded(void* ptr, uint8_t withChildren) {
+    GUI_Display_t pieces[__OCCLUSION_MAX_PIECES];
+    GUI_HANDLE_t a, o;
     GUI_Dim_t x, y;
+    uint8_t count = 1;
     
     x = __GUI_WIDGET_GetAbsoluteX(ptr);         /* Get widget absolute X */
     y = __GUI_WIDGET_GetAbsoluteY(ptr);         /* Get widget absolute Y */
-
-    return __GUI_RECT_MATCH(x, y, w, h, GUI.Display.X1, GUI.Display.Y1, GUI.Display.X2 - GUI.Display.X1, GUI.Display.Y2 - GUI.Display.Y1);
+    
+    /* Start with visible part of widget */
+    pieces[0].X1 = GUI.Display.X1 > x ? GUI.Display.X1 : x;
+    pieces[0].Y1 = GUI.Display.Y1 > y ? GUI.Display.Y1 : y;
+    pieces[0].X2 = GUI.Display.X2 < (x + __GH(ptr)->Width) ? GUI.Display.X2 : (x + __GH(ptr)->Width);
+    pieces[0].Y2 = GUI.Display.Y2 < (y + __GH(ptr)->Height) ? GUI.Display.Y2 : (y + __GH(ptr)->Height);
+    if (pieces[0].X1 >= pieces[0].X2 || pieces[0].Y1 >= pieces[0].Y2) {
+        return 0;
+    }
+    
+    if (withChildren && __GH(ptr)->Widget->MetaData.AllowChildren) {    /* Children are drawn over widget */
+        for (o = __GUI_LINKEDLIST_GetNextWidget(__GHR(ptr), 0); o; o = __GUI_LINKEDLIST_GetNextWidget(NULL, o)) {
+            if (!__OCCLUSION_SubtractWidget(pieces, &count, o)) {
+                return 0;
+            }
+            if (!count) {
+                return 1;
+            }
+        }
+    }
+    for (a = __GH(ptr); a; a = a->Parent) {     /* Go through widgets with higher z-index */
+        for (o = __GUI_LINKEDLIST_GetNextWidget(NULL, a); o; o = __GUI_LINKEDLIST_GetNextWidget(NULL, o)) {
+            if (!__OCCLUSION_SubtractWidget(pieces, &count, o)) {
+                return 0;
+            }
+            if (!count) {
+                return 1;
+            }
+        }
+        if (a->Parent && (a->Parent->Flags & GUI_FLAG_CACHE)) { /* Stop at surface border */
+            break;
+        }
+    }
+    return 0;
 }
-#undef w
-#undef h
 
 /******************************************************************************/
 /******************************************************************************/
@@ -93,46 +198,28 @@ void __GUI_WIDGET_Init(void) {
 }
 
 GUI_Dim_t __GUI_WIDGET_GetAbsoluteX(void* ptr) {
-    /* Assuming linked list is first element in structure */
-    /* Second element is common structure */
-    GUI_HANDLE_t w = 0;
-    GUI_Dim_t out = 0;
-    
     if (ptr) {
-        w = ((GUI_HANDLE_t)ptr)->Parent;
-        out = ((GUI_HANDLE_t)ptr)->X;
+        return __GUI_STORE_GetRect(__GH(ptr))->X1;  /* Position is updated on every move of widget or its parents */
     }
-    
-    while (w) {                                 /* Go through all parent windows */
-        out += w->X;                            /* Add X offset from parent */
-        w = (GUI_HANDLE_t)w->Parent;            /* Get next parent */
-    }
-    return out;
+    return 0;
 }
 
 GUI_Dim_t __GUI_WIDGET_GetAbsoluteY(void* ptr) {
-    /* Assuming linked list is first element in structure */
-    /* Second element is common structure */
-    GUI_HANDLE_t w = 0;
-    GUI_Dim_t out = 0;
-    
     if (ptr) {
-        w = ((GUI_HANDLE_t)ptr)->Parent;
-        out = ((GUI_HANDLE_t)ptr)->Y;
+        return __GUI_STORE_GetRect(__GH(ptr))->Y1;  /* Position is updated on every move of widget or its parents */
     }
-    
-    while (w) {                                 /* Go through all parent windows */
-        out += w->Y;                            /* Add X offset from parent */
-        w = (GUI_HANDLE_t)w->Parent;            /* Get next parent */
-    }
-    return out;
+    return 0;
 }
 
 uint8_t __GUI_WIDGET_Invalidate(void* ptr) {
     GUI_HANDLE_t h1, h2;
     
     h1 = __GH(ptr);                             /* Get widget handle */
-    h1->Flags |= GUI_FLAG_REDRAW;               /* Redraw widget */
+    __GUI_WIDGET_SetRedraw(h1);                 /* Redraw widget */
+    __GUI_PROF_INVALIDATE();
+    if (h1->Flags & GUI_FLAG_CACHE) {           /* Widget itself changed */
+        __GUI_SURFACE_Invalidate(h1);           /* Draw cached surface again */
+    }
     
     __GUI_WIDGET_SetClippingRegion(ptr);        /* Set clipping region for widget redrawing operation */
     
@@ -146,12 +233,12 @@ uint8_t __GUI_WIDGET_Invalidate(void* ptr) {
     for (; h1; h1 = __GUI_LINKEDLIST_GetNextWidget(NULL, h1)) {
         for (h2 = __GUI_LINKEDLIST_GetNextWidget(NULL, h1); h2; h2 = __GUI_LINKEDLIST_GetNextWidget(NULL, h2)) {
             if (
-                h2->Flags & GUI_FLAG_REDRAW ||  /* Bit is already set */
+                __GUI_WIDGET_IsRedraw(h2) ||    /* Bit is already set */
                 !__GUI_RECT_MATCH(h1->X, h1->Y, h1->Width, h1->Height, h2->X, h2->Y, h2->Width, h2->Height)
             ) {
                 continue;
             }
-            h2->Flags |= GUI_FLAG_REDRAW;        /* Redraw widget on next loop */
+            __GUI_WIDGET_SetRedraw(h2);         /* Redraw widget on next loop */
         }
     }
     return 1;
@@ -160,7 +247,10 @@ uint8_t __GUI_WIDGET_Invalidate(void* ptr) {
 uint8_t __GUI_WIDGET_InvalidateWithParent(void* ptr) {
     __GUI_WIDGET_Invalidate(ptr);               /* Invalidate object */
     if (__GH(ptr)->Parent) {                    /* If parent exists, invalid only parent */
-        __GH(ptr)->Parent->Flags |= GUI_FLAG_REDRAW;    /* Redraw parent widget too */
+        __GUI_WIDGET_SetRedraw(__GH(ptr)->Parent);  /* Redraw parent widget too */
+        if (__GH(ptr)->Parent->Flags & GUI_FLAG_CACHE) {
+            __GUI_SURFACE_Invalidate(__GH(ptr)->Parent);    /* Parent content changed */
+        }
     }
     return 1;
 }
@@ -186,6 +276,7 @@ uint8_t __GUI_WIDGET_SetXY(void* ptr, GUI_iDim_t x, GUI_iDim_t y) {
             __GUI_WIDGET_SetClippingRegion(ptr);    /* Set new clipping region */
             __GH(ptr)->X = x;                       /* Set parameter */
             __GH(ptr)->Y = y;                       /* Set parameter */
+            __GUI_STORE_UpdateRect(ptr);            /* Move children too */
             __GUI_WIDGET_InvalidateWithParent(ptr); /* Invalidate object */
         }
     }
@@ -209,6 +300,7 @@ uint8_t __GUI_WIDGET_SetSize(void* ptr, GUI_Dim_t width, GUI_Dim_t height) {
         __GUI_WIDGET_SetClippingRegion(ptr);        /* Set clipping region before changed position */
         __GH(ptr)->Width = width;                   /* Set parameter */
         __GH(ptr)->Height = height;                 /* Set parameter */
+        __GUI_STORE_UpdateRect(ptr);
         __GUI_WIDGET_InvalidateWithParent(ptr);     /* Invalidate object */
     }
     return 1;
@@ -298,7 +390,19 @@ GUI_HANDLE_t __GUI_WIDGET_Create(const GUI_WIDGET_t* widget, GUI_ID_t id, GUI_iD
     
     __GUI_ASSERTPARAMS(widget);                     /* Check input parameters */
     
-    __GUI_MEMWIDALLOC(ptr, widget->MetaData.WidgetSize);    /* Allocate memory for widget */
+    if (Memory) {                                   /* Take memory from block set by user */
+        uint32_t size = __WIDGET_ALIGN(widget->MetaData.WidgetSize);
+        if (size > MemorySize) {
+            return NULL;
+        }
+        ptr = (GUI_HANDLE_t)Memory;
+        memset((void *)ptr, 0x00, size);
+        Memory += size;
+        MemorySize -= size;
+        ptr->Flags |= GUI_FLAG_EXTERNALMEM;         /* Memory is freed together with block */
+    } else {
+        __GUI_MEMWIDALLOC(ptr, widget->MetaData.WidgetSize);    /* Allocate memory for widget */
+    }
     if (ptr) {  
         GUI_Dim_t pW, pH;                           /* Parent width and height values */
         
@@ -333,6 +437,17 @@ GUI_HANDLE_t __GUI_WIDGET_Create(const GUI_WIDGET_t* widget, GUI_ID_t id, GUI_iD
         ptr->Y = y;                                 /* Set Y position relative to parent */
         ptr->Width = width;                         /* Set widget width */
         ptr->Height = height;                       /* Set widget height */
+        
+        if (!__GUI_STORE_Add(ptr)) {                /* No space for widget state */
+            GUI_LOG_ERROR("Widget store is full, increase GUI_STORE_SIZE\r\n");
+            if (ptr->Flags & GUI_FLAG_EXTERNALMEM) {
+                Memory -= __WIDGET_ALIGN(widget->MetaData.WidgetSize);  /* Return memory to block */
+                MemorySize += __WIDGET_ALIGN(widget->MetaData.WidgetSize);
+            } else {
+                __GUI_MEMWIDFREE(ptr);
+            }
+            return NULL;
+        }
 
         __GUI_LINKEDLIST_ADD((GUI_HANDLE_ROOT_t *)ptr->Parent, ptr);    /* Add entry to linkedlist of parent widget */
         __GUI_WIDGET_Invalidate(ptr);               /* Invalidate object */
@@ -342,16 +457,58 @@ GUI_HANDLE_t __GUI_WIDGET_Create(const GUI_WIDGET_t* widget, GUI_ID_t id, GUI_iD
 }
 
 uint8_t __GUI_WIDGET_Remove(GUI_HANDLE_t* h) {
+    GUI_HANDLE_t c;
+    
+    if ((*h)->Widget->WidgetRemove) {               /* Let widget release its resources first */
+        (*h)->Widget->WidgetRemove(*h);
+    }
+    
+    /* Remove children first, each of them releases its resources and memory */
+    if ((*h)->Index != GUI_STORE_NONE && (GUI_Store.Flags[(*h)->Index] & GUI_STORE_FLAG_LIST)) {
+        while ((c = __GUI_LINKEDLIST_GetNextWidget(__GHR(*h), 0)) != NULL) {
+            __GUI_WIDGET_Remove(&c);
+        }
+    }
+    
     if ((*h)->Flags & GUI_FLAG_DYNAMICTEXTALLOC) {  /* Check memory for text */
         __GUI_MEMFREE((*h)->Text);                  /* Free text memory */
     }
     
+    if ((*h)->Flags & GUI_FLAG_CACHE) {             /* Release surface */
+        GUI_SURFACE_DisableCache(*h);
+    }
+    
+    GUI_ANIM_CancelWidget(*h);                      /* Stop animations of widget */
+    
+    if (GUI.ActiveWidget == *h) {                   /* Do not keep pointers to removed widget */
+        GUI.ActiveWidget = NULL;
+    }
+    if (GUI.FocusedWidget == *h) {
+        GUI.FocusedWidget = NULL;
+    }
+    if (GUI.WindowActive == *h) {                   /* New widgets go to parent window */
+        GUI.WindowActive = (*h)->Parent;
+    }
+    
+    __GUI_STORE_Remove(*h);                         /* Release state of widget and its children */
     __GUI_LINKEDLIST_REMOVE(*h);                    /* Remove entry from linked list */
     if ((*h)->Parent) {                             /* If there is parent object */
         //TODO: Redraw only if deleted widget was visible on screen
         
-        (*h)->Parent->Flags |= GUI_FLAG_REDRAW;     /* Redraw widget */
+        __GUI_WIDGET_SetRedraw((*h)->Parent);       /* Redraw widget */
+        if ((*h)->Parent->Flags & GUI_FLAG_CACHE) {
+            __GUI_SURFACE_Invalidate((*h)->Parent); /* Parent content changed */
+        }
+    }
+    if ((*h)->Flags & GUI_FLAG_EXTERNALMEM) {       /* Memory is not owned by widget */
+        *h = NULL;
+    } else {
+        __GUI_MEMWIDFREE(*h);                       /* Free memory for widget */
     }
-    __GUI_MEMWIDFREE(h);                            /* Free memory for widget */
     return 1;
 }
+
+void __GUI_WIDGET_SetMemory(void* mem, uint32_t size) {
+    Memory = (uint8_t *)mem;                        /* Next widgets are placed in this block */
+    MemorySize = mem ? size : 0;
+}
@@ -44,6 +44,7 @@ extern "C" {
  */
 #include "gui.h"
 #include "gui_draw.h"
+#include "gui_store.h"
 
 /**
  * \defgroup        GUI_WIDGET_Macros
@@ -54,6 +55,28 @@ extern "C" {
 #define GUI_WIDGET_GetParentWidth(ptr)              (__GH(ptr)->Parent ? __GH(ptr)->Parent->Width : GUI.LCD.Width)
 #define GUI_WIDGET_GetParentHeight(ptr)             (__GH(ptr)->Parent ? __GH(ptr)->Parent->Height : GUI.LCD.Height)
 
+/**
+ * \brief           Set or clear opaque flag of widget
+ * \note            Widget must be set as opaque only when it covers its complete area without transparency.
+ *                  Widgets behind opaque widgets are not drawn.
+ */
+#define __GUI_WIDGET_SetOpaque(ptr, opaque)         do {    \
+    if (opaque) {                                           \
+        __GH(ptr)->Flags |= GUI_FLAG_OPAQUE;                \
+    } else {                                                \
+        __GH(ptr)->Flags &= ~GUI_FLAG_OPAQUE;               \
+    }                                                       \
+    __GUI_STORE_UpdateFlags(__GH(ptr));                     \
+} while (0)
+
+/**
+ * \brief           Mark widget for redraw on next frame
+ * \note            Use \ref __GUI_WIDGET_Invalidate to set clipping region and redraw widgets above it too
+ */
+#define __GUI_WIDGET_SetRedraw(ptr)                 __GUI_STORE_SetDirty(__GH(ptr))
+#define __GUI_WIDGET_ClearRedraw(ptr)               __GUI_STORE_ClearDirty(__GH(ptr))
+#define __GUI_WIDGET_IsRedraw(ptr)                  __GUI_STORE_IsDirty(__GH(ptr))
+
  /**
  * \defgroup        GUI_WIDGET_ID_Values
  * \brief           Macros for fast ID setup
@@ -124,11 +147,17 @@ uint8_t __GUI_WIDGET_SetText(void* ptr, const char* text);
 uint8_t __GUI_WIDGET_AllocateTextMemory(void* ptr, uint16_t size);
 uint8_t __GUI_WIDGET_FreeTextMemory(void* ptr);
 
+/**
+ * \brief           Allocate widget memory, add it to active window and widget store
+ * \note            Returns NULL when there is no memory or \ref GUI_STORE_SIZE widgets exist already
+ */
 GUI_HANDLE_t __GUI_WIDGET_Create(const GUI_WIDGET_t* widget, GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height);
+void __GUI_WIDGET_SetMemory(void* mem, uint32_t size);
 uint8_t __GUI_WIDGET_Remove(GUI_HANDLE_t* h);
 
 void __GUI_WIDGET_SetClippingRegion(void* ptr);
 uint8_t __GUI_WIDGET_IsInsideClippingRegion(void* ptr);
+uint8_t __GUI_WIDGET_IsOccluded(void* ptr, uint8_t withChildren);
 
 /**
  * \} GUI_WIDGET_Functions
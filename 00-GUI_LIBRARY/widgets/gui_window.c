@@ -86,6 +86,7 @@ GUI_HANDLE_t GUI_WINDOW_Create(GUI_ID_t id) {
     ptr = (GUI_WINDOW_t *)__GUI_WIDGET_Create(&Widget, id, 0, 0, GUI.LCD.Width, GUI.LCD.Height);    /* Allocate memory for basic widget */
     if (ptr) {
         ptr->Color[GUI_WINDOW_COLOR_BG] = GUI_COLOR_LIGHTGRAY;  /* Set default color */
+        __GUI_WIDGET_SetOpaque(ptr, 1);             /* Window background covers complete window */
         
         __GUI_WINDOW_SETACTIVE(ptr);                /* Set active window */
     }
@@ -101,6 +102,7 @@ GUI_HANDLE_t GUI_WINDOW_CreateChild(GUI_ID_t id, GUI_Dim_t x, GUI_Dim_t y, GUI_D
     ptr = (GUI_WINDOW_t *)__GUI_WIDGET_Create(&Widget, id, x, y, width, height);    /* Allocate memory for basic widget */
     if (ptr) {        
         ptr->Color[GUI_WINDOW_COLOR_BG] = GUI_COLOR_LIGHTGRAY;  /* Set default color */
+        __GUI_WIDGET_SetOpaque(ptr, 1);             /* Window background covers complete window */
         
         /* Control setup */
         __GH(ptr)->Flags |= GUI_FLAG_CHILD;         /* This window is child window */
@@ -117,6 +119,9 @@ GUI_HANDLE_t GUI_WINDOW_SetColor(GUI_HANDLE_t h, GUI_WINDOW_COLOR_t index, GUI_C
     
     if (__GW(h)->Color[index] != color) {
         __GW(h)->Color[index] = color;              /* Set property */
+        if (index == GUI_WINDOW_COLOR_BG) {
+            __GUI_WIDGET_SetOpaque(h, !(color & 0xFF000000));   /* Transparent background shows widgets behind window */
+        }
         __GUI_WIDGET_Invalidate(h);                 /* Redraw widget */
     }
     
@@ -48,10 +48,14 @@ CTS         PA3                 RTS from ST to CTS from GSM
 #include "tm_stm32_disco.h"
 #include "tm_stm32_delay.h"
 #include "tm_stm32_usart.h"
+#include "tm_stm32_usart_dma.h"
 #include "tm_stm32_touch.h"
 #include "tm_stm32_exti.h"
 #include "cmsis_os.h"
 #include "tm_stm32_general.h"
+#include "tm_stm32_i2c.h"
+#include "tm_stm32_touch_ft5336.h"
+#include "touch_async.h"
 
 #include "gui.h"
 #include "gui_window.h"
@@ -59,8 +63,18 @@ CTS         PA3                 RTS from ST to CTS from GSM
 #include "gui_led.h"
 #include "gui_progbar.h"
 #include "gui_graph.h"
+#include "gui_prof.h"
 
 TM_TOUCH_t TS;
+TOUCH_ASYNC_t TA;
+
+static uint8_t TouchStart(uint8_t reg, uint8_t* data, uint16_t count);
+static void TouchReady(TM_TOUCH_t* ts);
+static uint32_t LogSend(const void* data, uint32_t count);
+static uint8_t LogBusy(void);
+#if GUI_PROF_ENABLED
+static uint32_t ProfCounter(void);
+#endif
 
 GUI_HANDLE_t btn1, btn2, btn3, btn4, btn5, btn6;
 GUI_HANDLE_t led[8][2];
@@ -84,6 +98,8 @@ int main(void) {
     TM_DISCO_ButtonInit();                                  /* Init button */
     TM_DELAY_Init();                                        /* Init delay */
     TM_USART_Init(DISCO_USART, DISCO_USART_PP, 115200);     /* Init USART for debug purpose */
+    TM_USART_DMA_Init(DISCO_USART);                         /* GUI log is sent with DMA */
+    GUI_LOG_SetOutput(LogSend, LogBusy);
     
     /* Print first screen message */
     printf("GUI; Compiled: %s %s, sizeof: %d\r\n", __DATE__, __TIME__, sizeof(char *) * 5);
@@ -91,6 +107,9 @@ int main(void) {
     TM_GENERAL_DWTCounterEnable();
     
     GUI_Init();
+#if GUI_PROF_ENABLED
+    GUI_PROF_SetCounter(ProfCounter);                       /* Profile in CPU cycles */
+#endif
     
     //2 buttons on main
     win1 = GUI_WINDOW_CreateChild(1, 0, 0, GUI.LCD.Width, 30);
@@ -124,9 +143,16 @@ int main(void) {
     GUI_PROGBAR_SetFont(prog1, &GUI_Font_Arial_Bold_18);
     GUI_PROGBAR_SetText(prog1, "Test1");
 
-    TM_EXTI_Attach(GPIOI, GPIO_PIN_13, TM_EXTI_Trigger_Rising);
     TS.Orientation = 1;
     TM_TOUCH_Init(NULL, &TS);
+    
+    /* Touch is read with I2C interrupts, EXTI only starts reading */
+    TOUCH_ASYNC_Init(&TA, &TS, TouchStart, TouchReady);
+    HAL_NVIC_SetPriority(I2C3_EV_IRQn, EXTI_NVIC_PRIORITY, 0);
+    HAL_NVIC_SetPriority(I2C3_ER_IRQn, EXTI_NVIC_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(I2C3_EV_IRQn);
+    HAL_NVIC_EnableIRQ(I2C3_ER_IRQn);
+    TM_EXTI_Attach(GPIOI, GPIO_PIN_13, TM_EXTI_Trigger_Rising);
   
 //    time = TM_DELAY_Time();
     state = 40;
@@ -141,6 +167,7 @@ int main(void) {
 
 /* 1ms handler */
 void TM_DELAY_1msHandler() {
+    GUI_UpdateTime(1);                      /* Update GUI time for animations */
     //osSystickHandler();                     /* Kernel systick handler processing */
 }
 
@@ -150,21 +177,86 @@ int fputc(int ch, FILE* fil) {
     return ch;
 }
 
+/* Start sending GUI log block with DMA */
+static uint32_t LogSend(const void* data, uint32_t count) {
+#if defined(STM32F7xx)
+    uint32_t addr;
+#endif
+    
+    if (count > 0xFFFF) {                       /* DMA counter is 16-bit */
+        count = 0xFFFF;
+    }
+#if defined(STM32F7xx)
+    addr = (uint32_t)data & ~0x1FUL;           /* Clean cache lines covering data before DMA reads memory */
+    SCB_CleanDCache_by_Addr((uint32_t *)addr, (int32_t)((uint32_t)data + count - addr));
+#endif
+    return TM_USART_DMA_Send(DISCO_USART, (uint8_t *)data, count) ? count : 0;
+}
+
+/* Check if log DMA transfer is still active */
+static uint8_t LogBusy(void) {
+    return TM_USART_DMA_Transmitting(DISCO_USART) ? 1 : 0;
+}
+
+#if GUI_PROF_ENABLED
+/* Cycle counter for GUI profiler */
+static uint32_t ProfCounter(void) {
+    return TM_GENERAL_DWTCounterGetValue();
+}
+#endif
+
 void TM_EXTI_Handler(uint16_t GPIO_Pin) {
-    static GUI_TouchData_t p;
     if (GPIO_Pin == GPIO_PIN_13) {
-        GUI_TouchData_t t;
-        TM_TOUCH_Read(&TS);
-        
-        memset((void *)&t, 0x00, sizeof(t));
-        t.X = TS.X[0];
-        t.Y = TS.Y[0];
-        t.Status = TS.NumPresses ? GUI_TouchState_PRESSED : GUI_TouchState_RELEASED;
-        
-        /* Check differences */
-        if (memcmp(&p, &t, sizeof(p)) || t.Status == GUI_TouchState_RELEASED) {
-            GUI_INPUT_AddTouch(&t);
-            memcpy(&p, &t, sizeof(p));
-        }
+        TOUCH_ASYNC_Signal(&TA);            /* Read touch in background */
+    }
+}
+
+/* Start reading touch registers with interrupts */
+static uint8_t TouchStart(uint8_t reg, uint8_t* data, uint16_t count) {
+    return HAL_I2C_Mem_Read_IT(TM_I2C_GetHandle(TOUCH_FT5336_I2C), TOUCH_FT5336_I2C_DEV, reg, I2C_MEMADD_SIZE_8BIT, data, count) != HAL_OK;
+}
+
+/* New touch data, called from I2C interrupt */
+static void TouchReady(TM_TOUCH_t* ts) {
+    static GUI_TouchData_t p;
+    GUI_TouchData_t t;
+    uint8_t i;
+    
+    memset((void *)&t, 0x00, sizeof(t));
+    t.Count = ts->NumPresses > GUI_TOUCH_MAX_PRESSES ? GUI_TOUCH_MAX_PRESSES : ts->NumPresses;
+    for (i = 0; i < t.Count; i++) {
+        t.X[i] = ts->X[i];
+        t.Y[i] = ts->Y[i];
+    }
+    if (!t.Count) {                         /* Keep last position on release */
+        t.X[0] = p.X[0];
+        t.Y[0] = p.Y[0];
     }
+    t.Status = t.Count ? GUI_TouchState_PRESSED : GUI_TouchState_RELEASED;
+    
+    /* Check differences */
+    if (memcmp(&p, &t, sizeof(p)) || t.Status == GUI_TouchState_RELEASED) {
+        GUI_INPUT_AddTouch(&t);
+        memcpy(&p, &t, sizeof(p));
+    }
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c) {
+    if (hi2c->Instance == TOUCH_FT5336_I2C) {
+        TOUCH_ASYNC_Complete(&TA, 1);
+    }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c) {
+    if (hi2c->Instance == TOUCH_FT5336_I2C) {
+        TOUCH_ASYNC_Complete(&TA, 0);
+    }
+}
+
+void I2C3_EV_IRQHandler(void) {
+    HAL_I2C_EV_IRQHandler(TM_I2C_GetHandle(TOUCH_FT5336_I2C));
+}
+
+void I2C3_ER_IRQHandler(void) {
+    HAL_I2C_ER_IRQHandler(TM_I2C_GetHandle(TOUCH_FT5336_I2C));
 }
@@ -0,0 +1,100 @@
+/**
+ * Non-blocking touch reading for FT5336 controller
+ */
+#include "touch_async.h"
+
+/* Check if failed transfer can be repeated */
+static uint8_t TOUCH_ASYNC_Retry(TOUCH_ASYNC_t* TA) {
+	TA->Errors++;
+	if (TA->Retries < TOUCH_ASYNC_RETRIES) {
+		TA->Retries++;
+		return 1;
+	}
+	TA->Retries = 0;
+	return 0;
+}
+
+/* Start new transfer and clear pending request */
+static void TOUCH_ASYNC_Start(TOUCH_ASYNC_t* TA) {
+	TA->Pending = 0;
+	TA->State = TOUCH_ASYNC_State_Reading;
+	while (TA->Start(TOUCH_ASYNC_REG, TA->Data, TOUCH_ASYNC_SIZE)) {
+		if (!TOUCH_ASYNC_Retry(TA)) {
+			/* Bus stays busy, wait for next signal */
+			TA->State = TOUCH_ASYNC_State_Idle;
+			return;
+		}
+	}
+}
+
+void TOUCH_ASYNC_Init(TOUCH_ASYNC_t* TA, TM_TOUCH_t* TS, uint8_t (*start)(uint8_t, uint8_t*, uint16_t), void (*ready)(TM_TOUCH_t*)) {
+	memset((void *)TA, 0x00, sizeof(TOUCH_ASYNC_t));
+	TA->TS = TS;
+	TA->Start = start;
+	TA->Ready = ready;
+}
+
+void TOUCH_ASYNC_Signal(TOUCH_ASYNC_t* TA) {
+	if (TA->State == TOUCH_ASYNC_State_Idle) {
+		TOUCH_ASYNC_Start(TA);
+	} else {
+		/* Read again when current transfer is done, data may be old already */
+		TA->Pending = 1;
+	}
+}
+
+void TOUCH_ASYNC_Complete(TOUCH_ASYNC_t* TA, uint8_t ok) {
+	if (TA->State != TOUCH_ASYNC_State_Reading) {
+		return;
+	}
+	TA->State = TOUCH_ASYNC_State_Idle;
+	if (ok && !TOUCH_ASYNC_Parse(TA->TS, TA->Data)) {
+		TA->Reads++;
+		TA->Retries = 0;
+		if (TA->Ready) {
+			TA->Ready(TA->TS);
+		}
+	} else if (TOUCH_ASYNC_Retry(TA)) {
+		/* Read again, touch may be released before next signal */
+		TOUCH_ASYNC_Start(TA);
+		return;
+	}
+	if (TA->Pending) {
+		TOUCH_ASYNC_Start(TA);
+	}
+}
+
+uint8_t TOUCH_ASYNC_Parse(TM_TOUCH_t* TS, const uint8_t* data) {
+	const uint8_t* p;
+	uint8_t i, num;
+	uint16_t tmp;
+	
+	/* Check number of touches */
+	num = data[0] & 0x0F;
+	if (num > TOUCH_ASYNC_MAX_POINTS) {
+		return 1;
+	}
+	TS->NumPresses = num;
+	
+	/* Format touches, same as blocking driver */
+	for (i = 0; i < num; i++) {
+		p = &data[1 + i * TOUCH_ASYNC_POINT_SIZE];
+		TS->Y[i] = (p[1]) | ((p[0] & 0x0F) << 8);
+		TS->X[i] = (p[3]) | ((p[2] & 0x0F) << 8);
+		
+		/* Check for orientations */
+		if (TS->Orientation == 0) {
+			TS->X[i] = TS->MaxX - TS->X[i];
+			TS->Y[i] = TS->MaxY - TS->Y[i];
+		} else if (TS->Orientation == 2) {
+			tmp = TS->X[i];
+			TS->X[i] = TS->MaxY - TS->Y[i];
+			TS->Y[i] = tmp;
+		} else if (TS->Orientation == 3) {
+			tmp = TS->X[i];
+			TS->X[i] = TS->Y[i];
+			TS->Y[i] = TS->MaxX - tmp;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @brief   Non-blocking touch reading for FT5336 controller
+ *
+ * EXTI interrupt only signals new touch data, all touch points are then
+ * read with single interrupt or DMA driven I2C transfer.
+ * Reading logic does not depend on HAL, transfer is started with user function
+ * and its completion is reported back with @ref TOUCH_ASYNC_Complete.
+ *
+ * EXTI and I2C interrupts must have the same preemption priority,
+ * functions below are not reentrant.
+ */
+#ifndef TOUCH_ASYNC_H
+#define TOUCH_ASYNC_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stdint.h"
+#include "string.h"
+#include "tm_stm32_touch.h"
+
+/* First register read in burst, touch status followed by all touch points */
+#define TOUCH_ASYNC_REG             0x02
+#define TOUCH_ASYNC_POINT_SIZE      6
+#define TOUCH_ASYNC_MAX_POINTS      5
+#define TOUCH_ASYNC_SIZE            (1 + TOUCH_ASYNC_MAX_POINTS * TOUCH_ASYNC_POINT_SIZE)
+
+/* Number of times failed transfer is repeated before waiting for next signal */
+#ifndef TOUCH_ASYNC_RETRIES
+#define TOUCH_ASYNC_RETRIES         3
+#endif
+
+/**
+ * @brief  Reading state
+ */
+typedef enum {
+	TOUCH_ASYNC_State_Idle = 0x00,          /*!< No transfer in progress */
+	TOUCH_ASYNC_State_Reading               /*!< Waiting for transfer to complete */
+} TOUCH_ASYNC_State_t;
+
+/**
+ * @brief  Touch reader structure
+ */
+typedef struct TOUCH_ASYNC_t {
+	volatile TOUCH_ASYNC_State_t State;     /*!< Current state */
+	volatile uint8_t Pending;               /*!< New data was signaled during transfer */
+	uint8_t Retries;                        /*!< Number of repeated transfers after failure */
+	uint8_t Data[TOUCH_ASYNC_SIZE];         /*!< Raw register values */
+	TM_TOUCH_t* TS;                         /*!< Touch data updated after each transfer */
+	uint32_t Reads;                         /*!< Number of completed transfers */
+	uint32_t Errors;                        /*!< Number of failed transfers */
+	uint8_t (*Start)(uint8_t reg, uint8_t* data, uint16_t count);  /*!< Start non-blocking read, returns 0 on success */
+	void (*Ready)(TM_TOUCH_t* TS);          /*!< Called with new touch data */
+} TOUCH_ASYNC_t;
+
+/**
+ * @brief  Initializes touch reader
+ * @param  *TA: Pointer to reader structure
+ * @param  *TS: Pointer to touch structure with orientation and limits set
+ * @param  *start: Function to start non-blocking register read
+ * @param  *ready: Function called with new touch data from completion interrupt
+ * @retval None
+ */
+void TOUCH_ASYNC_Init(TOUCH_ASYNC_t* TA, TM_TOUCH_t* TS, uint8_t (*start)(uint8_t, uint8_t*, uint16_t), void (*ready)(TM_TOUCH_t*));
+
+/**
+ * @brief  Signals new touch data, call from EXTI interrupt
+ * @note   Transfer is started if idle, otherwise it is repeated after current one
+ * @param  *TA: Pointer to reader structure
+ * @retval None
+ */
+void TOUCH_ASYNC_Signal(TOUCH_ASYNC_t* TA);
+
+/**
+ * @brief  Reports end of transfer, call from I2C completion or error interrupt
+ * @note   Failed transfer is repeated up to @ref TOUCH_ASYNC_RETRIES times
+ * @param  *TA: Pointer to reader structure
+ * @param  ok: 1 when transfer succeeded, 0 on error
+ * @retval None
+ */
+void TOUCH_ASYNC_Complete(TOUCH_ASYNC_t* TA, uint8_t ok);
+
+/**
+ * @brief  Decodes raw registers to touch structure
+ * @param  *TS: Pointer to touch structure
+ * @param  *data: Registers starting with @ref TOUCH_ASYNC_REG
+ * @retval 0 on success, 1 on invalid data
+ */
+uint8_t TOUCH_ASYNC_Parse(TM_TOUCH_t* TS, const uint8_t* data);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,221 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "buffer.h"
+#include <pthread.h>
+#include <sched.h>
+
+/*
+ * Throughput of cyclic buffer and single producer single consumer buffer.
+ * Single thread writes and reads chunks in turn, two threads stream data through buffer.
+ * Cyclic buffer is not safe with producer and consumer in different threads, it is measured in single thread only.
+ *
+ * Search is measured on full buffer of few megabytes with data wrapped around memory end,
+ * byte by byte search with wrap check on every byte is reference.
+ */
+#define BENCH_SIZE                  4096
+#define BENCH_BYTES                 (64UL * 1024 * 1024)
+#define FIND_SIZE                   (4UL * 1024 * 1024)
+#define FIND_RUNS                   8
+
+static uint8_t src[BENCH_SIZE], dst[BENCH_SIZE];
+
+static void Print(const char* name, uint32_t chunk, uint64_t time) {
+    printf("%-28s %5u B chunks %10.1f MB/s\n", name, (unsigned)chunk, BENCH_BYTES * 1e3 / time);
+}
+
+static void BenchBuffer(uint32_t chunk) {
+    BUFFER_t b;
+    uint64_t start;
+    uint32_t i;
+    
+    BUFFER_Init(&b, BENCH_SIZE, NULL);
+    start = GUI_TEST_Now();
+    for (i = 0; i < BENCH_BYTES; i += chunk) {
+        BUFFER_Write(&b, src, chunk);
+        BUFFER_Read(&b, dst, chunk);
+    }
+    Print("BUFFER_t write/read", chunk, GUI_TEST_Now() - start);
+    BUFFER_Free(&b);
+}
+
+static void BenchSPSC(uint32_t chunk) {
+    BUFFER_SPSC_t b;
+    uint64_t start;
+    uint32_t i;
+    
+    BUFFER_SPSC_Init(&b, BENCH_SIZE, NULL);
+    start = GUI_TEST_Now();
+    for (i = 0; i < BENCH_BYTES; i += chunk) {
+        BUFFER_SPSC_Write(&b, src, chunk);
+        BUFFER_SPSC_Read(&b, dst, chunk);
+    }
+    Print("BUFFER_SPSC_t write/read", chunk, GUI_TEST_Now() - start);
+    BUFFER_SPSC_Free(&b);
+}
+
+static void BenchSPSCZeroCopy(uint32_t chunk) {
+    BUFFER_SPSC_t b;
+    uint64_t start;
+    uint32_t i, n;
+    const void* peek;
+    void* mem;
+    
+    BUFFER_SPSC_Init(&b, BENCH_SIZE, NULL);
+    start = GUI_TEST_Now();
+    for (i = 0; i < BENCH_BYTES; i += n) {
+        n = BUFFER_SPSC_Reserve(&b, &mem);
+        n = n < chunk ? n : chunk;
+        memset(mem, (uint8_t)i, n);         /* Produce data in place */
+        BUFFER_SPSC_Commit(&b, n);
+        n = BUFFER_SPSC_Peek(&b, &peek);
+        BUFFER_SPSC_Consume(&b, n);
+    }
+    Print("BUFFER_SPSC_t reserve/peek", chunk, GUI_TEST_Now() - start);
+    BUFFER_SPSC_Free(&b);
+}
+
+/* Two threads */
+static BUFFER_SPSC_t stream;
+static uint32_t streamChunk;
+
+static void* Producer(void* arg) {
+    uint32_t pos = 0, n, len;
+    
+    while (pos < BENCH_BYTES) {
+        len = BENCH_BYTES - pos < streamChunk ? BENCH_BYTES - pos : streamChunk;
+        n = BUFFER_SPSC_Write(&stream, src, len);
+        if (!n) {
+            sched_yield();
+        }
+        pos += n;
+    }
+    return NULL;
+}
+
+static void BenchStream(uint32_t chunk) {
+    pthread_t t;
+    uint64_t start;
+    uint32_t pos = 0, n;
+    
+    BUFFER_SPSC_Init(&stream, BENCH_SIZE, NULL);
+    streamChunk = chunk;
+    start = GUI_TEST_Now();
+    pthread_create(&t, NULL, Producer, NULL);
+    while (pos < BENCH_BYTES) {
+        n = BUFFER_SPSC_Read(&stream, dst, chunk);
+        if (!n) {
+            sched_yield();
+        }
+        pos += n;
+    }
+    pthread_join(t, NULL);
+    Print("BUFFER_SPSC_t 2 threads", chunk, GUI_TEST_Now() - start);
+    BUFFER_SPSC_Free(&stream);
+}
+
+/* Reference search, compares sequence on every position and checks for memory end on every byte */
+static int32_t FindBytes(BUFFER_t* b, const uint8_t* seq, uint32_t size) {
+    uint32_t full = BUFFER_GetFull(b), i, k;
+    
+    for (i = 0; i + size <= full; i++) {
+        for (k = 0; k < size && b->Buffer[(b->Out + i + k) % b->Size] == seq[k]; k++);
+        if (k == size) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void PrintFind(const char* name, uint64_t time) {
+    printf("%-36s %10.1f MB/s\n", name, (double)FIND_SIZE * FIND_RUNS * 1e3 / time);
+}
+
+static void BenchFindCase(BUFFER_t* b, const char* name, const uint8_t* seq, uint32_t size) {
+    char text[64];
+    uint64_t start;
+    int32_t pos = 0, ref = 0;
+    uint32_t i;
+    
+    start = GUI_TEST_Now();
+    for (i = 0; i < FIND_RUNS; i++) {
+        pos = size == 1 ? BUFFER_FindElement(b, seq[0]) : BUFFER_Find(b, seq, size);
+    }
+    PrintFind(name, GUI_TEST_Now() - start);
+    
+    start = GUI_TEST_Now();
+    for (i = 0; i < FIND_RUNS; i++) {
+        ref = FindBytes(b, seq, size);
+    }
+    sprintf(text, "%s (bytes)", name);
+    PrintFind(text, GUI_TEST_Now() - start);
+    if (pos != ref) {
+        printf("%s: position %d, expected %d\n", name, (int)pos, (int)ref);
+    }
+}
+
+static void BenchFind(void) {
+    static uint8_t data[FIND_SIZE], seq[64];
+    uint32_t seed = 1, i;
+    BUFFER_t b;
+    
+    BUFFER_Init(&b, FIND_SIZE + 1, NULL);
+    
+    /* Random text, sequences are not in buffer */
+    for (i = 0; i < FIND_SIZE; i++) {
+        seed = seed * 1103515245UL + 12345;
+        data[i] = 'a' + (seed >> 16) % 26;
+    }
+    b.In = b.Out = FIND_SIZE / 2;           /* Wrap data around memory end */
+    BUFFER_Write(&b, data, FIND_SIZE);
+    BenchFindCase(&b, "FindElement, text", (const uint8_t *)"#", 1);
+    BenchFindCase(&b, "Find 8 bytes, text", (const uint8_t *)"bufferxy", 8);
+    
+    /* Repeated byte, every position is partial match */
+    memset(data, 'a', FIND_SIZE);
+    memset(seq, 'a', sizeof(seq));
+    seq[15] = seq[sizeof(seq) - 1] = 'b';
+    BUFFER_Reset(&b);
+    b.In = b.Out = FIND_SIZE / 2;
+    BUFFER_Write(&b, data, FIND_SIZE);
+    BenchFindCase(&b, "Find 16 bytes, repeated", seq, 16);
+    BenchFindCase(&b, "Find 64 bytes, repeated", seq, sizeof(seq));
+    BUFFER_Free(&b);
+}
+
+int main(void) {
+    static const uint32_t chunks[] = {1, 16, 256, 2048};
+    uint32_t i;
+    
+    for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        BenchBuffer(chunks[i]);
+        BenchSPSC(chunks[i]);
+        BenchSPSCZeroCopy(chunks[i]);
+        BenchStream(chunks[i]);
+    }
+    BenchFind();
+    return 0;
+}
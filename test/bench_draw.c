@@ -0,0 +1,116 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_draw.h"
+
+/*
+ * Filled triangles per second for different triangle sizes.
+ * Triangles have random vertices inside square of given size, placed randomly on LCD.
+ * Anti-aliased circles per second when only small part of circle edge is visible.
+ */
+#define BENCH_TRIANGLES             256     /* Number of different triangles */
+#define BENCH_TIME                  200000000ULL    /* Time for each size in units of nanoseconds */
+
+static GUI_Display_t disp = {0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT};
+static GUI_DRAW_Poly_t tri[BENCH_TRIANGLES][3];
+
+static uint32_t seed = 1;
+static int32_t Random(int32_t max) {
+    seed = seed * 1103515245UL + 12345;
+    return (int32_t)((seed >> 8) % (uint32_t)max);
+}
+
+static void Bench(int32_t size) {
+    GUI_TEST_Pixels_t pixels;
+    uint64_t start, time;
+    uint32_t i, j, count = 0;
+    int32_t x, y;
+    
+    for (i = 0; i < BENCH_TRIANGLES; i++) {
+        x = Random(GUI_TEST_WIDTH - size + 1);
+        y = Random(GUI_TEST_HEIGHT - size + 1);
+        for (j = 0; j < 3; j++) {
+            tri[i][j].X = x + Random(size + 1);
+            tri[i][j].Y = y + Random(size + 1);
+        }
+    }
+    
+    GUI_TEST_GetPixels(&pixels);
+    start = GUI_TEST_Now();
+    do {
+        for (i = 0; i < BENCH_TRIANGLES; i++, count++) {
+            GUI_DRAW_FilledTriangle(&disp, tri[i][0].X, tri[i][0].Y, tri[i][1].X, tri[i][1].Y, tri[i][2].X, tri[i][2].Y, 0x00FF00);
+        }
+        time = GUI_TEST_Now() - start;
+    } while (time < BENCH_TIME);
+    GUI_TEST_GetPixels(&pixels);
+    
+    printf("%5d px %12.0f triangles/s %10.1f Mpixels/s\n", (int)size,
+        count * 1e9 / time, pixels.Drawn * 1e3 / time);
+}
+
+/* Anti-aliased circles of radius r around LCD center, drawn in 32x32 clipping region on circle edge */
+static void BenchCircle(GUI_Dim_t r, uint8_t filled) {
+    GUI_Display_t clip;
+    uint64_t start, time;
+    uint32_t count = 0;
+    GUI_Dim_t x = GUI_TEST_WIDTH / 2, y = r + 100;
+    
+    clip.X1 = x - 16;                       /* Top edge of circle */
+    clip.Y1 = 100 - 16;
+    clip.X2 = clip.X1 + 32;
+    clip.Y2 = clip.Y1 + 32;
+    start = GUI_TEST_Now();
+    do {
+        if (filled) {
+            GUI_DRAW_FilledCircleAA(&clip, x, y, r, 0x00FF00);
+        } else {
+            GUI_DRAW_CircleAA(&clip, x, y, r, 0x00FF00);
+        }
+        count++;
+        time = GUI_TEST_Now() - start;
+    } while (time < BENCH_TIME);
+    
+    printf("%5d px %-7s %12.0f circles/s\n", (int)r, filled ? "filled" : "ring", count * 1e9 / time);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    
+    printf("Filled triangles, random vertices in square of size:\n");
+    Bench(4);
+    Bench(16);
+    Bench(64);
+    Bench(128);
+    Bench(256);
+    
+    printf("Anti-aliased circles in 32x32 clipping region, radius:\n");
+    BenchCircle(100, 0);
+    BenchCircle(100, 1);
+    BenchCircle(2000, 0);
+    BenchCircle(2000, 1);
+    return 0;
+}
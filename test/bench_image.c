@@ -0,0 +1,162 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_draw.h"
+
+/*
+ * Decode speed and flash size of full screen image in different formats.
+ *
+ * Image looks like user interface screen: flat panels and bars with palette colors,
+ * plus photo-like area with noise which does not compress. All formats show the same picture,
+ * RGB565 is made from palette colors and ARGB8888 is reference without any saving.
+ * Speed is measured for complete image and for bottom right quarter, where RLE8 must
+ * decode and drop pixels before every visible row.
+ */
+#define WIDTH                       GUI_TEST_WIDTH
+#define HEIGHT                      GUI_TEST_HEIGHT
+#define BENCH_TIME                  200000000ULL    /* Time for each case in units of nanoseconds */
+
+static uint32_t palette[256];
+static uint8_t indexes[WIDTH * HEIGHT];
+static uint16_t rgb565[WIDTH * HEIGHT];
+static uint32_t argb[WIDTH * HEIGHT];
+static uint8_t rle[WIDTH * HEIGHT * 2];
+static uint32_t seed = 1;
+
+static uint32_t Random(uint32_t max) {
+    seed = seed * 1103515245UL + 12345;
+    return (seed >> 16) % max;
+}
+
+/* Compress indexes with runs of equal bytes and literal packets */
+static uint32_t EncodeRLE(const uint8_t* src, uint32_t count, uint8_t* dst) {
+    uint32_t i = 0, n, len = 0;
+    
+    while (i < count) {
+        for (n = 1; i + n < count && n < 128 && src[i + n] == src[i]; n++);
+        if (n >= 3) {                       /* Repeat packet */
+            dst[len++] = 0x80 | (n - 1);
+            dst[len++] = src[i];
+            i += n;
+            continue;
+        }
+        for (n = 1; i + n < count && n < 128; n++) {    /* Literal packet until next run */
+            if (i + n + 2 < count && src[i + n] == src[i + n + 1] && src[i + n] == src[i + n + 2]) {
+                break;
+            }
+        }
+        dst[len++] = n - 1;
+        memcpy(&dst[len], &src[i], n);
+        len += n;
+        i += n;
+    }
+    return len;
+}
+
+static void Generate(void) {
+    uint32_t i, x, y, c;
+    
+    for (i = 0; i < 256; i++) {
+        palette[i] = 0xFF000000UL | ((i * 0x9E3779B1UL) & 0x00FFFFFFUL);
+    }
+    for (y = 0; y < HEIGHT; y++) {
+        for (x = 0; x < WIDTH; x++) {
+            i = y * WIDTH + x;
+            if (y < 32) {                   /* Title bar */
+                indexes[i] = 1;
+            } else if (x < 120) {           /* Menu with buttons */
+                indexes[i] = ((y - 32) % 40) < 34 && x > 8 && x < 112 ? 2 + (y - 32) / 40 : 3;
+            } else if (x >= 300 && y >= 60 && y < 220) {    /* Photo */
+                indexes[i] = Random(256);
+            } else {                        /* Background with progress bars */
+                indexes[i] = (y % 30) < 12 && x < 120 + (y / 30) * 20 ? 20 + y / 30 : 4;
+            }
+            c = palette[indexes[i]];
+            argb[i] = c;
+            rgb565[i] = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+        }
+    }
+}
+
+static void Bench(const char* name, const GUI_IMAGE_DESC_t* img, uint32_t size) {
+    static const GUI_Display_t clips[] = {
+        {0, 0, WIDTH, HEIGHT},
+        {WIDTH / 2, HEIGHT / 2, WIDTH, HEIGHT},
+    };
+    GUI_Display_t clip;
+    uint64_t start, time;
+    uint32_t count, pixels;
+    uint8_t c;
+    
+    printf("%-10s %8u bytes %6.1f %% of ARGB8888", name, (unsigned)size, 100.0 * size / (WIDTH * HEIGHT * 4));
+    for (c = 0; c < 2; c++) {
+        clip = clips[c];
+        pixels = (uint32_t)(clip.X2 - clip.X1) * (clip.Y2 - clip.Y1);
+        count = 0;
+        start = GUI_TEST_Now();
+        do {
+            GUI_DRAW_Image(&clip, 0, 0, img);
+            count++;
+        } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+        printf(" %8.1f", (double)pixels * count * 1e3 / time);
+        if (c == 0) {                       /* Image data read from flash */
+            printf(" %8.1f", (double)size * count * 1e3 / time);
+        }
+    }
+    printf("\n");
+}
+
+int main(void) {
+    GUI_IMAGE_DESC_t img;
+    uint32_t len;
+    
+    GUI_TEST_Init();
+    Generate();
+    
+    printf("Full screen image, Mpixels/s and MB/s of image data for complete image, Mpixels/s for bottom right quarter:\n");
+    memset((void *)&img, 0x00, sizeof(img));
+    img.xSize = WIDTH;
+    img.ySize = HEIGHT;
+    img.Palette = palette;
+    
+    img.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    img.Data = (const GUI_Byte *)argb;
+    Bench("ARGB8888", &img, sizeof(argb));
+    
+    img.Format = GUI_IMAGE_FORMAT_RGB565;
+    img.Data = (const GUI_Byte *)rgb565;
+    Bench("RGB565", &img, sizeof(rgb565));
+    
+    img.Format = GUI_IMAGE_FORMAT_PAL8;
+    img.Data = indexes;
+    Bench("PAL8", &img, sizeof(indexes) + sizeof(palette));
+    
+    len = EncodeRLE(indexes, WIDTH * HEIGHT, rle);
+    img.Format = GUI_IMAGE_FORMAT_RLE8;
+    img.Data = rle;
+    Bench("RLE8", &img, len + sizeof(palette));
+    return 0;
+}
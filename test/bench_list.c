@@ -0,0 +1,123 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_window.h"
+#include "gui_list.h"
+
+/*
+ * Cost of list frames must not depend on number of rows.
+ * Full screen list is scrolled and appended near start and end of data,
+ * time and drawn pixels are averaged over frames.
+ */
+#define ROW_HEIGHT                  24
+#define FRAMES                      200
+#define SCROLL_STEP                 7       /* Pixels per frame, rows are partially moved */
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+static uint32_t rows;
+
+static uint32_t GetCount(GUI_HANDLE_t h) {
+    return rows;
+}
+
+static const char* GetText(GUI_HANDLE_t h, uint32_t row, uint8_t column) {
+    static char text[16];
+    
+    sprintf(text, column ? "%08X" : "%u", (unsigned)(column ? row * 2654435761UL : row));
+    return text;
+}
+
+static const GUI_LIST_PROVIDER_t provider = {GetCount, GetText, NULL};
+
+static void Print(const char* name, uint32_t count, uint64_t time) {
+    GUI_TEST_Pixels_t pixels;
+    
+    GUI_TEST_GetPixels(&pixels);
+    printf("%-20s %8u rows %8.1f us/frame %8u pixels/frame\n", name, (unsigned)count,
+        time / 1e3 / FRAMES, (unsigned)((pixels.Drawn + pixels.Copied) / FRAMES));
+}
+
+/* Scroll down from row in steps smaller than row height */
+static void BenchScroll(GUI_HANDLE_t h, uint32_t count, uint32_t row, const char* name) {
+    GUI_TEST_Pixels_t pixels;
+    uint64_t start;
+    uint32_t i;
+    
+    rows = count;
+    GUI_LIST_Update(h);
+    GUI_SCROLL_SetOffset(h, (int32_t)row * ROW_HEIGHT);
+    GUI_TEST_Frame(10);
+    GUI_TEST_GetPixels(&pixels);
+    
+    start = GUI_TEST_Now();
+    for (i = 1; i <= FRAMES; i++) {
+        GUI_SCROLL_SetOffset(h, (int32_t)row * ROW_HEIGHT + i * SCROLL_STEP);
+        GUI_TEST_Frame(10);
+    }
+    Print(name, count, GUI_TEST_Now() - start);
+}
+
+/* Add one row per frame, list follows end of data */
+static void BenchAppend(GUI_HANDLE_t h, uint32_t count) {
+    GUI_TEST_Pixels_t pixels;
+    uint64_t start;
+    uint32_t i;
+    
+    rows = count;
+    GUI_LIST_Update(h);
+    GUI_SCROLL_SetOffset(h, 0x7FFFFFFF);    /* Show last row */
+    GUI_TEST_Frame(10);
+    GUI_TEST_GetPixels(&pixels);
+    
+    start = GUI_TEST_Now();
+    for (i = 0; i < FRAMES; i++) {
+        rows++;
+        GUI_LIST_Update(h);
+        GUI_TEST_Frame(10);
+    }
+    Print("append", count, GUI_TEST_Now() - start);
+}
+
+int main(void) {
+    static const GUI_Dim_t columns[] = {160, 320};
+    static const uint32_t counts[] = {1000, 1000000};
+    GUI_HANDLE_t h;
+    uint8_t i;
+    
+    GUI_TEST_Init();
+    GUI_WINDOW_Create(0);
+    h = GUI_LIST_Create(1, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT, ROW_HEIGHT, &provider);
+    GUI_LIST_SetColumns(h, columns, 2);
+    GUI_LIST_SetFont(h, &GUI_Font_Arial_Bold_18);
+    
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        BenchScroll(h, counts[i], 0, "scroll at start");
+        BenchScroll(h, counts[i], counts[i] - 100, "scroll at end");
+        BenchAppend(h, counts[i]);
+    }
+    return 0;
+}
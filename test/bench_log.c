@@ -0,0 +1,121 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_log.h"
+
+/*
+ * Cost of single log call on GUI thread.
+ * Output only counts bytes, so time is spent in formatting and ring buffer only.
+ * Buffer is drained every few calls like GUI_Process would do it once per frame.
+ */
+#define CALLS                       200000
+#define PROCESS_EVERY               8       /* Calls between two buffer drains */
+
+/* Output which accepts everything immediately */
+static uint32_t NullSend(const void* data, uint32_t count) {
+    return count;
+}
+
+static void Print(const char* name, uint64_t time) {
+    GUI_LOG_Stats_t stats;
+    
+    GUI_LOG_GetStats(&stats, 1);
+    printf("%-20s %8.1f ns/call %8u written %8u dropped %8u bytes\n", name, (double)time / CALLS,
+        (unsigned)stats.Written, (unsigned)stats.Dropped, (unsigned)stats.Sent);
+}
+
+/* Message level is above runtime level */
+static void BenchDisabled(void) {
+    uint64_t start;
+    uint32_t i;
+    
+    GUI_LOG_SetLevel(GUI_LOG_LEVEL_ERROR);
+    start = GUI_TEST_Now();
+    for (i = 0; i < CALLS; i++) {
+        GUI_LOG_DEBUG("frame %u\r\n", (unsigned)i);
+    }
+    Print("disabled", GUI_TEST_Now() - start);
+}
+
+/* Formatted messages, buffer is drained regularly */
+static void BenchPrintf(void) {
+    uint64_t start;
+    uint32_t i;
+    
+    GUI_LOG_SetLevel(GUI_LOG_LEVEL_DEBUG);
+    start = GUI_TEST_Now();
+    for (i = 0; i < CALLS; i++) {
+        GUI_LOG_INFO("frame %u drawn in %u us\r\n", (unsigned)i, (unsigned)(i * 7 % 20000));
+        if (i % PROCESS_EVERY == 0) {
+            GUI_LOG_Process();
+        }
+    }
+    GUI_LOG_Flush();
+    Print("printf", GUI_TEST_Now() - start);
+}
+
+/* Raw data without formatting */
+static void BenchWrite(void) {
+    static const char data[] = "0123456789ABCDEF0123456789ABCDE\n";
+    uint64_t start;
+    uint32_t i;
+    
+    start = GUI_TEST_Now();
+    for (i = 0; i < CALLS; i++) {
+        GUI_LOG_Write(GUI_LOG_LEVEL_INFO, data, sizeof(data) - 1);
+        if (i % PROCESS_EVERY == 0) {
+            GUI_LOG_Process();
+        }
+    }
+    GUI_LOG_Flush();
+    Print("write", GUI_TEST_Now() - start);
+}
+
+/* Buffer is not drained, it stays full and messages are dropped */
+static void BenchFull(void) {
+    uint64_t start;
+    uint32_t i;
+    
+    start = GUI_TEST_Now();
+    for (i = 0; i < CALLS; i++) {
+        GUI_LOG_INFO("frame %u drawn in %u us\r\n", (unsigned)i, (unsigned)(i * 7 % 20000));
+    }
+    GUI_LOG_Flush();
+    Print("full buffer", GUI_TEST_Now() - start);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    GUI_LOG_SetOutput(NullSend, NULL);
+    GUI_LOG_Flush();
+    GUI_LOG_GetStats(NULL, 1);
+    
+    BenchDisabled();
+    BenchPrintf();
+    BenchWrite();
+    BenchFull();
+    return 0;
+}
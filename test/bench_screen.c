@@ -0,0 +1,224 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_screen.h"
+#include "gui_window.h"
+#include "gui_button.h"
+#include "gui_led.h"
+#include "gui_progbar.h"
+
+/*
+ * Switch of screen with 300 widgets, loaded from description against created with API calls.
+ *
+ * Screen window holds panels with buttons, LEDs and progress bars, every widget has one color set
+ * and buttons have text and font. Both paths build the same tree. Switch removes old screen
+ * and creates new one, time is given without drawing and together with drawing of new screen.
+ */
+#define WIDGETS                     300
+#define PANELS                      12      /* Grid of 4 x 3 panels */
+#define PANEL_W                     (GUI_TEST_WIDTH / 4)
+#define PANEL_H                     (GUI_TEST_HEIGHT / 3)
+#define BENCH_TIME                  200000000ULL    /* Time for each case in units of nanoseconds */
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+static GUI_Const GUI_FONT_t* const fonts[] = {&GUI_Font_Arial_Bold_18};
+static const char text[] = "OK";
+
+static uint8_t desc[16 + WIDGETS * (18 + 5) + sizeof(text)];
+static uint32_t descLen;
+static GUI_HANDLE_t root;
+
+typedef struct {
+    uint8_t Type;
+    uint16_t Parent;
+    GUI_iDim_t X, Y;
+    GUI_Dim_t Width, Height;
+    GUI_Color_t Color;
+} Widget_t;
+
+static Widget_t tree[WIDGETS];
+
+static uint8_t* Put16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+/* Describe screen window, panels and small widgets placed in panels one after another */
+static void MakeTree(void) {
+    uint32_t i, k, n[PANELS] = {0};
+    
+    tree[0].Type = GUI_SCREEN_TYPE_WINDOW;
+    tree[0].Parent = 0xFFFF;
+    tree[0].Width = GUI_TEST_WIDTH;
+    tree[0].Height = GUI_TEST_HEIGHT;
+    tree[0].Color = GUI_COLOR_DARKGRAY;
+    for (i = 1; i <= PANELS; i++) {
+        tree[i].Type = GUI_SCREEN_TYPE_WINDOW;
+        tree[i].X = ((i - 1) % 4) * PANEL_W + 2;
+        tree[i].Y = ((i - 1) / 4) * PANEL_H + 2;
+        tree[i].Width = PANEL_W - 4;
+        tree[i].Height = PANEL_H - 4;
+        tree[i].Color = GUI_COLOR_LIGHTGRAY;
+    }
+    for (i = PANELS + 1; i < WIDGETS; i++) {
+        tree[i].Parent = 1 + i % PANELS;
+        k = n[i % PANELS]++;
+        tree[i].Type = GUI_SCREEN_TYPE_BUTTON + i % 3;
+        tree[i].X = (k % 6) * 19 + 2;
+        tree[i].Y = (k / 6) * 21 + 2;
+        tree[i].Width = 17;
+        tree[i].Height = 19;
+        tree[i].Color = GUI_COLOR_BLUE;
+    }
+}
+
+/* Write binary description of tree, see gui_screen.h */
+static void MakeDescription(void) {
+    uint16_t types[GUI_SCREEN_TYPE_COUNT] = {0};
+    uint8_t* p = desc;
+    uint32_t i;
+    
+    for (i = 0; i < WIDGETS; i++) {
+        types[tree[i].Type]++;
+    }
+    *p++ = 'G'; *p++ = 'S'; *p++ = 'C'; *p++ = GUI_SCREEN_VERSION;
+    p = Put16(p, WIDGETS);
+    p = Put16(p, sizeof(text));
+    for (i = 0; i < GUI_SCREEN_TYPE_COUNT; i++) {
+        p = Put16(p, types[i]);
+    }
+    for (i = 0; i < WIDGETS; i++) {
+        *p++ = tree[i].Type;
+        *p++ = tree[i].Type == GUI_SCREEN_TYPE_BUTTON ? 0 : 0xFF;
+        p = Put16(p, tree[i].Parent);
+        p = Put16(p, i);
+        p = Put16(p, tree[i].X);
+        p = Put16(p, tree[i].Y);
+        p = Put16(p, tree[i].Width);
+        p = Put16(p, tree[i].Height);
+        p = Put16(p, tree[i].Type == GUI_SCREEN_TYPE_BUTTON ? 0 : 0xFFFF);
+        *p++ = 1;                           /* One color */
+        *p++ = 0;
+        *p++ = tree[i].Type == GUI_SCREEN_TYPE_BUTTON ? GUI_BUTTON_COLOR_BG :
+            (tree[i].Type == GUI_SCREEN_TYPE_PROGBAR ? GUI_PROGBAR_COLOR_FG : 0);
+        p = Put16(p, tree[i].Color & 0xFFFF);
+        p = Put16(p, tree[i].Color >> 16);
+    }
+    memcpy(p, text, sizeof(text));
+    descLen = p + sizeof(text) - desc;
+}
+
+/* Create the same tree with API calls */
+static GUI_HANDLE_t Create(void) {
+    static GUI_HANDLE_t h[WIDGETS];
+    uint32_t i;
+    
+    for (i = 0; i < WIDGETS; i++) {
+        GUI.WindowActive = i ? h[tree[i].Parent] : root;
+        switch (tree[i].Type) {
+            case GUI_SCREEN_TYPE_WINDOW:
+                h[i] = GUI_WINDOW_CreateChild(i, tree[i].X, tree[i].Y, tree[i].Width, tree[i].Height);
+                GUI_WINDOW_SetColor(h[i], GUI_WINDOW_COLOR_BG, tree[i].Color);
+                break;
+            case GUI_SCREEN_TYPE_BUTTON:
+                h[i] = GUI_BUTTON_Create(i, tree[i].X, tree[i].Y, tree[i].Width, tree[i].Height);
+                GUI_BUTTON_SetColor(h[i], GUI_BUTTON_COLOR_BG, tree[i].Color);
+                GUI_BUTTON_SetFont(h[i], fonts[0]);
+                GUI_BUTTON_SetText(h[i], text);
+                break;
+            case GUI_SCREEN_TYPE_LED:
+                h[i] = GUI_LED_Create(i, tree[i].X, tree[i].Y, tree[i].Width, tree[i].Height);
+                GUI_LED_SetColor(h[i], GUI_LED_COLOR_ON, tree[i].Color);
+                break;
+            default:
+                h[i] = GUI_PROGBAR_Create(i, tree[i].X, tree[i].Y, tree[i].Width, tree[i].Height);
+                GUI_PROGBAR_SetColor(h[i], GUI_PROGBAR_COLOR_FG, tree[i].Color);
+                break;
+        }
+    }
+    GUI.WindowActive = root;
+    return h[0];
+}
+
+static void BenchLoader(uint8_t draw) {
+    GUI_SCREEN_t* screen;
+    uint64_t start, time;
+    uint32_t count = 0;
+    
+    screen = GUI_SCREEN_Load(desc, descLen, fonts, 1);
+    GUI_TEST_Frame(10);
+    start = GUI_TEST_Now();
+    do {
+        GUI_SCREEN_Unload(&screen);
+        screen = GUI_SCREEN_Load(desc, descLen, fonts, 1);
+        if (draw) {
+            GUI_TEST_Frame(10);
+        }
+        count++;
+    } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+    printf("%-12s %-14s %8.1f us/switch %4u widgets\n", "loader", draw ? "with drawing" : "without drawing",
+        (double)time / count / 1e3, (unsigned)screen->Count);
+    GUI_SCREEN_Unload(&screen);
+    GUI_TEST_Frame(10);
+}
+
+static void BenchCreate(uint8_t draw) {
+    GUI_HANDLE_t win;
+    uint64_t start, time;
+    uint32_t count = 0;
+    
+    win = Create();
+    GUI_TEST_Frame(10);
+    start = GUI_TEST_Now();
+    do {
+        __GUI_WIDGET_Remove(&win);
+        win = Create();
+        if (draw) {
+            GUI_TEST_Frame(10);
+        }
+        count++;
+    } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+    printf("%-12s %-14s %8.1f us/switch %4u widgets\n", "API calls", draw ? "with drawing" : "without drawing",
+        (double)time / count / 1e3, (unsigned)WIDGETS);
+    __GUI_WIDGET_Remove(&win);
+    GUI_TEST_Frame(10);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    root = GUI.WindowActive;
+    MakeTree();
+    MakeDescription();
+    printf("Screen description %u bytes\n", (unsigned)descLen);
+    
+    BenchLoader(0);
+    BenchCreate(0);
+    BenchLoader(1);
+    BenchCreate(1);
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_window.h"
+#include "gui_button.h"
+
+/*
+ * Traversal of widget tree with 10000 widgets.
+ *
+ * Widget state was checked by walking linked lists of children and reading flags from every handle.
+ * This walk is compared with scan of store bitset, which is done for the same question
+ * "how many widgets wait for redraw". Frames show complete cost when nothing
+ * or single widget changed, clean parts of tree are skipped by subtree state.
+ * Frame with changed widget includes copy of shown layer to drawing layer.
+ */
+#define WINDOWS                     100
+#define BUTTONS                     99      /* Per window, together with windows 10000 widgets */
+#define BENCH_TIME                  200000000ULL    /* Time for each case in units of nanoseconds */
+
+static GUI_HANDLE_t buttons[WINDOWS * BUTTONS];
+static uint32_t seed = 1;
+
+static uint32_t Random(uint32_t max) {
+    seed = seed * 1103515245UL + 12345;
+    return (seed >> 16) % max;
+}
+
+/* Count widgets waiting for redraw by walking children lists through handles */
+static uint32_t WalkList(GUI_HANDLE_t parent) {
+    GUI_HANDLE_t h;
+    uint32_t n = 0;
+    
+    for (h = __GUI_LINKEDLIST_GetNextWidget(__GHR(parent), NULL); h; h = __GUI_LINKEDLIST_GetNextWidget(NULL, h)) {
+        n += (h->Flags & GUI_FLAG_REDRAW) != 0;
+        if (h->Widget->MetaData.AllowChildren) {
+            n += WalkList(h);
+        }
+    }
+    return n;
+}
+
+/* Count widgets waiting for redraw with word-wise bitset scan */
+static uint32_t ScanStore(void) {
+    uint32_t i, n = 0;
+    
+    for (i = 0; i < (GUI_Store.Used + 31) / 32u; i++) {
+        if (GUI_Store.Dirty[i]) {
+            n += __builtin_popcount(GUI_Store.Dirty[i]);
+        }
+    }
+    return n;
+}
+
+static void Print(const char* name, uint32_t count, uint64_t time) {
+    printf("%-24s %10.1f ns\n", name, (double)time / count);
+}
+
+int main(void) {
+    GUI_HANDLE_t root, win;
+    volatile uint32_t sink = 0;
+    uint32_t i, j, count;
+    uint64_t start, time;
+    
+    GUI_TEST_Init();
+    root = GUI.WindowActive;
+    for (i = 0; i < WINDOWS; i++) {         /* Grid of windows covering screen */
+        GUI.WindowActive = root;
+        win = GUI_WINDOW_CreateChild(i, (i % 10) * (GUI_TEST_WIDTH / 10), (i / 10) * (GUI_TEST_HEIGHT / 10), GUI_TEST_WIDTH / 10, GUI_TEST_HEIGHT / 10);
+        for (j = 0; j < BUTTONS; j++) {
+            GUI.WindowActive = win;
+            buttons[i * BUTTONS + j] = GUI_BUTTON_Create(j, (j % 11) * 4, (j / 11) * 3, 4, 3);
+        }
+    }
+    GUI_TEST_Frame(10);
+    printf("%u widgets in store\n", (unsigned)GUI_Store.Used);
+    
+    count = 0;
+    start = GUI_TEST_Now();
+    do {
+        sink += WalkList(root);
+        count++;
+    } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+    Print("linked list walk", count, time);
+    
+    count = 0;
+    start = GUI_TEST_Now();
+    do {
+        sink += ScanStore();
+        count++;
+    } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+    Print("store bitset scan", count, time);
+    
+    count = 0;
+    start = GUI_TEST_Now();
+    do {
+        GUI_TEST_Frame(10);
+        count++;
+    } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+    Print("frame, nothing changed", count, time);
+    
+    count = 0;
+    start = GUI_TEST_Now();
+    do {
+        __GUI_WIDGET_Invalidate(buttons[Random(WINDOWS * BUTTONS)]);
+        GUI_TEST_Frame(10);
+        count++;
+    } while ((time = GUI_TEST_Now() - start) < BENCH_TIME);
+    Print("frame, one button", count, time);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_input.h"
+#include "gui_gesture.h"
+
+/*
+ * Replay of recorded touch trace through input queue, widgets and gesture recognizer.
+ *
+ * Time runs in steps of 1 millisecond, samples are added to queue at their trace time
+ * and GUI is processed once per frame period. Frame drawn in one period is shown at start of next one.
+ * Latency is time from touch sample to display of frame with widget updated for that sample.
+ */
+#define TRACE_SIZE                  1024
+#define TRACE_FILE                  "data/touch_trace.txt"
+#define PROBE_SIZE                  16
+
+typedef struct {
+    uint32_t Time;
+    GUI_TouchData_t Touch;
+} Sample_t;
+
+static Sample_t trace[TRACE_SIZE];
+static uint32_t traceCount;
+
+static struct {
+    uint32_t Time;                          /* Time of last sample given to probe widget */
+    uint8_t New;                            /* Probe got sample in current frame */
+    GUI_Dim_t X, Y;                         /* Position of last sample */
+} probe;
+
+static uint8_t verbose;
+static uint32_t base;                       /* GUI time of trace start */
+
+/* Probe widget covers screen and draws square on last touch position */
+static void ProbeDraw(GUI_Display_t* disp, void* ptr) {
+    GUI_DRAW_FilledRectangle(disp, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT, GUI_COLOR_BLACK);
+    GUI_DRAW_FilledRectangle(disp, probe.X - PROBE_SIZE / 2, probe.Y - PROBE_SIZE / 2, PROBE_SIZE, PROBE_SIZE, GUI_COLOR_WHITE);
+}
+
+static void ProbeSample(void* ptr, GUI_TouchData_t* ts) {
+    probe.Time = ts->Time;
+    probe.New = 1;
+    probe.X = ts->X[0];
+    probe.Y = ts->Y[0];
+    __GUI_WIDGET_Invalidate(ptr);
+}
+
+static __GUI_TouchStatus_t ProbeTouchDown(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    ProbeSample(ptr, ts);
+    return touchHANDLED;
+}
+
+static __GUI_TouchStatus_t ProbeTouchMove(void* ptr, GUI_TouchData_t* ts, __GUI_TouchStatus_t status) {
+    ProbeSample(ptr, ts);
+    return touchHANDLED;
+}
+
+static const GUI_WIDGET_t Probe = {
+    {
+        "Probe",                                    /*!< Widget name */
+        sizeof(GUI_HANDLE),                         /*!< Size of widget for memory allocation */
+        0,                                          /*!< Allow children objects on widget */
+    },
+    ProbeDraw,                                      /*!< Widget draw function */
+    {
+        ProbeTouchDown,                             /*!< Touch down callback function */
+        0,                                          /*!< Touch up callback function */
+        ProbeTouchMove                              /*!< Touch move callback function */
+    }
+};
+
+static void Gesture(const GUI_GESTURE_t* g) {
+    static const char* names[] = {"tap", "long press", "swipe", "pinch", "fling"};
+    
+    if (verbose) {
+        printf("  %5u ms %-10s at %3d,%3d move %4d,%4d velocity %5d,%5d scale %3u, after %u ms\n",
+            (unsigned)(g->Time - base), names[g->Type], g->X, g->Y, g->DX, g->DY,
+            (int)g->VelocityX, (int)g->VelocityY, (unsigned)g->Scale, (unsigned)(GUI.Time - g->Time));
+    }
+}
+
+/* Read trace lines "time status x0 y0 [x1 y1]", lines starting with # are comments */
+static uint8_t Load(const char* file) {
+    char line[128];
+    unsigned t, s;
+    int x[2], y[2], n;
+    FILE* f;
+    
+    if ((f = fopen(file, "r")) == NULL) {
+        printf("Can not open %s\n", file);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) && traceCount < TRACE_SIZE) {
+        n = sscanf(line, "%u %u %d %d %d %d", &t, &s, &x[0], &y[0], &x[1], &y[1]);
+        if (line[0] == '#' || n < 4) {
+            continue;
+        }
+        memset((void *)&trace[traceCount], 0x00, sizeof(Sample_t));
+        trace[traceCount].Time = t;
+        trace[traceCount].Touch.Status = s ? GUI_TouchState_PRESSED : GUI_TouchState_RELEASED;
+        trace[traceCount].Touch.Count = n >= 6 ? 2 : 1;
+        for (n = 0; n < trace[traceCount].Touch.Count; n++) {
+            trace[traceCount].Touch.X[n] = x[n];
+            trace[traceCount].Touch.Y[n] = y[n];
+        }
+        traceCount++;
+    }
+    fclose(f);
+    return traceCount > 0;
+}
+
+static void Replay(uint32_t period) {
+    GUI_HANDLE_t h;
+    GUI_INPUT_Stats_t stats;
+    uint32_t i = 0, frames = 0, count = 0, sum = 0, max = 0, latency, end;
+    
+    base = GUI.Time;
+    h = __GUI_WIDGET_Create(&Probe, 1, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT);   /* Probe on window created by GUI */
+    GUI_GESTURE_SetCallback(Gesture);
+    memset((void *)&probe, 0x00, sizeof(probe));
+    
+    GUI_INPUT_GetStats(&stats, 1);
+    end = base + trace[traceCount - 1].Time + 2 * period;
+    while (GUI.Time <= end) {
+        while (i < traceCount && base + trace[i].Time <= GUI.Time) {   /* Touch controller delivers samples */
+            GUI_INPUT_AddTouch(&trace[i++].Touch);
+        }
+        if (!((GUI.Time - base) % period)) {         /* Start of frame */
+            GUI_TEST_Frame(0);
+            frames++;
+            if (probe.New) {                /* Frame is visible at start of next period */
+                probe.New = 0;
+                latency = GUI.Time + period - probe.Time;
+                sum += latency;
+                max = latency > max ? latency : max;
+                count++;
+            }
+        }
+        GUI_UpdateTime(1);
+    }
+    GUI_INPUT_GetStats(&stats, 1);
+    printf("%2u ms frames: latency %5.1f ms average %3u ms max, %3u of %3u frames with touch,"
+        " samples %u merged %u moves %u dropped %u, queue latency max %u ms\n",
+        (unsigned)period, count ? (double)sum / count : 0.0, (unsigned)max, (unsigned)count, (unsigned)frames,
+        (unsigned)stats.Added, (unsigned)stats.Merged, (unsigned)stats.Moves, (unsigned)stats.Dropped, (unsigned)stats.MaxLatency);
+    __GUI_WIDGET_Remove(&h);
+    GUI_TEST_Frame(1);
+}
+
+int main(int argc, char** argv) {
+    static const uint32_t periods[] = {10, 16, 33, 50};
+    uint8_t k;
+    
+    if (!Load(argc > 1 ? argv[1] : TRACE_FILE)) {
+        return 1;
+    }
+    GUI_TEST_Init();
+    printf("Gestures in %u samples with 16 ms frames:\n", (unsigned)traceCount);
+    verbose = 1;
+    Replay(16);
+    verbose = 0;
+    for (k = 0; k < sizeof(periods) / sizeof(periods[0]); k++) {
+        Replay(periods[k]);
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+/**
+ * GUI configuration for host tests, same as target configuration in 01-DEV_RTOS/User/gui_config.h
+ */
+#ifndef GUI_CONF_H
+#define GUI_CONF_H
+
+#define GUI_USE_WIDGET_BUTTON				1
+
+/* Bytes of memory after frame buffers used for cached widget surfaces */
+#define GUI_SURFACE_ARENA_SIZE				((uint32_t)0x00200000)
+
+/* Collect frame statistics, see gui_prof.h */
+#define GUI_PROF_ENABLED					0
+
+/* Record timeline in Chrome trace format, see gui_trace.h */
+#define GUI_TRACE_ENABLED					0
+
+/* Maximal number of widgets existing at the same time, see gui_store.h */
+/* Larger than on target, store benchmark creates 10000 widgets */
+#define GUI_STORE_SIZE						16384
+
+#endif
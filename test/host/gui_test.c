@@ -0,0 +1,227 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_ll_sw.h"
+#include "gui_surface.h"
+#include "gui_log.h"
+#include <sys/mman.h>
+#include <time.h>
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __TEST_LAYERS               2
+#define __TEST_LAYER_SIZE           ((uint32_t)GUI_TEST_WIDTH * GUI_TEST_HEIGHT * 4)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_Layer_t Layers[__TEST_LAYERS];
+static GUI_LL_t SW;                         /* CPU routines for frame buffers */
+static uint8_t* Memory;                     /* Frame buffers and surface arena */
+static GUI_TEST_Pixels_t Pixels;
+static uint32_t Checks, Failed;
+static uint32_t LogPending;                 /* Bytes of last log block not yet written to stdout */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+static void __Init(GUI_LCD_t* LCD) {
+
+}
+
+/* Count written pixels and forward call to CPU routines */
+static void __SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    Pixels.Drawn++;
+    SW.SetPixel(LCD, layer, x, y, color);
+}
+
+static void __Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLine, GUI_Color_t color) {
+    Pixels.Drawn += (uint32_t)xSize * ySize;
+    SW.Fill(LCD, layer, dst, xSize, ySize, offLine, color);
+}
+
+static void __Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    Pixels.Copied += (uint32_t)xSize * ySize;
+    SW.Copy(LCD, layer, src, dst, xSize, ySize, offLineSrc, offLineDst);
+}
+
+static void __DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    Pixels.Drawn += length;
+    SW.DrawHLine(LCD, layer, x, y, length, color);
+}
+
+static void __DrawVLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    Pixels.Drawn += length;
+    SW.DrawVLine(LCD, layer, x, y, length, color);
+}
+
+static void __FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    Pixels.Drawn += (uint32_t)xSize * ySize;
+    SW.FillRect(LCD, layer, x, y, xSize, ySize, color);
+}
+
+static void __BlendHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, const GUI_Byte* alpha, GUI_Color_t color) {
+    Pixels.Drawn += length;
+    SW.BlendHLine(LCD, layer, x, y, length, alpha, color);
+}
+
+static void __FillBlend(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    Pixels.Drawn += (uint32_t)xSize * ySize;
+    SW.FillBlend(LCD, layer, x, y, xSize, ySize, color);
+}
+
+static void __CopyBlend(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst, GUI_Byte alpha) {
+    Pixels.Copied += (uint32_t)xSize * ySize;
+    SW.CopyBlend(LCD, layer, src, dst, xSize, ySize, offLineSrc, offLineDst, alpha);
+}
+
+/* Start sending log block, it is written to stdout when busy is checked like DMA finishing transfer */
+static uint32_t __LogSend(const void* data, uint32_t count) {
+    if (LogPending) {
+        return 0;                           /* Previous block not done yet */
+    }
+    fwrite(data, 1, count, stdout);
+    LogPending = count;
+    return count;
+}
+
+static uint8_t __LogBusy(void) {
+    if (LogPending) {                       /* Transfer finishes on first check */
+        LogPending = 0;
+        return 1;
+    }
+    return 0;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint8_t GUI_LL_Init(GUI_LCD_t* LCD, GUI_LL_t* LL) {
+    uint8_t i;
+    
+    LCD->Width = GUI_TEST_WIDTH;
+    LCD->Height = GUI_TEST_HEIGHT;
+    LCD->PixelFormat = GUI_PIXEL_FORMAT_ARGB8888;
+    LCD->LayersCount = __TEST_LAYERS;
+    LCD->Layers = Layers;
+    for (i = 0; i < __TEST_LAYERS; i++) {
+        Layers[i].Num = i;
+        Layers[i].StartAddress = (uint32_t)(uintptr_t)Memory + i * __TEST_LAYER_SIZE;
+    }
+    GUI_SURFACE_SetArena((uint32_t)(uintptr_t)Memory + __TEST_LAYERS * __TEST_LAYER_SIZE, GUI_SURFACE_ARENA_SIZE);
+    
+    GUI_LL_SW_Init(LCD, &SW);               /* Get CPU routines and put counters in front of them */
+    LL->Init = __Init;
+    LL->SetPixel = __SetPixel;
+    LL->GetPixel = SW.GetPixel;
+    LL->Fill = __Fill;
+    LL->Copy = __Copy;
+    LL->DrawHLine = __DrawHLine;
+    LL->DrawVLine = __DrawVLine;
+    LL->FillRect = __FillRect;
+    LL->BlendHLine = __BlendHLine;
+    LL->FillBlend = __FillBlend;
+    LL->CopyBlend = __CopyBlend;
+    return 0;
+}
+
+uint8_t GUI_LL_Control(GUI_LCD_t* LCD, GUI_LL_Command_t cmd, void* data) {
+    switch (cmd) {
+        case GUI_LL_Command_SetActiveLayer: {
+            LCD->Layers[*(GUI_Byte *)data].Pending = 1;
+            break;
+        }
+        default:
+            break;
+    }
+    return 0;
+}
+
+void GUI_TEST_Init(void) {
+    if (!Memory) {
+        Memory = mmap(NULL, __TEST_LAYERS * __TEST_LAYER_SIZE + GUI_SURFACE_ARENA_SIZE, 
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+        if (Memory == MAP_FAILED) {
+            printf("Can not allocate frame buffers\n");
+            exit(1);
+        }
+    }
+    GUI_LOG_SetOutput(__LogSend, __LogBusy);   /* Log is drained to stdout */
+    GUI_LOG_SetLevel(GUI_LOG_LEVEL_WARNING);    /* Frame timing messages would mix with test output */
+    GUI_Init();
+    memset((void *)&Pixels, 0x00, sizeof(Pixels));
+}
+
+int32_t GUI_TEST_Frame(uint32_t millis) {
+    int32_t cnt;
+    
+    GUI_UpdateTime(millis);
+    cnt = GUI_Process();
+    GUI_LCD_ConfirmActiveLayer(GUI.LCD.ActiveLayer);    /* Layer is shown immediately */
+    return cnt;
+}
+
+void* GUI_TEST_Layer(uint8_t layer) {
+    return (void *)(uintptr_t)Layers[layer].StartAddress;
+}
+
+GUI_Color_t GUI_TEST_GetPixel(GUI_Dim_t x, GUI_Dim_t y) {
+    return ((uint32_t *)GUI_TEST_Layer(GUI.LCD.ActiveLayer))[(uint32_t)y * GUI_TEST_WIDTH + x];
+}
+
+void GUI_TEST_GetPixels(GUI_TEST_Pixels_t* pixels) {
+    memcpy((void *)pixels, (void *)&Pixels, sizeof(Pixels));
+    memset((void *)&Pixels, 0x00, sizeof(Pixels));
+}
+
+uint64_t GUI_TEST_Now(void) {
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void GUI_TEST_Check(uint8_t ok, const char* expr, const char* file, int line) {
+    Checks++;
+    if (!ok) {
+        Failed++;
+        printf("%s:%d: check failed: %s\n", file, line, expr);
+    }
+}
+
+int GUI_TEST_Result(void) {
+    printf("%u checks, %u failed\n", (unsigned)Checks, (unsigned)Failed);
+    return Failed ? 1 : 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * \author  Tilen Majerle
+ * \email   tilen@majerle.eu
+ * \brief   Host test support for GUI library
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_TEST_H
+#define GUI_TEST_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup  GUI
+ * \brief       
+ * \{
+ */
+#include "gui.h"
+#include "gui_ll.h"
+#include "stdio.h"
+
+/**
+ * \defgroup      GUI_TEST
+ * \brief         Host test support
+ *
+ * Low-level driver for Linux host with frame buffers in process memory,
+ * frame loop, time measurement and simple checks for test programs.
+ *
+ * Frame buffers are allocated in lower 4 GB of address space,
+ * because layer addresses are stored as 32-bit values like on target.
+ *
+ * Every pixel written by drawing routines is counted, which is used to check overdraw.
+ *
+ * Log output is written to stdout, warnings and errors only unless level is changed.
+ * \{
+ */
+
+/**
+ * \defgroup      GUI_TEST_Macros
+ * \brief         Library defines
+ * \{
+ */
+
+/**
+ * \brief         Host LCD width in units of pixels, same as target LCD
+ */
+#define GUI_TEST_WIDTH              480
+
+/**
+ * \brief         Host LCD height in units of pixels, same as target LCD
+ */
+#define GUI_TEST_HEIGHT             272
+
+/**
+ * \brief         Check condition and report failure with file and line
+ * \param[in]     c: Condition which must be true
+ */
+#define GUI_TEST_ASSERT(c)          GUI_TEST_Check((c) ? 1 : 0, #c, __FILE__, __LINE__)
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_TEST_Typedefs
+ * \brief         Library Typedefs
+ * \{
+ */
+
+/**
+ * \brief         Pixel counters of host low-level driver
+ */
+typedef struct GUI_TEST_Pixels_t {
+    uint32_t Drawn;                         /*!< Pixels written by fill, line, blend and set pixel routines */
+    uint32_t Copied;                        /*!< Pixels written by copy routines */
+} GUI_TEST_Pixels_t;
+
+/**
+ * \}
+ */
+
+/**
+ * \defgroup      GUI_TEST_Functions
+ * \brief         Library Functions
+ * \{
+ */
+
+/**
+ * \brief         Allocate frame buffers, set log output and initialize GUI
+ */
+void GUI_TEST_Init(void);
+
+/**
+ * \brief         Move GUI time and process it, like LCD reload and timer on target
+ * \param[in]     millis: Number of milliseconds since previous frame
+ * \retval        Number of redrawn widgets
+ */
+int32_t GUI_TEST_Frame(uint32_t millis);
+
+/**
+ * \brief         Get pointer to layer memory
+ * \param[in]     layer: Layer number
+ * \retval        Pointer to first pixel of layer
+ */
+void* GUI_TEST_Layer(uint8_t layer);
+
+/**
+ * \brief         Get pixel of currently shown layer in ARGB8888 format
+ * \param[in]     x: X position on LCD
+ * \param[in]     y: Y position on LCD
+ * \retval        Pixel color
+ */
+GUI_Color_t GUI_TEST_GetPixel(GUI_Dim_t x, GUI_Dim_t y);
+
+/**
+ * \brief         Get and clear pixel counters
+ * \param[out]    pixels: Pointer to \ref GUI_TEST_Pixels_t structure to fill
+ */
+void GUI_TEST_GetPixels(GUI_TEST_Pixels_t* pixels);
+
+/**
+ * \brief         Get monotonic time
+ * \retval        Time in units of nanoseconds
+ */
+uint64_t GUI_TEST_Now(void);
+
+/**
+ * \brief         Count check result and print failed check
+ * \note          Use \ref GUI_TEST_ASSERT macro instead
+ */
+void GUI_TEST_Check(uint8_t ok, const char* expr, const char* file, int line);
+
+/**
+ * \brief         Print summary of checks
+ * \retval        Exit code for test program, 0 when all checks passed
+ */
+int GUI_TEST_Result(void);
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
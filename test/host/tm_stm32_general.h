@@ -0,0 +1,12 @@
+/**
+ * Host replacement for STM32 general library, only functions used by GUI library
+ */
+#ifndef TM_GENERAL_H
+#define TM_GENERAL_H
+
+#include "stdint.h"
+
+/* There is no DWT cycle counter on host */
+#define TM_GENERAL_DWTCounterGetValue()     0UL
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * Host replacement for STM32 touch library, only touch structure used by touch reader
+ */
+#ifndef TM_TOUCH_H
+#define TM_TOUCH_H
+
+#include "stdint.h"
+
+typedef struct {
+	uint8_t NumPresses;   /*!< Number of touches (fingers) detected */
+	uint16_t X[10];       /*!< X positions for touches */
+	uint16_t Y[10];       /*!< Y positions for touches */
+	uint8_t Events;       /*!< Events, if any. For example, touch has detected "zoom" with fingers or similar */
+	uint8_t Orientation;  /*!< Touch orientation to match LCD orientation if needed */
+	uint16_t MaxX;        /*!< Touch MAX X value. Maximal value for touch X coordinate */
+	uint16_t MaxY;        /*!< Touch MAX Y value. Maximal value for touch Y coordinate */
+	uint8_t Gesture;      /*!< Gesture value if used by touch controller */
+} TM_TOUCH_t;
+
+#endif
@@ -0,0 +1,194 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_anim.h"
+#include "gui_button.h"
+
+/*
+ * Animations are driven by GUI time, which host test moves by exact number of milliseconds per frame.
+ * Values in the middle and at the end of animation are checked for every easing curve,
+ * together with batched geometry, cancel and completion callbacks.
+ */
+#define DURATION                    100
+#define DISTANCE                    200
+
+static GUI_HANDLE_t root, btn;
+static GUI_ANIM_t* started;                 /* Pointer returned on start */
+static uint32_t calls, finishedCalls, sameHandle;
+static int32_t value;
+
+static void Callback(GUI_ANIM_t* a, uint8_t finished) {
+    calls++;
+    finishedCalls += finished;
+    sameHandle += a == started && a->Widget == btn && a->Param == &value;
+}
+
+/* Start animation back to start from completion callback */
+static void Reverse(GUI_ANIM_t* a, uint8_t finished) {
+    Callback(a, finished);
+    if (finished) {
+        GUI_ANIM_Start(a->Widget, a->Property, 0, DURATION, GUI_ANIM_EASING_LINEAR);
+    }
+}
+
+static GUI_HANDLE_t SetValue(GUI_HANDLE_t h, int32_t v) {
+    value = v;
+    return h;
+}
+
+/* Value in the middle of animation may be rounded down */
+static uint8_t Near(int32_t v, int32_t exp) {
+    return v == exp || v == exp - 1;
+}
+
+static void Reset(void) {
+    GUI_ANIM_CancelWidget(btn);
+    __GUI_WIDGET_SetXY(btn, 0, 0);
+    __GUI_WIDGET_SetSize(btn, 20, 20);
+    GUI_TEST_Frame(10);
+    calls = finishedCalls = sameHandle = 0;
+}
+
+static void TestEasing(void) {
+    static const int32_t half[] = {         /* X in the middle of animation by easing */
+        DISTANCE / 2, DISTANCE / 4, DISTANCE * 3 / 4, DISTANCE / 2, DISTANCE / 8, DISTANCE * 7 / 8, DISTANCE / 2
+    };
+    uint32_t e, wrong = 0;
+    
+    for (e = GUI_ANIM_EASING_LINEAR; e <= GUI_ANIM_EASING_IN_OUT_CUBIC; e++) {
+        Reset();
+        started = GUI_ANIM_Start(btn, GUI_ANIM_PROP_X, DISTANCE, DURATION, (GUI_ANIM_EASING_t)e);
+        GUI_ANIM_SetCallback(started, Callback, &value);
+        GUI_TEST_Frame(0);
+        wrong += btn->X != 0;               /* Start value */
+        GUI_TEST_Frame(DURATION / 2);
+        wrong += btn->X != half[e];
+        GUI_TEST_Frame(DURATION / 2 - 1);
+        wrong += calls != 0;                /* Not finished yet */
+        GUI_TEST_Frame(1);
+        wrong += btn->X != DISTANCE || finishedCalls != 1;  /* Exact end value */
+        if (wrong) {
+            printf("Easing %u wrong\n", (unsigned)e);
+            break;
+        }
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+static void TestGeometry(void) {
+    int32_t redrawn, step;
+    
+    Reset();                                /* Single property */
+    GUI_ANIM_Start(btn, GUI_ANIM_PROP_X, DISTANCE, DURATION, GUI_ANIM_EASING_LINEAR);
+    redrawn = GUI_TEST_Frame(10);
+    
+    Reset();                                /* Position and size together */
+    GUI_ANIM_Start(btn, GUI_ANIM_PROP_X, DISTANCE, DURATION, GUI_ANIM_EASING_LINEAR);
+    GUI_ANIM_Start(btn, GUI_ANIM_PROP_Y, DISTANCE / 2, DURATION, GUI_ANIM_EASING_LINEAR);
+    GUI_ANIM_Start(btn, GUI_ANIM_PROP_WIDTH, 20 + DISTANCE / 2, DURATION, GUI_ANIM_EASING_LINEAR);
+    GUI_ANIM_Start(btn, GUI_ANIM_PROP_HEIGHT, 20 + DISTANCE / 4, DURATION, GUI_ANIM_EASING_LINEAR);
+    for (step = 1; step <= 10; step++) {    /* All properties change in the same frame with single redraw */
+        if (GUI_TEST_Frame(10) != redrawn || !Near(btn->X, step * DISTANCE / 10) || !Near(btn->Y, step * DISTANCE / 20) ||
+            !Near(btn->Width, 20 + step * DISTANCE / 20) || !Near(btn->Height, 20 + step * DISTANCE / 40)) {
+            break;
+        }
+    }
+    GUI_TEST_ASSERT(step == 11);
+}
+
+static void TestCancel(void) {
+    GUI_TEST_Pixels_t pixels;
+    GUI_iDim_t x;
+    
+    Reset();
+    started = GUI_ANIM_Start(btn, GUI_ANIM_PROP_X, DISTANCE, DURATION, GUI_ANIM_EASING_LINEAR);
+    GUI_ANIM_SetCallback(started, Callback, &value);
+    GUI_TEST_Frame(30);
+    x = btn->X;
+    GUI_TEST_ASSERT(GUI_ANIM_Cancel(started));
+    GUI_TEST_ASSERT(calls == 1 && finishedCalls == 0 && sameHandle == 1);
+    
+    GUI_TEST_GetPixels(&pixels);            /* Widget stays where it was */
+    GUI_TEST_Frame(DURATION);
+    GUI_TEST_GetPixels(&pixels);
+    GUI_TEST_ASSERT(btn->X == x && x > 0 && pixels.Drawn == 0);
+    
+    /* Animation is cancelled when its widget is removed */
+    GUI_ANIM_SetCallback(started = GUI_ANIM_Start(btn, GUI_ANIM_PROP_Y, DISTANCE / 2, DURATION, GUI_ANIM_EASING_LINEAR), Callback, &value);
+    GUI_TEST_Frame(10);
+    __GUI_WIDGET_Remove(&btn);
+    GUI_TEST_ASSERT(calls == 2 && finishedCalls == 0);
+    GUI_TEST_Frame(DURATION);
+    GUI.WindowActive = root;
+    btn = GUI_BUTTON_Create(1, 0, 0, 20, 20);
+}
+
+static void TestComplete(void) {
+    uint8_t i;
+    
+    Reset();
+    started = GUI_ANIM_Start(btn, GUI_ANIM_PROP_Y, DISTANCE / 2, DURATION, GUI_ANIM_EASING_OUT_CUBIC);
+    GUI_ANIM_SetCallback(started, Reverse, &value);
+    for (i = 0; i < 10; i++) {
+        GUI_TEST_Frame(DURATION / 10);
+    }
+    GUI_TEST_ASSERT(calls == 1 && finishedCalls == 1 && sameHandle == 1);
+    GUI_TEST_ASSERT(btn->Y == DISTANCE / 2);
+    
+    started = NULL;                         /* Animation started from callback runs to the end */
+    for (i = 0; i < 10; i++) {
+        GUI_TEST_Frame(DURATION / 10);
+    }
+    GUI_TEST_ASSERT(btn->Y == 0 && calls == 1);
+}
+
+static void TestValue(void) {
+    Reset();
+    GUI_ANIM_StartValue(btn, GUI_ANIM_PROP_COLOR, SetValue, 0x00000000, 0x00FF8040, DURATION, GUI_ANIM_EASING_LINEAR);
+    GUI_TEST_Frame(DURATION / 2);
+    GUI_TEST_ASSERT(value == 0x007F4020);   /* Channels are animated separately */
+    GUI_TEST_Frame(DURATION / 2);
+    GUI_TEST_ASSERT(value == 0x00FF8040);
+    
+    GUI_ANIM_StartValue(btn, GUI_ANIM_PROP_VALUE, SetValue, -100, 100, DURATION, GUI_ANIM_EASING_IN_OUT_QUAD);
+    GUI_TEST_Frame(DURATION / 4);
+    GUI_TEST_ASSERT(value == -75);
+    GUI_TEST_Frame(DURATION);
+    GUI_TEST_ASSERT(value == 100);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    root = GUI.WindowActive;
+    btn = GUI_BUTTON_Create(1, 0, 0, 20, 20);
+    
+    TestEasing();
+    TestGeometry();
+    TestCancel();
+    TestComplete();
+    TestValue();
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,160 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_ll_sw.h"
+#include <string.h>
+
+/*
+ * Blend routines of CPU low-level driver are checked for every pixel format on layer 0 memory.
+ * Same operation is done on copy of layer memory by scalar reference which blends every channel
+ * separately, then whole memory must match. Random positions and lengths from 1 to 100 pixels
+ * cover vector loop bodies, their tails and unaligned start addresses.
+ */
+#define OPERATIONS                  2000
+
+static uint8_t Ref[GUI_TEST_WIDTH * GUI_TEST_HEIGHT * 4];
+static uint32_t Src[GUI_TEST_WIDTH * 8];
+static GUI_Byte Alpha[GUI_TEST_WIDTH];
+
+static uint32_t seed = 1;
+static int32_t Random(int32_t min, int32_t max) {
+    seed = seed * 1103515245UL + 12345;
+    return min + (int32_t)((seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+/* Random byte, full and zero values are more likely */
+static GUI_Byte RandomAlpha(void) {
+    switch (Random(0, 7)) {
+        case 0: return 0x00;
+        case 1: return 0xFF;
+        default: return (GUI_Byte)Random(0, 0xFF);
+    }
+}
+
+static uint32_t Mix(uint32_t d, uint32_t c, uint32_t a, uint32_t max) {
+    return (d * (max - a) + c * a) / max;
+}
+
+/* Blend color over single pixel of reference memory, opacity is from 0 to 256 */
+static void RefBlend(uint8_t format, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color, uint32_t a) {
+    uint32_t i = (uint32_t)y * GUI_TEST_WIDTH + x;
+    uint32_t r = (color >> 16) & 0xFF, g = (color >> 8) & 0xFF, b = color & 0xFF;
+    
+    if (format == GUI_PIXEL_FORMAT_ARGB8888) {
+        uint8_t* p = &Ref[i * 4];           /* Little endian B, G, R, A */
+        p[0] = Mix(p[0], b, a, 256);
+        p[1] = Mix(p[1], g, a, 256);
+        p[2] = Mix(p[2], r, a, 256);
+        p[3] = 0xFF;
+    } else if (format == GUI_PIXEL_FORMAT_RGB565) {
+        uint16_t* p = (uint16_t *)Ref + i;
+        a >>= 3;                            /* 5-bit opacity */
+        *p = Mix(*p >> 11, r >> 3, a, 32) << 11 |
+            Mix((*p >> 5) & 0x3F, g >> 2, a, 32) << 5 |
+            Mix(*p & 0x1F, b >> 3, a, 32);
+    } else {
+        Ref[i] = Mix(Ref[i], (r * 77 + g * 150 + b * 29) >> 8, a, 256);
+    }
+}
+
+static uint32_t TestFormat(uint8_t format) {
+    GUI_Layer_t layer = {0};
+    GUI_LCD_t LCD = {0};
+    GUI_LL_t LL;
+    uint8_t* mem = GUI_TEST_Layer(0);
+    uint32_t size, i, a, wrong = 0;
+    GUI_Dim_t x, y, xSize, ySize, j, k, offLineSrc;
+    GUI_Color_t color;
+    GUI_Byte g;
+    
+    layer.StartAddress = (uint32_t)(uintptr_t)mem;
+    LCD.Width = GUI_TEST_WIDTH;
+    LCD.Height = GUI_TEST_HEIGHT;
+    LCD.LayersCount = 1;
+    LCD.Layers = &layer;
+    LCD.PixelFormat = format;
+    GUI_TEST_ASSERT(GUI_LL_SW_Init(&LCD, &LL) == 0);
+    size = GUI_TEST_WIDTH * GUI_TEST_HEIGHT * LCD.PixelSize;
+    
+    for (i = 0; i < size; i++) {            /* Random start content */
+        mem[i] = Random(0, 0xFF);
+    }
+    memcpy(Ref, mem, size);
+    
+    for (i = 0; i < OPERATIONS; i++) {
+        xSize = Random(1, 100);
+        ySize = Random(1, 4);
+        x = Random(0, GUI_TEST_WIDTH - xSize);
+        y = Random(0, GUI_TEST_HEIGHT - ySize);
+        color = (uint32_t)RandomAlpha() << 24 | Random(0, 0xFFFFFF);
+        switch (i % 3) {
+            case 0:                         /* Anti-aliased span */
+                for (j = 0; j < xSize; j++) {
+                    Alpha[j] = RandomAlpha();
+                    RefBlend(format, x + j, y, color, Alpha[j] + (Alpha[j] >> 7));
+                }
+                LL.BlendHLine(&LCD, 0, x, y, xSize, Alpha, color);
+                break;
+            case 1:                         /* Transparency from color */
+                a = 0xFF - (color >> 24);
+                for (k = 0; k < ySize; k++) {
+                    for (j = 0; j < xSize; j++) {
+                        RefBlend(format, x + j, y + k, color, a + (a >> 7));
+                    }
+                }
+                LL.FillBlend(&LCD, 0, x, y, xSize, ySize, color);
+                break;
+            default:                        /* ARGB8888 source with pixel and global alpha */
+                offLineSrc = Random(0, GUI_TEST_WIDTH - xSize);
+                g = RandomAlpha();
+                for (k = 0; k < ySize; k++) {
+                    for (j = 0; j < xSize; j++) {
+                        color = (uint32_t)RandomAlpha() << 24 | Random(0, 0xFFFFFF);
+                        Src[k * (xSize + offLineSrc) + j] = color;
+                        a = ((color >> 24) * (g + (g >> 7))) >> 8;
+                        RefBlend(format, x + j, y + k, color, a + (a >> 7));
+                    }
+                }
+                LL.CopyBlend(&LCD, 0, Src, mem + ((uint32_t)y * GUI_TEST_WIDTH + x) * LCD.PixelSize,
+                    xSize, ySize, offLineSrc, GUI_TEST_WIDTH - xSize, g);
+                break;
+        }
+        if (memcmp(Ref, mem, size)) {
+            wrong++;
+            memcpy(Ref, mem, size);         /* Count next operations separately */
+        }
+    }
+    return wrong;
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    
+    GUI_TEST_ASSERT(TestFormat(GUI_PIXEL_FORMAT_ARGB8888) == 0);
+    GUI_TEST_ASSERT(TestFormat(GUI_PIXEL_FORMAT_RGB565) == 0);
+    GUI_TEST_ASSERT(TestFormat(GUI_PIXEL_FORMAT_L8) == 0);
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,247 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "buffer.h"
+#include <pthread.h>
+#include <sched.h>
+
+/*
+ * Search in cyclic buffer is compared with brute force search over the same data.
+ *
+ * Single producer single consumer buffer is checked with producer and consumer in separate threads.
+ * Producer writes known byte sequence in random chunks, consumer checks every byte.
+ * Both sides alternate between copy functions and zero-copy regions.
+ */
+#define STRESS_BYTES                (8UL * 1024 * 1024)
+
+typedef struct {
+    BUFFER_SPSC_t* Buffer;
+    uint32_t Seed;
+    uint32_t Errors;                        /* Wrong bytes found by consumer */
+} Stress_t;
+
+static uint32_t Random(uint32_t* seed) {
+    *seed = *seed * 1103515245UL + 12345;
+    return *seed >> 8;
+}
+
+/* Byte at position in stream, period is not power of 2 to catch wrong wrap */
+static uint8_t Expected(uint32_t pos) {
+    return (uint8_t)(pos % 251);
+}
+
+static void* Producer(void* arg) {
+    Stress_t* s = arg;
+    uint8_t chunk[300];
+    uint32_t pos = 0, len, i, n;
+    uint8_t* mem;
+    
+    while (pos < STRESS_BYTES) {
+        len = 1 + Random(&s->Seed) % sizeof(chunk);
+        if (len > STRESS_BYTES - pos) {
+            len = STRESS_BYTES - pos;
+        }
+        if (Random(&s->Seed) & 1) {         /* Copy from local memory */
+            for (i = 0; i < len; i++) {
+                chunk[i] = Expected(pos + i);
+            }
+            pos += BUFFER_SPSC_Write(s->Buffer, chunk, len);
+        } else {                            /* Write directly to reserved region */
+            n = BUFFER_SPSC_Reserve(s->Buffer, (void **)&mem);
+            if (n > len) {
+                n = len;
+            }
+            for (i = 0; i < n; i++) {
+                mem[i] = Expected(pos + i);
+            }
+            BUFFER_SPSC_Commit(s->Buffer, n);
+            pos += n;
+        }
+        if (BUFFER_SPSC_GetFree(s->Buffer) == 0) {
+            sched_yield();                  /* Let consumer run when there is single CPU */
+        }
+    }
+    return NULL;
+}
+
+static void* Consumer(void* arg) {
+    Stress_t* s = arg;
+    uint8_t chunk[300];
+    uint32_t pos = 0, len, i, n;
+    const uint8_t* mem;
+    
+    while (pos < STRESS_BYTES) {
+        len = 1 + Random(&s->Seed) % sizeof(chunk);
+        if (Random(&s->Seed) & 1) {         /* Copy to local memory */
+            n = BUFFER_SPSC_Read(s->Buffer, chunk, len);
+            mem = chunk;
+        } else {                            /* Check data in buffer memory */
+            n = BUFFER_SPSC_Peek(s->Buffer, (const void **)&mem);
+            if (n > len) {
+                n = len;
+            }
+        }
+        for (i = 0; i < n; i++) {
+            if (mem[i] != Expected(pos + i)) {
+                s->Errors++;
+            }
+        }
+        if (mem != chunk) {
+            BUFFER_SPSC_Consume(s->Buffer, n);
+        }
+        pos += n;
+        if (BUFFER_SPSC_GetFull(s->Buffer) == 0) {
+            sched_yield();                  /* Let producer run when there is single CPU */
+        }
+    }
+    return NULL;
+}
+
+static void Stress(uint32_t size) {
+    BUFFER_SPSC_t b;
+    Stress_t p, c;
+    pthread_t tp, tc;
+    
+    GUI_TEST_ASSERT(BUFFER_SPSC_Init(&b, size, NULL) == 0);
+    p.Buffer = c.Buffer = &b;
+    p.Seed = 1;
+    c.Seed = 2;
+    p.Errors = c.Errors = 0;
+    pthread_create(&tp, NULL, Producer, &p);
+    pthread_create(&tc, NULL, Consumer, &c);
+    pthread_join(tp, NULL);
+    pthread_join(tc, NULL);
+    GUI_TEST_ASSERT(c.Errors == 0);
+    GUI_TEST_ASSERT(BUFFER_SPSC_GetFull(&b) == 0);
+    GUI_TEST_ASSERT(b.In == STRESS_BYTES && b.Out == STRESS_BYTES);
+    BUFFER_SPSC_Free(&b);
+}
+
+static void TestSPSC(void) {
+    BUFFER_SPSC_t b;
+    uint8_t data[16], mem[8];
+    const void* peek;
+    void* res;
+    uint32_t i;
+    
+    GUI_TEST_ASSERT(BUFFER_SPSC_Init(&b, 12, mem) == 1);    /* Size must be power of 2 */
+    GUI_TEST_ASSERT(BUFFER_SPSC_Init(&b, 8, mem) == 0);
+    for (i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+    GUI_TEST_ASSERT(BUFFER_SPSC_GetFree(&b) == 8);  /* Whole memory is used */
+    GUI_TEST_ASSERT(BUFFER_SPSC_Write(&b, data, 10) == 8);
+    GUI_TEST_ASSERT(BUFFER_SPSC_GetFree(&b) == 0 && BUFFER_SPSC_Reserve(&b, &res) == 0);
+    GUI_TEST_ASSERT(BUFFER_SPSC_Read(&b, data, 5) == 5 && data[4] == 4);
+    
+    /* Regions end at the end of memory */
+    GUI_TEST_ASSERT(BUFFER_SPSC_Reserve(&b, &res) == 5 && res == mem);
+    GUI_TEST_ASSERT(BUFFER_SPSC_Peek(&b, &peek) == 3 && peek == &mem[5]);
+    BUFFER_SPSC_Consume(&b, 3);
+    GUI_TEST_ASSERT(BUFFER_SPSC_Peek(&b, &peek) == 0);
+    GUI_TEST_ASSERT(BUFFER_SPSC_Reserve(&b, &res) == 8 && res == mem);
+    memset(res, 0xAA, 2);
+    BUFFER_SPSC_Commit(&b, 2);
+    GUI_TEST_ASSERT(BUFFER_SPSC_Peek(&b, &peek) == 2 && peek == mem && mem[1] == 0xAA);
+    
+    /* Indexes overflow 32 bits */
+    b.In = b.Out = 0xFFFFFFFCUL;
+    GUI_TEST_ASSERT(BUFFER_SPSC_Write(&b, data, 8) == 8 && BUFFER_SPSC_GetFull(&b) == 8);
+    GUI_TEST_ASSERT(BUFFER_SPSC_Read(&b, &data[8], 8) == 8 && !memcmp(data, &data[8], 8));
+    GUI_TEST_ASSERT(b.In == 4 && BUFFER_SPSC_GetFree(&b) == 8);
+}
+
+/* Reference search over linear copy of buffer data */
+static int32_t FindBrute(const uint8_t* data, uint32_t len, const uint8_t* seq, uint32_t size) {
+    uint32_t i;
+    
+    for (i = 0; i + size <= len; i++) {
+        if (!memcmp(&data[i], seq, size)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Fill buffer with data starting at position in memory, so data may wrap around memory end */
+static void Fill(BUFFER_t* b, uint32_t start, const uint8_t* data, uint32_t len) {
+    b->In = b->Out = start;
+    BUFFER_Write(b, data, len);
+}
+
+static void TestFind(void) {
+    static uint8_t mem[256], data[255], seq[64];
+    uint32_t seed = 3, i, n, len, size, start, alphabet, wrong = 0;
+    BUFFER_t b;
+    
+    BUFFER_Init(&b, sizeof(mem), mem);
+    
+    /* Search must continue from inside of failed partial match */
+    Fill(&b, 0, (const uint8_t *)"aaab", 4);
+    GUI_TEST_ASSERT(BUFFER_Find(&b, "aab", 3) == 1);
+    Fill(&b, 0, (const uint8_t *)"abababc", 7);
+    GUI_TEST_ASSERT(BUFFER_Find(&b, "ababc", 5) == 2);
+    
+    /* Sequence wraps around memory end */
+    Fill(&b, sizeof(mem) - 2, (const uint8_t *)"xyzw", 4);
+    GUI_TEST_ASSERT(BUFFER_Find(&b, "yz", 2) == 1);
+    GUI_TEST_ASSERT(BUFFER_FindElement(&b, 'w') == 3);
+    GUI_TEST_ASSERT(BUFFER_Find(&b, "zw", 2) == 2 && BUFFER_Find(&b, "wx", 2) < 0);
+    
+    /* Random data with small alphabet has many partial matches */
+    for (i = 0; i < 20000; i++) {
+        alphabet = 2 + Random(&seed) % 3;
+        len = Random(&seed) % (sizeof(data) + 1);
+        size = 1 + Random(&seed) % (i & 1 ? 4 : sizeof(seq));  /* Short and long sequences, long ones are allocated */
+        start = Random(&seed) % sizeof(mem);
+        for (n = 0; n < len; n++) {
+            data[n] = 'a' + Random(&seed) % alphabet;
+        }
+        if (len >= size && (Random(&seed) & 1)) {   /* Take sequence from data to have more matches */
+            memcpy(seq, &data[Random(&seed) % (len - size + 1)], size);
+        } else {
+            for (n = 0; n < size; n++) {
+                seq[n] = 'a' + Random(&seed) % alphabet;
+            }
+        }
+        Fill(&b, start, data, len);
+        if (BUFFER_Find(&b, seq, size) != FindBrute(data, len, seq, size)) {
+            wrong++;
+        }
+        if (BUFFER_FindElement(&b, seq[0]) != FindBrute(data, len, seq, 1)) {
+            wrong++;
+        }
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+int main(void) {
+    TestSPSC();
+    TestFind();
+    Stress(64);                             /* Small buffer, sides wait for each other all the time */
+    Stress(4096);
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,323 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_draw.h"
+#include <math.h>
+#include <string.h>
+
+/*
+ * Polygon fill is compared with reference which checks pixel centers in floating point.
+ * Pixels closer than 1/100 pixel to polygon edge may differ because of fixed point rounding.
+ */
+#define FILL_COLOR                  0x00FF00
+#define BG_COLOR                    0x000000
+
+static GUI_Display_t disp = {0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT};
+
+static uint32_t seed = 1;
+static int32_t Random(int32_t min, int32_t max) {
+    seed = seed * 1103515245UL + 12345;
+    return min + (int32_t)((seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+static GUI_Color_t Pixel(GUI_Dim_t x, GUI_Dim_t y) {
+    return ((uint32_t *)GUI_TEST_Layer(GUI.LCD.DrawingLayer))[(uint32_t)y * GUI_TEST_WIDTH + x] & 0x00FFFFFF;
+}
+
+static void Clear(void) {
+    GUI.LL.FillRect(&GUI.LCD, GUI.LCD.DrawingLayer, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT, BG_COLOR);
+}
+
+/* Compare filled polygon with reference, return number of wrong pixels */
+static uint32_t CheckPoly(const GUI_DRAW_Poly_t* p, uint8_t len, uint8_t rule) {
+    double cross[64];
+    int32_t dir[64], n, i, x, y, wind, k;
+    uint32_t wrong = 0;
+    double yc, xc, t, near;
+    const GUI_DRAW_Poly_t *a, *b;
+    uint8_t inside;
+    
+    Clear();
+    GUI_DRAW_FilledPoly(&disp, p, len, rule, FILL_COLOR);
+    for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+        yc = y + 0.5;
+        n = 0;
+        for (i = 0; i < len; i++) {         /* Crossings of scanline center with edges */
+            a = &p[i];
+            b = &p[(i + 1) % len];
+            if (a->Y == b->Y) {
+                continue;
+            }
+            if (a->Y < b->Y ? (y >= a->Y && y < b->Y) : (y >= b->Y && y < a->Y)) {
+                t = (yc - a->Y) / (double)(b->Y - a->Y);
+                cross[n] = a->X + t * (b->X - a->X);
+                dir[n] = a->Y < b->Y ? 1 : -1;
+                n++;
+            }
+        }
+        for (x = 0; x < GUI_TEST_WIDTH; x++) {
+            xc = x + 0.5;
+            wind = 0;
+            near = 1e9;
+            for (k = 0; k < n; k++) {
+                if (cross[k] < xc) {
+                    wind = rule == GUI_DRAW_POLY_EVENODD ? wind ^ 1 : wind + dir[k];
+                }
+                near = fmin(near, fabs(cross[k] - xc));
+            }
+            inside = wind != 0;
+            if (inside != (Pixel(x, y) == FILL_COLOR) && near > 0.01) {
+                wrong++;
+            }
+        }
+    }
+    return wrong;
+}
+
+static void TestTriangles(void) {
+    GUI_DRAW_Poly_t p[3];
+    uint32_t i, wrong = 0;
+    
+    for (i = 0; i < 200; i++) {             /* Triangles inside and around screen */
+        p[0].X = Random(-100, 580); p[0].Y = Random(-100, 370);
+        p[1].X = Random(-100, 580); p[1].Y = Random(-100, 370);
+        p[2].X = Random(-100, 580); p[2].Y = Random(-100, 370);
+        wrong += CheckPoly(p, 3, GUI_DRAW_POLY_NONZERO);
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+static void TestFarPoints(void) {
+    GUI_DRAW_Poly_t p[4];
+    uint32_t i, wrong = 0;
+    
+    /* Edges with 64000 pixels in 2 scanlines, increment does not fit 16.16 format for one scanline */
+    p[0].X = -32000; p[0].Y = 10;
+    p[1].X = 32000; p[1].Y = 12;
+    p[2].X = 100; p[2].Y = 200;
+    wrong += CheckPoly(p, 3, GUI_DRAW_POLY_NONZERO);
+    
+    /* Long edges which start far above visible area */
+    p[0].X = -32768; p[0].Y = -32768;
+    p[1].X = 32767; p[1].Y = -32000;
+    p[2].X = 32767; p[2].Y = 32767;
+    p[3].X = -32000; p[3].Y = 32000;
+    wrong += CheckPoly(p, 4, GUI_DRAW_POLY_EVENODD);
+    
+    for (i = 0; i < 200; i++) {             /* Any coordinates */
+        p[0].X = Random(-32768, 32767); p[0].Y = Random(-32768, 32767);
+        p[1].X = Random(-32768, 32767); p[1].Y = Random(-32768, 32767);
+        p[2].X = Random(-32768, 32767); p[2].Y = Random(-32768, 32767);
+        p[3].X = Random(-1000, 1000); p[3].Y = Random(-1000, 1000);
+        wrong += CheckPoly(p, 4, GUI_DRAW_POLY_NONZERO);
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+static void TestWinding(void) {
+    GUI_DRAW_Poly_t p[40];
+    uint32_t i, j, len, wrong = 0;
+    
+    for (i = 0; i < 100; i++) {             /* Self-intersecting polygons with both rules */
+        len = Random(3, 40);
+        for (j = 0; j < len; j++) {
+            p[j].X = Random(-50, 530);
+            p[j].Y = Random(-50, 320);
+        }
+        wrong += CheckPoly(p, len, GUI_DRAW_POLY_EVENODD);
+        wrong += CheckPoly(p, len, GUI_DRAW_POLY_NONZERO);
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+static void TestSharedEdge(void) {
+    GUI_DRAW_Poly_t a[3] = {{10, 10}, {300, 40}, {50, 250}};
+    GUI_DRAW_Poly_t b[3] = {{300, 40}, {400, 260}, {50, 250}};
+    GUI_TEST_Pixels_t pixels;
+    uint32_t x, y, filled = 0;
+    
+    Clear();
+    GUI_TEST_GetPixels(&pixels);
+    GUI_DRAW_FilledPoly(&disp, a, 3, GUI_DRAW_POLY_NONZERO, FILL_COLOR);
+    GUI_DRAW_FilledPoly(&disp, b, 3, GUI_DRAW_POLY_NONZERO, FILL_COLOR);
+    GUI_TEST_GetPixels(&pixels);
+    for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+        for (x = 0; x < GUI_TEST_WIDTH; x++) {
+            filled += Pixel(x, y) == FILL_COLOR;
+        }
+    }
+    GUI_TEST_ASSERT(pixels.Drawn == filled);    /* No pixel on shared edge is drawn twice */
+}
+
+static void TestLargeCircle(void) {
+    int32_t x, y, r = 3000, cx = 240, cy = 3130;    /* Only top edge of circle is visible */
+    uint32_t wrong = 0;
+    double c;
+    
+    Clear();
+    GUI_DRAW_FilledCircleAA(&disp, cx, cy, r, 0xFFFFFF);
+    for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+        for (x = 0; x < GUI_TEST_WIDTH; x++) {
+            c = (r + 0.5 - hypot(x + 0.5 - cx, y + 0.5 - cy)) * 256;
+            c = fmax(fmin(c, 255), 0);      /* Expected coverage */
+            if (fabs((double)(Pixel(x, y) & 0xFF) - c) > 8) {
+                wrong++;
+            }
+        }
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+/* Draw random anti-aliased shape, radius is up to 3000 so most of large shapes is clipped */
+static void DrawShapeAA(GUI_Display_t* clip, uint32_t i, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t r, GUI_Dim_t w, GUI_Dim_t h) {
+    switch (i % 5) {
+        case 0: GUI_DRAW_CircleAA(clip, x, y, r, FILL_COLOR); break;
+        case 1: GUI_DRAW_FilledCircleAA(clip, x, y, r, FILL_COLOR); break;
+        case 2: GUI_DRAW_ArcAA(clip, x, y, r, (GUI_iDim_t)(i * 37 % 360), (GUI_iDim_t)(i * 101 % 360), FILL_COLOR); break;
+        case 3: GUI_DRAW_RoundedRectangleAA(clip, x, y, w, h, r, FILL_COLOR); break;
+        default: GUI_DRAW_FilledRoundedRectangleAA(clip, x, y, w, h, r, FILL_COLOR); break;
+    }
+}
+
+/*
+ * Shape drawn with small clipping region must match the same shape drawn on whole LCD
+ * inside the region and must not touch pixels outside of it
+ */
+static void TestClippedAA(void) {
+    static uint32_t full[GUI_TEST_WIDTH * GUI_TEST_HEIGHT];
+    GUI_Display_t clip;
+    int32_t x, y;
+    uint32_t i, wrong = 0, inside;
+    GUI_Dim_t cx, cy, r, w, h;
+    
+    for (i = 0; i < 500; i++) {
+        r = i & 8 ? Random(1, 3000) : Random(1, 100);
+        cx = Random(0, GUI_TEST_WIDTH);
+        cy = Random(0, GUI_TEST_HEIGHT);
+        w = Random(1, 2 * r + 200);
+        h = Random(1, 2 * r + 200);
+        clip.X1 = Random(0, GUI_TEST_WIDTH - 1);
+        clip.Y1 = Random(0, GUI_TEST_HEIGHT - 1);
+        clip.X2 = Random(clip.X1 + 1, GUI_TEST_WIDTH);
+        clip.Y2 = Random(clip.Y1 + 1, GUI_TEST_HEIGHT);
+        
+        Clear();
+        DrawShapeAA(&disp, i, cx, cy, r, w, h);
+        memcpy(full, GUI_TEST_Layer(GUI.LCD.DrawingLayer), sizeof(full));
+        Clear();
+        DrawShapeAA(&clip, i, cx, cy, r, w, h);
+        for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+            for (x = 0; x < GUI_TEST_WIDTH; x++) {
+                inside = x >= clip.X1 && x < clip.X2 && y >= clip.Y1 && y < clip.Y2;
+                if (Pixel(x, y) != (inside ? full[y * GUI_TEST_WIDTH + x] & 0x00FFFFFF : BG_COLOR)) {
+                    wrong++;
+                }
+            }
+        }
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+/* Compare line with Bresenham walk clipped to region, return number of wrong pixels */
+static uint32_t CheckLine(GUI_Display_t* clip, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    int32_t du, dv, su, sv, u, v, err, i, x, y;
+    uint8_t xmajor;
+    uint32_t wrong = 0, count = 0, drawn = 0;
+    
+    Clear();
+    GUI_DRAW_Line(clip, x1, y1, x2, y2, FILL_COLOR);
+    
+    xmajor = abs(x2 - x1) >= abs(y2 - y1);
+    du = xmajor ? x2 - x1 : y2 - y1;
+    dv = xmajor ? y2 - y1 : x2 - x1;
+    su = du >= 0 ? 1 : -1;
+    sv = dv >= 0 ? 1 : -1;
+    du = abs(du);
+    dv = abs(dv);
+    u = xmajor ? x1 : y1;
+    v = xmajor ? y1 : x1;
+    err = du / 2;
+    for (i = 0; i <= du; i++) {
+        x = xmajor ? u : v;
+        y = xmajor ? v : u;
+        if (x >= clip->X1 && x < clip->X2 && y >= clip->Y1 && y < clip->Y2) {
+            count++;
+            wrong += Pixel(x, y) != FILL_COLOR;
+        }
+        u += su;
+        err += dv;
+        if (err >= du) {
+            err -= du;
+            v += sv;
+        }
+    }
+    for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+        for (x = 0; x < GUI_TEST_WIDTH; x++) {
+            drawn += Pixel(x, y) == FILL_COLOR;
+        }
+    }
+    return wrong + (drawn > count ? drawn - count : count - drawn);
+}
+
+static void TestLines(void) {
+    GUI_Display_t clip = {40, 30, GUI_TEST_WIDTH - 40, GUI_TEST_HEIGHT - 30};
+    uint32_t i, wrong = 0;
+    int32_t x1, y1, x2, y2;
+    
+    GUI_TEST_ASSERT(CheckLine(&disp, 64388, 36820, 408, 137) == 0);
+    GUI_TEST_ASSERT(CheckLine(&disp, 65000, 50000, 100, 100) == 0);
+    GUI_TEST_ASSERT(CheckLine(&disp, 100, 100, 65000, 50000) == 0);
+    for (i = 0; i < 2000; i++) {
+        x1 = Random(0, GUI_TEST_WIDTH);
+        y1 = Random(0, GUI_TEST_HEIGHT);
+        if (i & 1) {                        /* Far end point, long line crosses screen */
+            x2 = Random(0, 65535);
+            y2 = Random(0, 65535);
+        } else {                            /* Short line */
+            x2 = Random(0, GUI_TEST_WIDTH);
+            y2 = Random(0, GUI_TEST_HEIGHT);
+        }
+        if (i & 4) {                        /* Both directions */
+            wrong += CheckLine(i & 2 ? &clip : &disp, x2, y2, x1, y1) != 0;
+        } else {
+            wrong += CheckLine(i & 2 ? &clip : &disp, x1, y1, x2, y2) != 0;   /* Clipped on screen and region edges */
+        }
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    
+    TestTriangles();
+    TestFarPoints();
+    TestWinding();
+    TestSharedEdge();
+    TestLargeCircle();
+    TestClippedAA();
+    TestLines();
+    return GUI_TEST_Result();
+}
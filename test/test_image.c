@@ -0,0 +1,186 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_draw.h"
+
+/*
+ * Images in RGB565, PAL8 and RLE8 formats are drawn with clipping and compared with reference.
+ *
+ * Reference is made from the same palette indexes on host, drawing layer is filled with
+ * background first and every pixel of layer is checked, pixels outside clipping region must stay.
+ * Image is wider than decode buffer and RLE packets continue from one row to another.
+ */
+#define WIDTH                       150
+#define HEIGHT                      60
+#define BACKGROUND                  0x00123456
+#define RANDOM_CASES                300
+
+static uint32_t palette[256];
+static uint8_t indexes[WIDTH * HEIGHT];
+static uint16_t rgb565[WIDTH * HEIGHT];
+static uint8_t rle[WIDTH * HEIGHT * 2];
+static uint32_t reference[3][WIDTH * HEIGHT];   /* Expected colors by format */
+static GUI_IMAGE_DESC_t images[3];
+static const char* names[3] = {"RGB565", "PAL8", "RLE8"};
+static uint32_t seed = 1;
+
+static uint32_t Random(uint32_t max) {
+    seed = seed * 1103515245UL + 12345;
+    return (seed >> 16) % max;
+}
+
+/* Compress indexes with runs of equal bytes and literal packets */
+static uint32_t EncodeRLE(const uint8_t* src, uint32_t count, uint8_t* dst) {
+    uint32_t i = 0, n, len = 0;
+    
+    while (i < count) {
+        for (n = 1; i + n < count && n < 128 && src[i + n] == src[i]; n++);
+        if (n >= 3) {                       /* Repeat packet */
+            dst[len++] = 0x80 | (n - 1);
+            dst[len++] = src[i];
+            i += n;
+            continue;
+        }
+        for (n = 1; i + n < count && n < 128; n++) {    /* Literal packet until next run */
+            if (i + n + 2 < count && src[i + n] == src[i + n + 1] && src[i + n] == src[i + n + 2]) {
+                break;
+            }
+        }
+        dst[len++] = n - 1;
+        memcpy(&dst[len], &src[i], n);
+        len += n;
+        i += n;
+    }
+    return len;
+}
+
+/* Flat areas for long runs and noisy areas for literal packets */
+static void Generate(void) {
+    uint32_t i, x, y, c;
+    
+    for (i = 0; i < 256; i++) {
+        palette[i] = 0xFF000000UL | ((i * 0x9E3779B1UL) & 0x00FFFFFFUL);
+    }
+    for (y = 0; y < HEIGHT; y++) {
+        for (x = 0; x < WIDTH; x++) {
+            i = y * WIDTH + x;
+            indexes[i] = ((x / 20 + y / 10) & 1) ? (y / 4) : Random(256);
+            
+            c = palette[indexes[i]];
+            rgb565[i] = ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+            c = rgb565[i];                  /* Expand 5 and 6 bits by repeating top bits */
+            reference[0][i] = (((c >> 11) << 3 | (c >> 13)) << 16) |
+                ((((c >> 5) & 0x3F) << 2 | ((c >> 9) & 0x03)) << 8) |
+                ((c & 0x1F) << 3 | ((c >> 2) & 0x07));
+            reference[1][i] = palette[indexes[i]] & 0x00FFFFFF;
+            reference[2][i] = reference[1][i];
+        }
+    }
+    
+    images[0].Format = GUI_IMAGE_FORMAT_RGB565;
+    images[0].Data = (const GUI_Byte *)rgb565;
+    images[1].Format = GUI_IMAGE_FORMAT_PAL8;
+    images[1].Data = indexes;
+    images[2].Format = GUI_IMAGE_FORMAT_RLE8;
+    images[2].Data = rle;
+    images[2].Size = EncodeRLE(indexes, WIDTH * HEIGHT, rle);
+    for (i = 0; i < 3; i++) {
+        images[i].xSize = WIDTH;
+        images[i].ySize = HEIGHT;
+        images[i].Palette = palette;
+    }
+}
+
+/* Draw image and return number of wrong pixels on complete layer */
+static uint32_t Draw(uint8_t format, GUI_iDim_t x, GUI_iDim_t y, GUI_Display_t* clip) {
+    uint32_t* layer = GUI_TEST_Layer(GUI.LCD.DrawingLayer);
+    uint32_t i, exp, wrong = 0;
+    int32_t px, py;
+    
+    for (i = 0; i < GUI_TEST_WIDTH * GUI_TEST_HEIGHT; i++) {
+        layer[i] = BACKGROUND;
+    }
+    GUI_DRAW_Image(clip, x, y, &images[format]);
+    
+    for (py = 0; py < GUI_TEST_HEIGHT; py++) {
+        for (px = 0; px < GUI_TEST_WIDTH; px++) {
+            exp = BACKGROUND;
+            if (px >= clip->X1 && px < clip->X2 && py >= clip->Y1 && py < clip->Y2 &&
+                px >= x && px < x + WIDTH && py >= y && py < y + HEIGHT) {
+                exp = reference[format][(py - y) * WIDTH + (px - x)];
+            }
+            wrong += (layer[py * GUI_TEST_WIDTH + px] & 0x00FFFFFF) != exp;
+        }
+    }
+    return wrong;
+}
+
+static void TestPlaced(void) {
+    GUI_Display_t full = {0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT};
+    GUI_Display_t clip = {37, 21, 181, 70};
+    uint8_t f;
+    
+    for (f = 0; f < 3; f++) {
+        GUI_TEST_ASSERT(Draw(f, 10, 10, &full) == 0);
+        GUI_TEST_ASSERT(Draw(f, -70, -25, &full) == 0);     /* Outside top left of screen */
+        GUI_TEST_ASSERT(Draw(f, GUI_TEST_WIDTH - 30, GUI_TEST_HEIGHT - 7, &full) == 0);
+        GUI_TEST_ASSERT(Draw(f, 30, 15, &clip) == 0);       /* Starts inside row and RLE packet */
+    }
+}
+
+static void TestRandom(void) {
+    GUI_Display_t clip;
+    uint32_t i, wrong[3] = {0, 0, 0};
+    GUI_iDim_t x, y;
+    uint8_t f;
+    
+    for (i = 0; i < RANDOM_CASES; i++) {
+        clip.X1 = Random(GUI_TEST_WIDTH);
+        clip.Y1 = Random(GUI_TEST_HEIGHT);
+        clip.X2 = clip.X1 + 1 + Random(GUI_TEST_WIDTH - clip.X1);
+        clip.Y2 = clip.Y1 + 1 + Random(GUI_TEST_HEIGHT - clip.Y1);
+        x = (GUI_iDim_t)Random(GUI_TEST_WIDTH + WIDTH) - WIDTH;
+        y = (GUI_iDim_t)Random(GUI_TEST_HEIGHT + HEIGHT) - HEIGHT;
+        for (f = 0; f < 3; f++) {
+            if (Draw(f, x, y, &clip)) {
+                wrong[f]++;
+                printf("%s at %d,%d clip %u,%u-%u,%u\n", names[f], x, y, clip.X1, clip.Y1, clip.X2, clip.Y2);
+            }
+        }
+    }
+    GUI_TEST_ASSERT(wrong[0] == 0);
+    GUI_TEST_ASSERT(wrong[1] == 0);
+    GUI_TEST_ASSERT(wrong[2] == 0);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    Generate();
+    
+    TestPlaced();
+    TestRandom();
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,147 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_input.h"
+#include "gui_window.h"
+#include "gui_button.h"
+
+/*
+ * Touch samples are added to input queue faster than frames are processed.
+ * Moves of pressed touch must be merged, widget gets one move per frame at newest position.
+ */
+#define BTN_X                       100
+#define BTN_Y                       50
+
+static GUI_HANDLE_t btn;
+
+static void Touch(GUI_TouchState_t status, uint8_t count, GUI_Dim_t x, GUI_Dim_t y) {
+    GUI_TouchData_t t;
+    
+    memset((void *)&t, 0x00, sizeof(t));
+    t.Status = status;
+    t.Count = count;
+    t.X[0] = x;
+    t.Y[0] = y;
+    t.X[1] = x + 50;
+    t.Y[1] = y;
+    GUI_INPUT_AddTouch(&t);
+}
+
+static void ResetStats(void) {
+    GUI_INPUT_Stats_t stats;
+    
+    GUI_INPUT_GetStats(&stats, 1);
+}
+
+/* Put button back to start position */
+static void Place(void) {
+    __GUI_WIDGET_SetXY(btn, BTN_X, BTN_Y);
+    GUI_TEST_Frame(10);
+    ResetStats();
+}
+
+static void TestMergeMoves(void) {
+    GUI_INPUT_Stats_t stats;
+    uint8_t i;
+    
+    Place();
+    Touch(GUI_TouchState_PRESSED, 1, BTN_X + 10, BTN_Y + 10);
+    GUI_TEST_Frame(10);
+    GUI_TEST_ASSERT(GUI.ActiveWidget == btn);
+    
+    for (i = 1; i <= 10; i++) {             /* Finger moves faster than GUI processes */
+        Touch(GUI_TouchState_PRESSED, 1, BTN_X + 10 + i * 3, BTN_Y + 10 + i);
+    }
+    GUI_TEST_Frame(20);
+    GUI_INPUT_GetStats(&stats, 0);
+    GUI_TEST_ASSERT(stats.Added == 11 && stats.Dropped == 0);
+    GUI_TEST_ASSERT(stats.Merged == 9);     /* Ten moves read as one */
+    GUI_TEST_ASSERT(stats.Moves == 1);
+    GUI_TEST_ASSERT(stats.MaxLatency == 20);
+    GUI_TEST_ASSERT(btn->X == BTN_X + 30 && btn->Y == BTN_Y + 10);  /* Newest position */
+    
+    Touch(GUI_TouchState_RELEASED, 0, BTN_X + 40, BTN_Y + 10);
+    GUI_TEST_Frame(10);
+    GUI_INPUT_GetStats(&stats, 0);
+    GUI_TEST_ASSERT(stats.Moves == 1 && GUI.ActiveWidget == NULL);
+}
+
+static void TestCoalesceMoves(void) {
+    GUI_INPUT_Stats_t stats;
+    uint8_t i;
+    
+    Place();
+    Touch(GUI_TouchState_PRESSED, 1, BTN_X + 10, BTN_Y + 10);
+    GUI_TEST_Frame(10);
+    
+    for (i = 1; i <= 6; i++) {              /* Different number of points is not merged in queue */
+        Touch(GUI_TouchState_PRESSED, 1 + (i & 1), BTN_X + 10 + i, BTN_Y + 10);
+    }
+    GUI_TEST_Frame(10);
+    GUI_INPUT_GetStats(&stats, 0);
+    GUI_TEST_ASSERT(stats.Merged == 0);
+    GUI_TEST_ASSERT(stats.Moves == 1);      /* Only last move of frame is sent to widget */
+    GUI_TEST_ASSERT(btn->X == BTN_X + 6);
+    
+    /* Press and release in the same frame, pending move is sent before release */
+    Touch(GUI_TouchState_PRESSED, 1, BTN_X + 20, BTN_Y + 10);
+    Touch(GUI_TouchState_PRESSED, 1, BTN_X + 24, BTN_Y + 10);
+    Touch(GUI_TouchState_RELEASED, 0, BTN_X + 24, BTN_Y + 10);
+    GUI_TEST_Frame(10);
+    GUI_INPUT_GetStats(&stats, 0);
+    GUI_TEST_ASSERT(stats.Merged == 1 && stats.Moves == 2);
+    GUI_TEST_ASSERT(btn->X == BTN_X + 14 && GUI.ActiveWidget == NULL);
+}
+
+static void TestFullQueue(void) {
+    GUI_INPUT_Stats_t stats;
+    uint8_t i;
+    
+    Place();
+    Touch(GUI_TouchState_PRESSED, 1, BTN_X + 10, BTN_Y + 10);
+    for (i = 0; i < GUI_INPUT_TOUCH_QUEUE_SIZE + 4; i++) {
+        Touch(GUI_TouchState_PRESSED, 1, BTN_X + 11 + i, BTN_Y + 10);
+    }
+    GUI_TEST_Frame(10);
+    GUI_INPUT_GetStats(&stats, 1);
+    GUI_TEST_ASSERT(stats.Added == GUI_INPUT_TOUCH_QUEUE_SIZE && stats.Dropped == 5);
+    GUI_TEST_ASSERT(GUI_INPUT_GetDroppedTouch() == 0);  /* Reset by previous call */
+    GUI_TEST_ASSERT(stats.Merged == GUI_INPUT_TOUCH_QUEUE_SIZE - 2 && stats.Moves == 1);
+    
+    Touch(GUI_TouchState_RELEASED, 0, 0, 0);
+    GUI_TEST_Frame(10);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    GUI_WINDOW_Create(0);
+    btn = GUI_BUTTON_Create(1, BTN_X, BTN_Y, 100, 50);
+    
+    TestMergeMoves();
+    TestCoalesceMoves();
+    TestFullQueue();
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,201 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_jpeg.h"
+
+/*
+ * Baseline JPEG images are decoded and compared with reference decoder output.
+ *
+ * Images in data/jpeg/ were encoded with libjpeg at quality 90, reference PPM files
+ * are decoded with libjpeg integer IDCT and sample repeat upsampling, same as:
+ *   djpeg -dct int -nosmooth -pnm image.jpg > image.ppm
+ * Images sizes are not multiples of MCU size, 420_restart has restart marker after every MCU.
+ */
+#define JPEG_DIR                    "data/jpeg/"
+#define MAX_SIZE                    64
+#define TOLERANCE                   2       /* Maximal difference of color channel from reference */
+
+typedef struct {
+    GUI_Dim_t Width, Height;
+    uint32_t Pixels[MAX_SIZE * MAX_SIZE];
+    uint8_t Written[MAX_SIZE * MAX_SIZE];   /* Number of writes to each pixel */
+    GUI_Display_t Clip;
+    uint32_t Outside;                       /* Blocks outside image or clipping region */
+} Image_t;
+
+static Image_t img;
+
+static uint8_t* Load(const char* name, uint32_t* size) {
+    char path[64];
+    uint8_t* data;
+    FILE* f;
+    long len;
+    
+    sprintf(path, JPEG_DIR "%s", name);
+    if ((f = fopen(path, "rb")) == NULL) {
+        printf("Can not open %s\n", path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(len);
+    *size = fread(data, 1, len, f);
+    fclose(f);
+    return data;
+}
+
+/* Read binary PPM file to RGB888 pixels */
+static uint8_t LoadReference(const char* name, uint32_t* pixels, GUI_Dim_t* width, GUI_Dim_t* height) {
+    uint32_t size, i;
+    uint8_t* data, *p;
+    unsigned w, h;
+    int n = 0;
+    
+    if ((data = Load(name, &size)) == NULL) {
+        return 0;
+    }
+    if (sscanf((char *)data, "P6 %u %u 255%n", &w, &h, &n) != 2 || !n || w > MAX_SIZE || h > MAX_SIZE) {
+        free(data);
+        return 0;
+    }
+    p = data + n + 1;
+    for (i = 0; i < w * h; i++, p += 3) {
+        pixels[i] = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    }
+    *width = w;
+    *height = h;
+    free(data);
+    return 1;
+}
+
+static void Block(void* param, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, const uint32_t* pixels, GUI_Dim_t offLine) {
+    Image_t* im = param;
+    GUI_Dim_t i, k;
+    
+    if (x + width > im->Width || y + height > im->Height ||
+        x >= im->Clip.X2 || y >= im->Clip.Y2 || x + width <= im->Clip.X1 || y + height <= im->Clip.Y1) {
+        im->Outside++;
+        return;
+    }
+    for (i = 0; i < height; i++) {
+        for (k = 0; k < width; k++) {
+            im->Pixels[(y + i) * MAX_SIZE + x + k] = pixels[i * (width + offLine) + k];
+            im->Written[(y + i) * MAX_SIZE + x + k]++;
+        }
+    }
+}
+
+static uint8_t Diff(uint32_t a, uint32_t b) {
+    uint8_t i, d, max = 0;
+    
+    for (i = 0; i < 24; i += 8) {
+        d = abs((int)((a >> i) & 0xFF) - (int)((b >> i) & 0xFF));
+        max = d > max ? d : max;
+    }
+    return max;
+}
+
+/* Decode image in clipping region and compare visible pixels with reference */
+static void TestImage(const char* name, GUI_Dim_t x1, GUI_Dim_t y1, GUI_Dim_t x2, GUI_Dim_t y2) {
+    static uint32_t ref[MAX_SIZE * MAX_SIZE];
+    char file[32];
+    uint8_t* data;
+    uint32_t size, wrong = 0;
+    GUI_Dim_t w = 0, h = 0, x, y;
+    
+    sprintf(file, "%s.ppm", name);
+    GUI_TEST_ASSERT(LoadReference(file, ref, &w, &h));
+    sprintf(file, "%s.jpg", name);
+    GUI_TEST_ASSERT((data = Load(file, &size)) != NULL);
+    if (data == NULL) {
+        return;
+    }
+    
+    memset((void *)&img, 0x00, sizeof(img));
+    GUI_TEST_ASSERT(GUI_JPEG_GetSize(data, size, &img.Width, &img.Height));
+    GUI_TEST_ASSERT(img.Width == w && img.Height == h);
+    img.Clip.X1 = x1;
+    img.Clip.Y1 = y1;
+    img.Clip.X2 = x2 < w ? x2 : w;
+    img.Clip.Y2 = y2 < h ? y2 : h;
+    GUI_TEST_ASSERT(GUI_JPEG_Decode(data, size, &img.Clip, Block, &img));
+    GUI_TEST_ASSERT(img.Outside == 0);
+    
+    for (y = img.Clip.Y1; y < img.Clip.Y2; y++) {
+        for (x = img.Clip.X1; x < img.Clip.X2; x++) {
+            if (img.Written[y * MAX_SIZE + x] != 1 || Diff(img.Pixels[y * MAX_SIZE + x], ref[y * w + x]) > TOLERANCE) {
+                wrong++;
+            }
+        }
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+    free(data);
+}
+
+/* Truncated and damaged images must be rejected or decoded without access outside of data */
+static void TestCorrupt(void) {
+    uint32_t size, len, i, seed = 5;
+    uint8_t* data, *copy;
+    
+    if ((data = Load("420_restart.jpg", &size)) == NULL) {
+        GUI_TEST_ASSERT(data != NULL);
+        return;
+    }
+    for (len = 0; len < size; len += 7) {
+        copy = malloc(len + 1);             /* Exact size, sanitizer reports reads after end */
+        memcpy(copy, data, len);
+        memset((void *)&img, 0x00, sizeof(img));
+        img.Width = img.Height = MAX_SIZE;
+        img.Clip.X2 = img.Clip.Y2 = MAX_SIZE;
+        GUI_JPEG_Decode(copy, len, NULL, Block, &img);
+        free(copy);
+    }
+    for (i = 0; i < 200; i++) {
+        copy = malloc(size);
+        memcpy(copy, data, size);
+        seed = seed * 1103515245UL + 12345;
+        copy[(seed >> 8) % size] ^= 1 << ((seed >> 4) & 7);
+        memset((void *)&img, 0x00, sizeof(img));
+        img.Width = img.Height = MAX_SIZE;
+        img.Clip.X2 = img.Clip.Y2 = MAX_SIZE;
+        GUI_JPEG_Decode(copy, size, NULL, Block, &img);
+        free(copy);
+    }
+    GUI_TEST_ASSERT(!GUI_JPEG_Decode(data, 100, NULL, Block, &img));
+    free(data);
+}
+
+int main(void) {
+    TestImage("444", 0, 0, MAX_SIZE, MAX_SIZE);
+    TestImage("422", 0, 0, MAX_SIZE, MAX_SIZE);
+    TestImage("420", 0, 0, MAX_SIZE, MAX_SIZE);
+    TestImage("gray", 0, 0, MAX_SIZE, MAX_SIZE);
+    TestImage("420_restart", 0, 0, MAX_SIZE, MAX_SIZE);
+    TestImage("420_restart", 17, 9, 33, 20);    /* Only part of image is decoded */
+    TestCorrupt();
+    return GUI_TEST_Result();
+}
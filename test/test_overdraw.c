@@ -0,0 +1,106 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_window.h"
+#include "gui_button.h"
+
+/*
+ * Windows are stacked on desktop window and screen is redrawn completely.
+ * Pixels written by low-level driver are counted, widgets and window backgrounds
+ * hidden behind opaque windows must not be drawn at all.
+ */
+#define AREA(w, h)                  ((uint32_t)(w) * (h))
+#define SCREEN                      AREA(GUI_TEST_WIDTH, GUI_TEST_HEIGHT)
+
+static GUI_HANDLE_t desktop, btn, left, right;
+static uint32_t btnPixels;
+
+static GUI_Color_t Pixel(GUI_Dim_t x, GUI_Dim_t y) {
+    return GUI_TEST_GetPixel(x, y) & 0x00FFFFFF;
+}
+
+/* Redraw complete screen and return number of drawn pixels */
+static uint32_t Redraw(void* h) {
+    GUI_TEST_Pixels_t pixels;
+    
+    GUI_TEST_GetPixels(&pixels);
+    __GUI_WIDGET_Invalidate(h);
+    GUI_TEST_Frame(10);
+    GUI_TEST_GetPixels(&pixels);
+    return pixels.Drawn;
+}
+
+static void TestVisible(void) {
+    desktop = GUI_WINDOW_Create(0);
+    btn = GUI_BUTTON_Create(1, 10, 10, 100, 40);
+    GUI_TEST_Frame(10);
+    
+    btnPixels = Redraw(desktop) - SCREEN;   /* Desktop and button, nothing is hidden */
+    GUI_TEST_ASSERT(btnPixels >= AREA(100, 40));
+}
+
+static void TestCovered(void) {
+    GUI.WindowActive = desktop;
+    left = GUI_WINDOW_CreateChild(2, 0, 0, GUI_TEST_WIDTH / 2, GUI_TEST_HEIGHT);
+    GUI.WindowActive = desktop;
+    right = GUI_WINDOW_CreateChild(3, GUI_TEST_WIDTH / 2, 0, GUI_TEST_WIDTH / 2, GUI_TEST_HEIGHT);
+    GUI_WINDOW_SetColor(right, GUI_WINDOW_COLOR_BG, GUI_COLOR_BLUE);
+    
+    /* Two windows together cover desktop and button, every pixel is written once */
+    GUI_TEST_ASSERT(Redraw(desktop) == SCREEN);
+    GUI_TEST_ASSERT(Pixel(20, 20) == GUI_COLOR_LIGHTGRAY);
+    GUI_TEST_ASSERT(Pixel(GUI_TEST_WIDTH - 1, 0) == GUI_COLOR_BLUE);
+    
+    /* Hidden button is invalidated, only part of left window above it is drawn */
+    GUI_TEST_ASSERT(Redraw(btn) == AREA(100, 40));
+}
+
+static void TestTransparent(void) {
+    /* Desktop is visible through right window, button is still hidden */
+    GUI_WINDOW_SetColor(right, GUI_WINDOW_COLOR_BG, 0x80FF0000);
+    GUI_TEST_ASSERT(Redraw(desktop) == SCREEN + SCREEN);
+    GUI_WINDOW_SetColor(right, GUI_WINDOW_COLOR_BG, GUI_COLOR_BLUE);
+    GUI_TEST_ASSERT(Redraw(desktop) == SCREEN);
+}
+
+static void TestPartial(void) {
+    /* Left part of desktop and button are visible, everything is drawn */
+    __GUI_WIDGET_SetXY(left, 50, 0);
+    __GUI_WIDGET_SetSize(left, GUI_TEST_WIDTH / 2 - 50, GUI_TEST_HEIGHT);
+    GUI_TEST_ASSERT(Redraw(desktop) == SCREEN + btnPixels + SCREEN - AREA(50, GUI_TEST_HEIGHT));
+    GUI_TEST_ASSERT(Pixel(20, 20) != GUI_COLOR_LIGHTGRAY);  /* Button */
+    GUI_TEST_ASSERT(Pixel(60, 20) == GUI_COLOR_LIGHTGRAY);  /* Left window */
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    
+    TestVisible();
+    TestCovered();
+    TestTransparent();
+    TestPartial();
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,189 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_window.h"
+#include "gui_list.h"
+#include "string.h"
+
+/*
+ * Scroll view moves content on layer and draws only exposed strip.
+ * Screen after moved content must be the same as after complete redraw.
+ * Every frame copies shown layer to drawing layer first, which is counted as copied screen.
+ */
+#define AREA(w, h)                  ((uint32_t)(w) * (h))
+#define SCREEN                      AREA(GUI_TEST_WIDTH, GUI_TEST_HEIGHT)
+#define ROW_HEIGHT                  24
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+static GUI_HANDLE_t root;
+static GUI_Color_t screen[GUI_TEST_HEIGHT][GUI_TEST_WIDTH];
+
+static uint32_t GetCount(GUI_HANDLE_t h) {
+    return 1000;
+}
+
+static const char* GetText(GUI_HANDLE_t h, uint32_t row, uint8_t column) {
+    static char text[16];
+    
+    sprintf(text, "%u", (unsigned)row);
+    return text;
+}
+
+static const GUI_LIST_PROVIDER_t provider = {GetCount, GetText, NULL};
+
+static void Touch(GUI_TouchState_t status, GUI_Dim_t x, GUI_Dim_t y) {
+    GUI_TouchData_t t;
+    
+    memset((void *)&t, 0x00, sizeof(t));
+    t.Status = status;
+    t.Count = status == GUI_TouchState_PRESSED;
+    t.X[0] = x;
+    t.Y[0] = y;
+    GUI_INPUT_AddTouch(&t);
+}
+
+/* Save shown screen */
+static void Save(void) {
+    GUI_Dim_t x, y;
+    
+    for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+        for (x = 0; x < GUI_TEST_WIDTH; x++) {
+            screen[y][x] = GUI_TEST_GetPixel(x, y);
+        }
+    }
+}
+
+/* Number of pixels different from saved screen */
+static uint32_t Compare(void) {
+    GUI_Dim_t x, y;
+    uint32_t n = 0;
+    
+    for (y = 0; y < GUI_TEST_HEIGHT; y++) {
+        for (x = 0; x < GUI_TEST_WIDTH; x++) {
+            n += screen[y][x] != GUI_TEST_GetPixel(x, y);
+        }
+    }
+    return n;
+}
+
+/* Move view by delta pixels and check that only exposed strip is drawn */
+static void Move(GUI_HANDLE_t h, int32_t delta) {
+    GUI_TEST_Pixels_t pixels;
+    
+    GUI_TEST_GetPixels(&pixels);
+    GUI_SCROLL_SetOffset(h, ((GUI_SCROLL_t *)h)->Offset + delta);
+    GUI_TEST_Frame(10);
+    GUI_TEST_GetPixels(&pixels);
+    if (delta < 0) {
+        delta = -delta;
+    }
+    GUI_TEST_ASSERT(pixels.Copied == SCREEN + AREA(GUI_TEST_WIDTH, GUI_TEST_HEIGHT - delta));
+    GUI_TEST_ASSERT(pixels.Drawn >= AREA(GUI_TEST_WIDTH, delta));   /* Background and text of new items */
+    GUI_TEST_ASSERT(pixels.Drawn < AREA(GUI_TEST_WIDTH, 3 * delta));
+    
+    Save();                                 /* Moved content must match complete redraw */
+    __GUI_WIDGET_Invalidate(h);
+    GUI_TEST_Frame(10);
+    GUI_TEST_GetPixels(&pixels);
+    GUI_TEST_ASSERT(pixels.Copied == SCREEN);
+    GUI_TEST_ASSERT(Compare() == 0);
+}
+
+static void TestStrip(void) {
+    GUI_TEST_Pixels_t pixels;
+    GUI_HANDLE_t h;
+    
+    GUI.WindowActive = root;
+    h = GUI_LIST_Create(1, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT, ROW_HEIGHT, &provider);
+    GUI_LIST_SetFont(h, &GUI_Font_Arial_Bold_18);
+    GUI_TEST_Frame(10);
+    
+    Move(h, 10);                            /* Part of row */
+    Move(h, ROW_HEIGHT * 3 + 5);            /* Several rows */
+    Move(h, -7);                            /* New items on top */
+    
+    GUI_TEST_GetPixels(&pixels);            /* Nothing can be moved, complete view is drawn */
+    GUI_SCROLL_SetOffset(h, ((GUI_SCROLL_t *)h)->Offset + GUI_TEST_HEIGHT);
+    GUI_TEST_Frame(10);
+    GUI_TEST_GetPixels(&pixels);
+    GUI_TEST_ASSERT(pixels.Copied == SCREEN && pixels.Drawn >= SCREEN);
+    
+    GUI_LIST_Remove(&h);
+}
+
+static void TestRemoveFling(void) {
+    GUI_HANDLE_t win, h;
+    int32_t offset;
+    uint8_t i;
+    
+    GUI.WindowActive = root;
+    win = GUI_WINDOW_CreateChild(2, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT);
+    h = GUI_LIST_Create(1, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT, ROW_HEIGHT, &provider);
+    GUI_TEST_Frame(10);
+    
+    Touch(GUI_TouchState_PRESSED, 100, 250);
+    GUI_TEST_Frame(10);
+    for (i = 1; i <= 5; i++) {              /* Fast drag up */
+        Touch(GUI_TouchState_PRESSED, 100, 250 - i * 40);
+        GUI_TEST_Frame(10);
+    }
+    Touch(GUI_TouchState_RELEASED, 100, 50);
+    GUI_TEST_Frame(10);
+    offset = ((GUI_SCROLL_t *)h)->Offset;
+    GUI_TEST_Frame(10);
+    GUI_TEST_ASSERT(((GUI_SCROLL_t *)h)->Offset > offset);  /* List keeps moving after release */
+    
+    __GUI_WIDGET_Remove(&win);              /* Flinging list is removed with its parent */
+    for (i = 0; i < 10; i++) {
+        GUI_TEST_Frame(10);
+    }
+    GUI_TEST_ASSERT(win == NULL);
+}
+
+static void TestRows(void) {
+    GUI_HANDLE_t h;
+    
+    GUI.WindowActive = root;
+    h = GUI_LIST_Create(1, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT, 1, &provider);
+    GUI_TEST_Frame(10);
+    
+    /* Every visible item has own row widget */
+    GUI_TEST_ASSERT(((GUI_SCROLL_t *)h)->ItemHeight > 1);
+    GUI_TEST_ASSERT(((GUI_SCROLL_t *)h)->RowsCount * ((GUI_SCROLL_t *)h)->ItemHeight >= GUI_TEST_HEIGHT + ((GUI_SCROLL_t *)h)->ItemHeight);
+    
+    GUI_LIST_Remove(&h);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    root = GUI.WindowActive;
+    
+    TestStrip();
+    TestRemoveFling();
+    TestRows();
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,211 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "touch_async.h"
+
+/*
+ * Touch reader with simulated FT5336 on I2C bus.
+ * Transfer is started by reader and completed when test calls I2C_Finish, like from I2C interrupt.
+ */
+static struct {
+    uint8_t Regs[256];                      /* Controller registers */
+    uint8_t Busy;                           /* Number of next starts which find bus busy */
+    uint8_t Active;                         /* Transfer in progress */
+    uint8_t Reg;                            /* Transfer parameters */
+    uint8_t* Data;
+    uint16_t Count;
+    uint32_t Starts;                        /* Number of started transfers */
+    uint32_t Overlaps;                      /* Start called while transfer is in progress */
+} I2C;
+
+static TOUCH_ASYNC_t TA;
+static TM_TOUCH_t TS, Last;
+static uint32_t Readies;
+
+static uint8_t I2C_Start(uint8_t reg, uint8_t* data, uint16_t count) {
+    if (I2C.Active) {
+        I2C.Overlaps++;
+        return 1;
+    }
+    if (I2C.Busy) {
+        I2C.Busy--;
+        return 1;
+    }
+    I2C.Active = 1;
+    I2C.Reg = reg;
+    I2C.Data = data;
+    I2C.Count = count;
+    I2C.Starts++;
+    return 0;
+}
+
+/* End transfer from interrupt, copy registers on success */
+static void I2C_Finish(uint8_t ok) {
+    if (!I2C.Active) {
+        return;
+    }
+    I2C.Active = 0;
+    if (ok) {
+        memcpy(I2C.Data, &I2C.Regs[I2C.Reg], I2C.Count);
+    }
+    TOUCH_ASYNC_Complete(&TA, ok);
+}
+
+static void Ready(TM_TOUCH_t* ts) {
+    Readies++;
+    memcpy(&Last, ts, sizeof(Last));
+}
+
+/* Set touch points in controller registers */
+static void SetTouch(uint8_t num, uint16_t x, uint16_t y) {
+    uint8_t i, *p;
+    
+    I2C.Regs[TOUCH_ASYNC_REG] = num;
+    for (i = 0; i < num; i++) {
+        p = &I2C.Regs[TOUCH_ASYNC_REG + 1 + i * TOUCH_ASYNC_POINT_SIZE];
+        p[0] = (y + i) >> 8;
+        p[1] = (y + i) & 0xFF;
+        p[2] = (x + i) >> 8;
+        p[3] = (x + i) & 0xFF;
+    }
+}
+
+static void Reset(void) {
+    memset(&I2C, 0x00, sizeof(I2C));
+    memset(&TS, 0x00, sizeof(TS));
+    memset(&Last, 0x00, sizeof(Last));
+    TS.Orientation = 1;                     /* Controller coordinates are not changed */
+    TS.MaxX = 480;
+    TS.MaxY = 272;
+    Readies = 0;
+    TOUCH_ASYNC_Init(&TA, &TS, I2C_Start, Ready);
+}
+
+static void TestRead(void) {
+    Reset();
+    SetTouch(2, 100, 50);
+    TOUCH_ASYNC_Signal(&TA);
+    GUI_TEST_ASSERT(I2C.Starts == 1);
+    GUI_TEST_ASSERT(I2C.Reg == TOUCH_ASYNC_REG && I2C.Count == TOUCH_ASYNC_SIZE);
+    GUI_TEST_ASSERT(Readies == 0);      /* Nothing is reported before transfer ends */
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Readies == 1 && TA.Reads == 1 && TA.Errors == 0);
+    GUI_TEST_ASSERT(Last.NumPresses == 2);
+    GUI_TEST_ASSERT(Last.X[0] == 100 && Last.Y[0] == 50);
+    GUI_TEST_ASSERT(Last.X[1] == 101 && Last.Y[1] == 51);
+    GUI_TEST_ASSERT(TA.State == TOUCH_ASYNC_State_Idle);
+}
+
+static void TestSignalDuringTransfer(void) {
+    Reset();
+    SetTouch(1, 10, 20);
+    TOUCH_ASYNC_Signal(&TA);
+    SetTouch(1, 30, 40);                    /* Finger moves while registers are read */
+    TOUCH_ASYNC_Signal(&TA);
+    TOUCH_ASYNC_Signal(&TA);
+    GUI_TEST_ASSERT(I2C.Starts == 1 && I2C.Overlaps == 0);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(I2C.Starts == 2);   /* Signals during transfer give one more transfer */
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(I2C.Starts == 2 && Readies == 2);
+    GUI_TEST_ASSERT(Last.X[0] == 30 && Last.Y[0] == 40);
+}
+
+static void TestTransferError(void) {
+    Reset();
+    SetTouch(1, 10, 20);
+    TOUCH_ASYNC_Signal(&TA);
+    I2C_Finish(0);                          /* Bus error, transfer is repeated */
+    GUI_TEST_ASSERT(I2C.Starts == 2 && TA.Errors == 1 && Readies == 0);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Readies == 1 && TA.Reads == 1 && TA.Retries == 0);
+    
+    I2C.Regs[TOUCH_ASYNC_REG] = 0x0F;       /* Invalid number of touches is repeated too */
+    TOUCH_ASYNC_Signal(&TA);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(I2C.Starts == 4 && TA.Errors == 2 && Readies == 1);
+    SetTouch(0, 0, 0);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Readies == 2 && Last.NumPresses == 0);
+}
+
+static void TestPersistentError(void) {
+    uint32_t i;
+    
+    Reset();
+    TOUCH_ASYNC_Signal(&TA);
+    for (i = 0; i < 10; i++) {              /* Controller never answers */
+        I2C_Finish(0);
+    }
+    GUI_TEST_ASSERT(I2C.Starts == 1 + TOUCH_ASYNC_RETRIES);
+    GUI_TEST_ASSERT(TA.Errors == 1 + TOUCH_ASYNC_RETRIES);
+    GUI_TEST_ASSERT(TA.State == TOUCH_ASYNC_State_Idle && !I2C.Active);
+    
+    SetTouch(1, 5, 6);                      /* Next signal starts again with all retries */
+    TOUCH_ASYNC_Signal(&TA);
+    I2C_Finish(0);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Readies == 1 && Last.X[0] == 5);
+}
+
+static void TestBusBusy(void) {
+    Reset();
+    SetTouch(1, 7, 8);
+    I2C.Busy = TOUCH_ASYNC_RETRIES;         /* Bus is free on last retry */
+    TOUCH_ASYNC_Signal(&TA);
+    GUI_TEST_ASSERT(I2C.Starts == 1 && TA.State == TOUCH_ASYNC_State_Reading);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Readies == 1 && TA.Retries == 0);
+    
+    I2C.Busy = 100;                         /* Bus stays busy */
+    TOUCH_ASYNC_Signal(&TA);
+    GUI_TEST_ASSERT(I2C.Starts == 1 && I2C.Busy == 100 - 1 - TOUCH_ASYNC_RETRIES);
+    GUI_TEST_ASSERT(TA.State == TOUCH_ASYNC_State_Idle);
+    
+    I2C.Busy = 0;                           /* Reader works again with next signal */
+    TOUCH_ASYNC_Signal(&TA);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Readies == 2);
+}
+
+static void TestOrientation(void) {
+    Reset();
+    TS.Orientation = 0;                     /* Rotated by 180 degrees */
+    SetTouch(1, 100, 50);
+    TOUCH_ASYNC_Signal(&TA);
+    I2C_Finish(1);
+    GUI_TEST_ASSERT(Last.X[0] == 480 - 100 && Last.Y[0] == 272 - 50);
+}
+
+int main(void) {
+    TestRead();
+    TestSignalDuringTransfer();
+    TestTransferError();
+    TestPersistentError();
+    TestBusBusy();
+    TestOrientation();
+    return GUI_TEST_Result();
+}
@@ -0,0 +1,189 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "gui_test.h"
+#include "gui_window.h"
+#include "gui_button.h"
+#include "gui_list.h"
+#include "gui_static.h"
+#include "gui_surface.h"
+
+/*
+ * Widgets are created and removed in trees.
+ * Removing a widget must release every widget below it, including their resources.
+ * Leaked memory of removed children is reported when built with sanitizers.
+ */
+static GUI_HANDLE_t root;
+static uint32_t removed;
+
+/* Widget which counts calls of its remove hook */
+static void CounterRemove(void* ptr) {
+    removed++;
+}
+
+static const GUI_WIDGET_t Counter = {
+    {
+        "Counter",                                  /*!< Widget name */
+        sizeof(GUI_HANDLE),                         /*!< Size of widget for memory allocation */
+        0,                                          /*!< Allow children objects on widget */
+    },
+    0,                                              /*!< Widget draw function */
+    {
+        0,                                          /*!< Touch down callback function */
+        0,                                          /*!< Touch up callback function */
+        0                                           /*!< Touch move callback function */
+    },
+    CounterRemove                                   /*!< Widget remove function */
+};
+
+static uint32_t GetCount(GUI_HANDLE_t h) {
+    return 1000;
+}
+
+static const GUI_LIST_PROVIDER_t provider = {GetCount, NULL, NULL};
+
+static const GUI_STATIC_ITEM_t items[] = {
+    {GUI_STATIC_TYPE_LED, 0, 1, 0, 0, 20, 20, 0, 0, 0, NULL, NULL, NULL, NULL},
+    {GUI_STATIC_TYPE_PROGBAR, 0, 2, 30, 0, 100, 20, 0, 0, 100, NULL, NULL, NULL, NULL},
+};
+
+/* Number of widgets in store */
+static uint32_t Widgets(void) {
+    uint32_t i, n = 0;
+    
+    for (i = 0; i < GUI_Store.Used; i++) {
+        n += GUI_Store.Handle[i] != NULL;
+    }
+    return n;
+}
+
+static void TestRemoveTree(void) {
+    GUI_HANDLE_t win, inner;
+    uint32_t count = Widgets();
+    
+    removed = 0;
+    GUI.WindowActive = root;
+    win = GUI_WINDOW_CreateChild(1, 10, 10, 300, 200);
+    __GUI_WIDGET_Create(&Counter, 2, 0, 0, 20, 20);
+    GUI_BUTTON_Create(3, 20, 0, 50, 20);
+    inner = GUI_WINDOW_CreateChild(4, 0, 30, 200, 150);
+    __GUI_WIDGET_Create(&Counter, 5, 0, 0, 20, 20);
+    GUI_LIST_Create(6, 0, 20, 200, 100, 20, &provider);
+    GUI_STATIC_Create(7, 0, 120, 200, 20, items, 2);
+    GUI_TEST_Frame(10);
+    GUI_TEST_ASSERT(GUI.WindowActive == inner && Widgets() > count + 7);
+    
+    __GUI_WIDGET_Remove(&win);              /* Children and their children are removed too */
+    GUI_TEST_ASSERT(removed == 2);
+    GUI_TEST_ASSERT(Widgets() == count);
+    GUI_TEST_ASSERT(GUI.WindowActive == root);  /* Active window was inside removed tree */
+    GUI_TEST_Frame(10);
+}
+
+/* Widgets get memory which was used before, flags must not be taken from old content */
+static void TestGarbageMemory(void) {
+    static uint8_t block[4096];
+    GUI_HANDLE_t h[32];
+    void* junk[32];
+    uint32_t count = Widgets(), i, wrong = 0;
+    
+    for (i = 0; i < 32; i++) {              /* Leave garbage in heap blocks of widget sizes */
+        junk[i] = malloc(64 + i * 16);
+        memset(junk[i], 0xFF, 64 + i * 16);
+    }
+    for (i = 0; i < 32; i++) {
+        free(junk[i]);
+    }
+    
+    GUI.WindowActive = root;
+    for (i = 0; i < 32; i++) {
+        h[i] = i & 1 ? GUI_BUTTON_Create(i, i * 10, 0, 50, 20) : GUI_WINDOW_CreateChild(i, i * 10, 30, 50, 20);
+        GUI.WindowActive = root;
+        wrong += h[i] == NULL || (h[i]->Flags & (GUI_FLAG_EXTERNALMEM | GUI_FLAG_CACHE | GUI_FLAG_DYNAMICTEXTALLOC)) != 0;
+        wrong += (i & 1) && (h[i]->Flags & GUI_FLAG_OPAQUE);    /* Only windows are opaque */
+    }
+    GUI_TEST_Frame(10);
+    for (i = 0; i < 32; i++) {
+        __GUI_WIDGET_Remove(&h[i]);
+        wrong += h[i] != NULL;              /* Memory is freed */
+    }
+    GUI_TEST_ASSERT(wrong == 0);
+    GUI_TEST_ASSERT(Widgets() == count);
+    
+    /* Widgets in memory block set by user */
+    memset(block, 0xFF, sizeof(block));
+    __GUI_WIDGET_SetMemory(block, sizeof(block));
+    h[0] = GUI_WINDOW_CreateChild(1, 0, 0, 100, 100);
+    h[1] = GUI_BUTTON_Create(2, 0, 0, 50, 20);
+    __GUI_WIDGET_SetMemory(NULL, 0);
+    GUI_TEST_ASSERT(h[0] && (h[0]->Flags & GUI_FLAG_EXTERNALMEM) && !(h[0]->Flags & GUI_FLAG_CACHE));
+    GUI_TEST_ASSERT(h[1] && h[1]->Parent == h[0] && !(h[1]->Flags & (GUI_FLAG_CACHE | GUI_FLAG_OPAQUE)));
+    GUI_TEST_Frame(10);
+    __GUI_WIDGET_Remove(&h[0]);
+    GUI_TEST_ASSERT(h[0] == NULL && Widgets() == count && GUI.WindowActive == root);
+    GUI_TEST_Frame(10);
+}
+
+/* Surfaces of cached children are given back when their parent is removed */
+static void TestRemoveCached(void) {
+    GUI_HANDLE_t win, h[GUI_SURFACE_MAX_COUNT];
+    GUI_SURFACE_t* sf;
+    uint32_t i, cached = 0;
+    
+    GUI.WindowActive = root;
+    win = GUI_WINDOW_CreateChild(1, 0, 0, GUI_TEST_WIDTH, GUI_TEST_HEIGHT);
+    for (i = 0; i < GUI_SURFACE_MAX_COUNT; i++) {   /* Use all surfaces */
+        GUI.WindowActive = win;
+        GUI_SURFACE_EnableCache(GUI_WINDOW_CreateChild(i, i * 20, 0, 200, 200));
+    }
+    GUI_TEST_Frame(10);
+    __GUI_WIDGET_Remove(&win);
+    GUI_TEST_Frame(10);
+    
+    for (i = 0; i < GUI_SURFACE_MAX_COUNT; i++) {   /* Every surface is free again */
+        GUI.WindowActive = root;
+        h[i] = GUI_SURFACE_EnableCache(GUI_WINDOW_CreateChild(i, i * 20, 0, 200, 200));
+        cached += (h[i]->Flags & GUI_FLAG_CACHE) != 0;
+    }
+    GUI_TEST_ASSERT(cached == GUI_SURFACE_MAX_COUNT);
+    GUI_TEST_Frame(10);
+    for (i = 0, cached = 0; i < GUI_SURFACE_MAX_COUNT; i++) {
+        sf = __GUI_SURFACE_Get(h[i]);       /* Arena has memory for all of them */
+        cached += sf && sf->Owner == h[i] && sf->Address;
+        __GUI_WIDGET_Remove(&h[i]);
+    }
+    GUI_TEST_ASSERT(cached == GUI_SURFACE_MAX_COUNT);
+    GUI_TEST_Frame(10);
+}
+
+int main(void) {
+    GUI_TEST_Init();
+    root = GUI.WindowActive;
+    
+    TestRemoveTree();
+    TestGarbageMemory();
+    TestRemoveCached();
+    return GUI_TEST_Result();
+}